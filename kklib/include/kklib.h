@@ -41,6 +41,13 @@
 #include <string.h>           // strlen, memcpy, ...
 #include <math.h>             // isnan, isfinite, ...
 #include <stdio.h>            // FILE*, printf, ...
+#if defined(_WIN32)
+#include <malloc.h>           // _msize
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>    // malloc_size
+#elif defined(__GLIBC__)
+#include <malloc.h>           // malloc_usable_size
+#endif
 
 #include "kklib/platform.h"   // Platform abstractions and portability definitions
 #include "kklib/atomic.h"     // Atomic operations
@@ -64,7 +71,12 @@ typedef enum kk_tag_e {
   KK_TAG_BIGINT,      // big integer (see `integer.c`)
   KK_TAG_BYTES_SMALL, // small byte sequence of at most 7 bytes.
   KK_TAG_BYTES,       // byte sequence
+  KK_TAG_BYTES_VIEW,  // zero-copy sub-range of a bytes block: {parent, buf, length} (see `bytes.c`)
   KK_TAG_VECTOR,      // a vector of (boxed) values
+  KK_TAG_VECTOR_INT64,   // a vector of unboxed int64_t values   (see `vector.c`)
+  KK_TAG_VECTOR_FLOAT64, // a vector of unboxed IEEE doubles (64-bit)
+  KK_TAG_VECTOR_VIEW,    // zero-copy sub-range of a vector: {parent, offset, length} (see `vector.c`)
+  KK_TAG_PVEC,        // persistent vector: {root, tail} + size and radix shift (see `vector.c`)
   KK_TAG_INT64,       // boxed int64_t               (only on <=64-bit platforms)
   KK_TAG_DOUBLE,      // boxed IEEE double (64-bit)  (only on <=64-bit platforms)
   KK_TAG_INT32,       // boxed int32_t               (only on <=32-bit platforms)
@@ -116,7 +128,7 @@ static inline bool kk_refcount_is_unique_or_thread_shared(kk_refcount_t rc) {
 // If the scan_fsize == 0xFF, the full scan count is in the first field as a boxed int (which includes the scan field itself).
 typedef struct kk_header_s {
   uint8_t   scan_fsize;  // number of fields that should be scanned when releasing (`scan_fsize <= 0xFF`, if 0xFF, the full scan size is the first field)
-  uint8_t   _field_idx;  // private: only used during stack-less freeing and marking (see `refcount.c`)
+  uint8_t   _field_idx;  // private: reserved (used by earlier stack-less freeing and marking, see `refcount.c`)
   uint16_t  tag;         // constructor tag
   _Atomic(kk_refcount_t) refcount; // reference count  (last to reduce code size constants in kk_header_init)
 } kk_header_t;
@@ -333,6 +345,12 @@ typedef kk_datatype_t kk_vector_t;
 // Strong random number context (using chacha20)
 struct kk_random_ctx_s;
 
+// Deterministic splittable pseudo random state (using pcg, see `kklib/random.h`)
+typedef struct kk_prandom_s {
+  uint64_t state;
+  uint64_t stream; // must be odd
+} kk_prandom_t;
+
 
 // High precision duration as `seconds + (attoseconds * 1e-18)`. 
 // (attosecond precision with a range of about 300 billion years)
@@ -353,6 +371,9 @@ typedef struct kk_box_any_s {
 // Workers run in a task_group
 typedef struct kk_task_group_s kk_task_group_t;
 
+// Worklist segment of blocks pending reclamation (see `refcount.c`)
+struct kk_drop_segment_s;
+
 //A yield context allows up to 8 continuations to be stored in-place
 #define KK_YIELD_CONT_MAX (8)
 
@@ -374,7 +395,81 @@ typedef struct kk_yield_s {
 
 extern kk_ptr_t kk_evv_empty_singleton;
 
-     
+// A small direct-mapped cache to speed up evidence vector lookups for effect
+// operations (see `kk_evv_index` in `std/core/hnd`). Entries are keyed on the
+// evidence vector- and tag name pointers which are only ever compared --
+// never dereferenced -- so stale entries are harmless.
+#define KK_EVV_CACHE_SIZE (8)    // must be a power of 2
+
+typedef struct kk_evv_cache_s {
+  uintptr_t     evv;             // the evidence vector the entry was resolved under
+  uintptr_t     tag;             // the tag name (string) of the evidence
+  kk_ssize_t    index;           // index of the evidence in the vector
+} kk_evv_cache_t;
+
+
+// Biased reference counts: a per-context bank of references to thread-shared
+// blocks. A dup of a shared block banks a whole batch of references with one
+// atomic operation and hands them out non-atomically from then on; drops
+// return references to the bank. This keeps read-mostly shared structures off
+// the contended cache line (see `kk_block_check_dup` in `refcount.c`).
+#define KK_RC_BIAS_SIZE  (16)   // must be a power of 2
+
+typedef struct kk_rc_bias_s {
+  kk_ptr_t      block;      // thread-shared block we hold banked references for
+  kk_refcount_t credits;    // banked references (already included in the shared count)
+} kk_rc_bias_t;
+
+// A small per-context cache of dropped blocks, bucketed by size class. Perceus
+// reuse tokens whose constructor needs a different size end up here (see
+// `kk_reuse_drop`) so a later allocation of a near-miss size can still avoid a
+// malloc/free pair. Class `i` holds blocks whose usable size is at least `8*(i+1)` bytes.
+#define KK_REUSE_CACHE_CLASSES  (16)   // cache blocks up to 128 bytes
+#define KK_REUSE_CACHE_MAX      (8)    // retain at most 8 blocks per class
+
+typedef struct kk_reuse_class_s {
+  kk_ptr_t    blocks;   // linked through the first word of each cached block
+  int32_t     count;
+} kk_reuse_class_t;
+
+// Bump-allocation arena: during an arena phase (see `kk_arena_begin`) small
+// block allocations are served from a per-context bump pointer and the whole
+// phase is released at once in `kk_arena_end`. Structures that are built,
+// consumed, and dropped together (parse trees for example) then cost one
+// pointer bump per node and one sweep to free: a final drop of an arena block
+// still releases its (non-arena) children but leaves the memory in place.
+// Arena blocks must not outlive the phase nor be marked thread-shared.
+#define KK_ARENA_CHUNK_SIZE   (256*1024)               // bytes per chunk
+#define KK_ARENA_MAX_ALLOC    (KK_ARENA_CHUNK_SIZE/8)  // larger blocks are served from the heap
+
+typedef struct kk_arena_chunk_s {
+  struct kk_arena_chunk_s* next;  // older chunks of this phase
+  uint8_t*  end;                  // one past the last usable byte
+  // block allocations follow
+} kk_arena_chunk_t;
+
+typedef struct kk_arena_s {
+  uint8_t*  top;               // bump pointer into the current chunk; NULL when no arena is active
+  uint8_t*  end;               // end of the current chunk
+  kk_arena_chunk_t* chunks;    // all chunks of the active phase (current chunk first)
+} kk_arena_t;
+
+// Runtime statistics. The counters are plain fields on the thread-local
+// context and are only incremented when compiled with `-DKK_STATS` (see
+// `kk_stat_add`); without it every probe compiles away and the counters stay zero.
+typedef struct kk_stats_s {
+  int64_t block_allocs;       // blocks allocated through `kk_block_alloc` (and variants)
+  int64_t block_alloc_bytes;  // total bytes requested for those blocks
+  int64_t dups;               // thread-local (non-atomic) reference dups
+  int64_t drops;              // thread-local (non-atomic) reference drops
+  int64_t dups_atomic;        // dups of thread-shared blocks (atomic)
+  int64_t drops_atomic;       // drops of thread-shared blocks (atomic)
+  int64_t evv_inserts;        // evidence vector insertions (handler installs)
+  int64_t task_enqueues;      // tasks pushed to the task group
+  int64_t huge_allocs;        // allocations of at least `KK_HUGE_PAGE_THRESHOLD` bytes (advised as huge page candidates)
+  int64_t huge_alloc_bytes;   // total bytes requested for those allocations
+} kk_stats_t;
+
 // The thread local context.
 // The fields `yielding`, `heap` and `evv` should come first for efficiency
 typedef struct kk_context_s {
@@ -382,8 +477,12 @@ typedef struct kk_context_s {
   kk_heap_t      heap;             // the (thread-local) heap to allocate in; todo: put in a register?
   kk_ptr_t       evv;              // the current evidence vector for effect handling: vector for size 0 and N>1, direct evidence for one element vector
   kk_yield_t     yield;            // inlined yield structure (for efficiency)
+  kk_evv_cache_t evv_cache[KK_EVV_CACHE_SIZE];  // lookup cache for effect handler dispatch
   int32_t        marker_unique;    // unique marker generation
-  kk_block_t*    delayed_free;     // list of blocks that still need to be freed
+  struct kk_drop_segment_s* delayed_free;  // queue of blocks that still need to be freed (see `kk_deferred_reclaim`)
+  int8_t         deferred_reclaim; // when set, drop cascades are queued on `delayed_free` instead of freed eagerly
+  int8_t         heap_escaped;     // when set, this context created- or referenced thread-shared blocks and its
+                                   // heap cannot be torn down in one sweep in `kk_free_context` (with mimalloc)
   kk_integer_t   unique;           // thread local unique number generation
   size_t         thread_id;        // unique thread id
   kk_box_any_t   kk_box_any;       // used when yielding as a value of any type
@@ -392,16 +491,73 @@ typedef struct kk_context_s {
   kk_task_group_t* task_group;     // task group for managing threads. NULL for the main thread.
   
   struct kk_random_ctx_s* srandom_ctx; // strong random using chacha20, initialized on demand
+  kk_prandom_t   prandom;          // deterministic splittable prng; tasks get their own stream split off on schedule
   kk_ssize_t     argc;             // command line argument count 
   const char**   argv;             // command line arguments
   kk_timer_t     process_start;    // time at start of the process
   int64_t        timer_freq;       // high precision timer frequency
   kk_duration_t  timer_prev;       // last requested timer time
   kk_duration_t  timer_delta;      // applied timer delta (to ensure monotonicity)
+  int64_t        timer_coarse_ofs; // aligns the coarse clock to the `kk_timer_ticks` timeline; 0 if not yet initialized (see `time.c`)
+  uint64_t       tsc_base;         // rdtsc calibration state for `kk_timer_ticks_fast` (see `time.c`)
+  int64_t        tsc_time_base;    // monotonic nanoseconds at `tsc_base`
+  double         tsc_nsec_per_cycle; // 0.0 while not yet calibrated
   int64_t        time_freq;        // unix time frequency
   kk_duration_t  time_unix_prev;   // last requested unix time
+  kk_stats_t     stats;            // runtime statistics; only updated with `-DKK_STATS`
+  _Atomic(const char*) profile_fun;       // name of the currently executing koka function; only maintained with `-DKK_PROFILE` (see `kk_profile_enter`)
+  _Atomic(const char*) profile_yield_fun; // function that started the current yield; sampled instead of `profile_fun` while yielding (see `kk_profile_yield_begin`)
+  kk_reuse_class_t reuse_cache[KK_REUSE_CACHE_CLASSES];  // cache of dropped blocks for near-miss reuse
+  kk_arena_t     arena;            // bump-allocation arena; active between `kk_arena_begin`/`kk_arena_end`
+  kk_rc_bias_t   rc_bias[KK_RC_BIAS_SIZE];  // banked references to thread-shared blocks (see `refcount.c`)
+  struct kk_hazard_slot_s* hazard_slot;  // per-thread slot for contention-free thread-shared ref reads (see `ref.c`)
+  struct kk_context_s* pool_next;  // links parked contexts in the recycling pool (see `kk_free_context`)
 } kk_context_t;
 
+// Count an event in the runtime statistics. This is a no-op (with unevaluated
+// arguments) unless compiled with `-DKK_STATS`.
+#ifdef KK_STATS
+#define kk_stat_add(ctx,field,n)  ((ctx)->stats.field += (n))
+#else
+#define kk_stat_add(ctx,field,n)  ((void)0)
+#endif
+#define kk_stat_inc(ctx,field)    kk_stat_add(ctx,field,1)
+
+kk_decl_export void kk_stats_snapshot( kk_stats_t* stats, kk_context_t* ctx );
+kk_decl_export void kk_stats_print( kk_context_t* ctx );
+
+/*--------------------------------------------------------------------------------------
+  Sampling profiler hooks (the markers are only maintained with `-DKK_PROFILE`).
+  Generated code brackets every function body with `kk_profile_enter`/`kk_profile_leave`
+  which keep a per-context marker naming the currently executing koka function; the
+  `SIGPROF` sampler (see `init.c`) reads the marker with relaxed atomics which is
+  async-signal safe. While yielding to a handler the physical C stack is the effect
+  trampoline, so samples taken during a yield attribute to the function that started
+  the yield instead (`kk_profile_yield_begin` in `std/core/hnd-inline.c`).
+--------------------------------------------------------------------------------------*/
+
+kk_decl_export bool kk_profile_start(int64_t hz, kk_context_t* ctx);   // also clears previous samples
+kk_decl_export void kk_profile_stop(kk_context_t* ctx);
+kk_decl_export void kk_profile_print(kk_context_t* ctx);
+
+#ifdef KK_PROFILE
+// `name` must point to static storage (generated code passes string literals)
+#define kk_profile_enter(name,ctx) \
+  const char* _kk_profile_prev = kk_atomic_load_relaxed(&(ctx)->profile_fun); \
+  kk_atomic_store_relaxed(&(ctx)->profile_fun, name)
+#define kk_profile_leave(ctx) \
+  kk_atomic_store_relaxed(&(ctx)->profile_fun, _kk_profile_prev)
+#define kk_profile_yield_begin(ctx) \
+  kk_atomic_store_relaxed(&(ctx)->profile_yield_fun, kk_atomic_load_relaxed(&(ctx)->profile_fun))
+#define kk_profile_yield_end(ctx) \
+  kk_atomic_store_relaxed(&(ctx)->profile_yield_fun, NULL)
+#else
+#define kk_profile_enter(name,ctx)   ((void)0)
+#define kk_profile_leave(ctx)        ((void)0)
+#define kk_profile_yield_begin(ctx)  ((void)0)
+#define kk_profile_yield_end(ctx)    ((void)0)
+#endif
+
 // Get the current (thread local) runtime context (should always equal the `_ctx` parameter)
 kk_decl_export kk_context_t* kk_get_context(void);
 kk_decl_export void          kk_free_context(void);
@@ -437,14 +593,43 @@ static inline int32_t kk_marker_unique(kk_context_t* ctx) {
 }
 
 
+// Return all banked references to their thread-shared blocks (see `refcount.c`).
+kk_decl_export void kk_rc_bias_flush( kk_context_t* ctx );
+
 kk_decl_export void kk_block_mark_shared( kk_block_t* b, kk_context_t* ctx );
 kk_decl_export void kk_box_mark_shared( kk_box_t b, kk_context_t* ctx );
 kk_decl_export void kk_box_mark_shared_recx(kk_box_t b, kk_context_t* ctx);
+kk_decl_export kk_ssize_t kk_block_mark_shared_collect( kk_block_t* b, kk_ssize_t depth, kk_block_t** roots, kk_ssize_t max, kk_context_t* ctx );
+
+// Deferred reclamation: when enabled, drop cascades are queued on the context
+// instead of freed eagerly, and are reclaimed incrementally through
+// `kk_deferred_reclaim` calls (bounding pause times on the calling thread).
+kk_decl_export void kk_deferred_reclaim_enable( bool enable, kk_context_t* ctx );
+kk_decl_export bool kk_deferred_reclaim( kk_ssize_t budget, kk_context_t* ctx );  // returns `true` if work remains; `budget < 0` reclaims everything
+
+// Bump-allocation arena phases (see `kk_arena_t`); implemented in `box.c`.
+kk_decl_export void        kk_arena_begin( kk_context_t* ctx );
+kk_decl_export void        kk_arena_end( kk_context_t* ctx );
+kk_decl_export kk_block_t* kk_arena_alloc( kk_ssize_t size, kk_context_t* ctx );    // NULL for oversized requests
+kk_decl_export kk_block_t* kk_arena_realloc( kk_block_t* b, kk_ssize_t size, kk_context_t* ctx );
 
 /*--------------------------------------------------------------------------------------
   Allocation
 --------------------------------------------------------------------------------------*/
 
+// Allocations of at least `KK_HUGE_PAGE_THRESHOLD` bytes (large vectors, strings,
+// byte buffers) are advised to the OS as huge page candidates: on Linux the
+// page-aligned interior of the allocation is `madvise(MADV_HUGEPAGE)`-ed so
+// transparent huge pages can back it with 2MiB pages, which greatly reduces dTLB
+// misses when pointer chasing through multi-gigabyte heaps. On Windows large pages
+// cannot be retrofitted onto an existing allocation (`MEM_LARGE_PAGES` only works
+// at `VirtualAlloc` time with `SeLockMemoryPrivilege`) so the advice only counts
+// statistics there; with mimalloc, set `MIMALLOC_LARGE_OS_PAGES=1` instead.
+// See `kk_huge_page_advise` in `os.c`.
+#define KK_HUGE_PAGE_THRESHOLD   ((kk_ssize_t)(2*1024*1024))    // the x86-64/aarch64 huge page size
+
+kk_decl_export void kk_huge_page_advise(void* p, kk_ssize_t sz, kk_context_t* ctx);
+
 #ifdef KK_MIMALLOC
 #ifdef KK_MIMALLOC_INLINE
   static inline void* kk_malloc_small(kk_ssize_t sz, kk_context_t* ctx) {
@@ -457,17 +642,21 @@ kk_decl_export void kk_box_mark_shared_recx(kk_box_t b, kk_context_t* ctx);
 #endif
 
 static inline void* kk_malloc(kk_ssize_t sz, kk_context_t* ctx) {
-  return mi_heap_malloc(ctx->heap, (size_t)sz);
+  void* p = mi_heap_malloc(ctx->heap, (size_t)sz);
+  if (kk_unlikely(sz >= KK_HUGE_PAGE_THRESHOLD)) { kk_huge_page_advise(p, sz, ctx); }
+  return p;
 }
 
 static inline void* kk_zalloc(kk_ssize_t sz, kk_context_t* ctx) {
-  kk_unused(ctx);
-  return mi_heap_zalloc(ctx->heap, (size_t)sz);
+  void* p = mi_heap_zalloc(ctx->heap, (size_t)sz);
+  if (kk_unlikely(sz >= KK_HUGE_PAGE_THRESHOLD)) { kk_huge_page_advise(p, sz, ctx); }
+  return p;
 }
 
 static inline void* kk_realloc(void* p, kk_ssize_t sz, kk_context_t* ctx) {
-  kk_unused(ctx);
-  return mi_heap_realloc(ctx->heap, p, (size_t)sz);
+  void* q = mi_heap_realloc(ctx->heap, p, (size_t)sz);
+  if (kk_unlikely(sz >= KK_HUGE_PAGE_THRESHOLD)) { kk_huge_page_advise(q, sz, ctx); }
+  return q;
 }
 
 static inline void kk_free(const void* p, kk_context_t* ctx) {
@@ -481,8 +670,9 @@ static inline void kk_free_local(const void* p, kk_context_t* ctx) {
 }
 #else
 static inline void* kk_malloc(kk_ssize_t sz, kk_context_t* ctx) {
-  kk_unused(ctx);
-  return malloc((size_t)sz);
+  void* p = malloc((size_t)sz);
+  if (kk_unlikely(sz >= KK_HUGE_PAGE_THRESHOLD)) { kk_huge_page_advise(p, sz, ctx); }
+  return p;
 }
 
 static inline void* kk_malloc_small(kk_ssize_t sz, kk_context_t* ctx) {
@@ -490,13 +680,15 @@ static inline void* kk_malloc_small(kk_ssize_t sz, kk_context_t* ctx) {
 }
 
 static inline void* kk_zalloc(kk_ssize_t sz, kk_context_t* ctx) {
-  kk_unused(ctx);
-  return calloc(1, (size_t)sz);
+  void* p = calloc(1, (size_t)sz);
+  if (kk_unlikely(sz >= KK_HUGE_PAGE_THRESHOLD)) { kk_huge_page_advise(p, sz, ctx); }
+  return p;
 }
 
 static inline void* kk_realloc(void* p, kk_ssize_t sz, kk_context_t* ctx) {
-  kk_unused(ctx);
-  return realloc(p, (size_t)sz);
+  void* q = realloc(p, (size_t)sz);
+  if (kk_unlikely(sz >= KK_HUGE_PAGE_THRESHOLD)) { kk_huge_page_advise(q, sz, ctx); }
+  return q;
 }
 
 static inline void kk_free(const void* p, kk_context_t* ctx) {
@@ -526,47 +718,201 @@ static inline void kk_block_large_init(kk_block_large_t* b, kk_ssize_t size, kk_
   b->large_scan_fsize = kk_intf_box(scan_fsize);  
 }
 
+// The usable size of a `kk_malloc` allocation; used to place dropped blocks
+// in a reuse size class. Returns 0 if the platform cannot tell (which just
+// disables the reuse cache).
+static inline kk_ssize_t kk_malloc_usable_size(void* p) {
+#if defined(KK_MIMALLOC)
+  return (kk_ssize_t)mi_usable_size(p);
+#elif defined(_WIN32)
+  return (kk_ssize_t)_msize(p);
+#elif defined(__APPLE__)
+  return (kk_ssize_t)malloc_size(p);
+#elif defined(__GLIBC__)
+  return (kk_ssize_t)malloc_usable_size(p);
+#else
+  kk_unused(p);
+  return 0;
+#endif
+}
+
 typedef kk_block_t* kk_reuse_t;
 
 #define kk_reuse_null  ((kk_reuse_t)NULL)
 
+// Cache a dropped (unique) block for later reuse; frees it if it does not fit a class.
+static inline void kk_reuse_cache_push(kk_block_t* b, kk_context_t* ctx) {
+  const kk_ssize_t cls = (kk_malloc_usable_size(b) / 8) - 1;
+  if (cls < 0 || cls >= KK_REUSE_CACHE_CLASSES || ctx->reuse_cache[cls].count >= KK_REUSE_CACHE_MAX) {
+    kk_free(b, ctx);
+    return;
+  }
+  kk_reuse_class_t* rc = &ctx->reuse_cache[cls];
+  *((kk_ptr_t*)b) = rc->blocks;
+  rc->blocks = b;
+  rc->count++;
+}
+
+// Pop a cached block that can hold `size` bytes; returns NULL if none fits.
+static inline kk_block_t* kk_reuse_cache_pop(kk_ssize_t size, kk_context_t* ctx) {
+  kk_ssize_t cls = (size - 1) / 8;    // smallest class whose blocks can hold `size`
+  if (cls >= KK_REUSE_CACHE_CLASSES) return NULL;
+  const kk_ssize_t top = (cls + 2 < KK_REUSE_CACHE_CLASSES ? cls + 2 : KK_REUSE_CACHE_CLASSES - 1);
+  do {
+    kk_reuse_class_t* rc = &ctx->reuse_cache[cls];
+    kk_block_t* b = rc->blocks;
+    if (b != NULL) {
+      rc->blocks = *((kk_ptr_t*)b);
+      rc->count--;
+      return b;
+    }
+  } while (++cls <= top);
+  return NULL;
+}
+
+// Free all cached blocks (called when a context is freed).
+static inline void kk_reuse_cache_clear(kk_context_t* ctx) {
+  for (kk_ssize_t cls = 0; cls < KK_REUSE_CACHE_CLASSES; cls++) {
+    kk_block_t* b = ctx->reuse_cache[cls].blocks;
+    while (b != NULL) {
+      kk_block_t* next = *((kk_ptr_t*)b);
+      kk_free(b, ctx);
+      b = next;
+    }
+    ctx->reuse_cache[cls].blocks = NULL;
+    ctx->reuse_cache[cls].count = 0;
+  }
+}
+
+// Is the block allocated in the active arena? (one load and branch when no arena is active)
+static inline bool kk_arena_resident(kk_block_t* b, kk_context_t* ctx) {
+  kk_arena_chunk_t* c = ctx->arena.chunks;
+  while (kk_unlikely(c != NULL)) {
+    if ((uint8_t*)b >= (uint8_t*)(c + 1) && (uint8_t*)b < c->end) return true;
+    c = c->next;
+  }
+  return false;
+}
+
+/*--------------------------------------------------------------------------------------
+  Heap census: live block- and byte counts per tag (only with `-DKK_HEAP_CENSUS`).
+  The counters are global atomics (not per-context like `kk_stats_t`) since a block
+  can be freed on another thread than where it was allocated; updates are relaxed
+  single adds on the alloc- and free paths. Arena blocks are not tracked: they are
+  reclaimed wholesale in `kk_arena_end` and have no usable malloc size.
+--------------------------------------------------------------------------------------*/
+
+#define KK_CENSUS_CTOR_TAGS  (64)   // constructor tags get their own bucket; the last one aggregates tags >= 63
+#define KK_CENSUS_BUCKETS    (KK_CENSUS_CTOR_TAGS + (KK_TAG_LAST - KK_TAG_OPEN))
+
+typedef struct kk_census_entry_s {
+  int64_t count;              // live blocks with this tag
+  int64_t bytes;              // usable heap bytes held by those blocks
+} kk_census_entry_t;
+
+kk_decl_export void kk_heap_census(kk_census_entry_t census[KK_CENSUS_BUCKETS], kk_context_t* ctx);
+kk_decl_export void kk_heap_census_print(kk_context_t* ctx);
+kk_decl_export void kk_heap_census_dump_every(int64_t millisecs, kk_context_t* ctx);  // 0 or negative stops the periodic dump
+
+#ifdef KK_HEAP_CENSUS
+kk_decl_export _Atomic(int64_t) kk_census_count[KK_CENSUS_BUCKETS];
+kk_decl_export _Atomic(int64_t) kk_census_bytes[KK_CENSUS_BUCKETS];
+
+static inline kk_ssize_t kk_census_bucket(kk_tag_t tag) {
+  if (tag >= KK_TAG_OPEN) { return KK_CENSUS_CTOR_TAGS + (kk_ssize_t)(tag - KK_TAG_OPEN); }
+  return (tag < KK_CENSUS_CTOR_TAGS ? (kk_ssize_t)tag : KK_CENSUS_CTOR_TAGS - 1);
+}
+
+static inline void kk_census_track(kk_block_t* b, int64_t dir, kk_context_t* ctx) {
+  if (kk_unlikely(kk_arena_resident(b,ctx))) return;
+  const kk_ssize_t bucket = kk_census_bucket(kk_block_tag(b));
+  kk_atomic_add_relaxed(&kk_census_count[bucket], dir);
+  kk_atomic_add_relaxed(&kk_census_bytes[bucket], dir * (int64_t)kk_malloc_usable_size(b));
+}
+#define kk_census_alloc(b,ctx)  kk_census_track(b, 1, ctx)
+#define kk_census_free(b,ctx)   kk_census_track(b, -1, ctx)
+#else
+#define kk_census_alloc(b,ctx)  ((void)0)
+#define kk_census_free(b,ctx)   ((void)0)
+#endif
+
+// Allocate fresh block memory: bumped off the arena during an arena phase
+// (oversized requests and inactive arenas are served from the heap).
+static inline kk_block_t* kk_block_alloc_fresh(kk_ssize_t size, kk_context_t* ctx) {
+  kk_stat_inc(ctx, block_allocs);
+  kk_stat_add(ctx, block_alloc_bytes, size);
+  if (kk_unlikely(ctx->arena.top != NULL)) {
+    const kk_ssize_t asize = (size + 7) & ~KK_IZ(7);  // keep the bump pointer box-aligned
+    uint8_t* p = ctx->arena.top;
+    if (kk_likely(asize <= (ctx->arena.end - p))) {
+      ctx->arena.top = p + asize;
+      return (kk_block_t*)p;
+    }
+    kk_block_t* b = kk_arena_alloc(size, ctx);  // start a new chunk
+    if (b != NULL) return b;
+  }
+  return (kk_block_t*)kk_malloc_small(size, ctx);
+}
+
 static inline kk_block_t* kk_block_alloc_at(kk_reuse_t at, kk_ssize_t size, kk_ssize_t scan_fsize, kk_tag_t tag, kk_context_t* ctx) {
   kk_assert_internal(scan_fsize >= 0 && scan_fsize < KK_SCAN_FSIZE_MAX);
   kk_block_t* b;
   if (at==kk_reuse_null) {
-    b = (kk_block_t*)kk_malloc_small(size, ctx);
+    b = kk_reuse_cache_pop(size, ctx);
+    if (b == NULL) {
+      b = kk_block_alloc_fresh(size, ctx);
+    }
   }
   else {
     kk_assert_internal(kk_block_is_unique(at)); // TODO: check usable size of `at`
     b = at;
   }
   kk_block_init(b, size, scan_fsize, tag);
+  kk_census_alloc(b, ctx);
   return b;
 }
 
 static inline kk_block_t* kk_block_alloc(kk_ssize_t size, kk_ssize_t scan_fsize, kk_tag_t tag, kk_context_t* ctx) {
   kk_assert_internal(scan_fsize >= 0 && scan_fsize < KK_SCAN_FSIZE_MAX);
-  kk_block_t* b = (kk_block_t*)kk_malloc_small(size, ctx);
+  kk_block_t* b = kk_reuse_cache_pop(size, ctx);
+  if (b == NULL) {
+    b = kk_block_alloc_fresh(size, ctx);
+  }
   kk_block_init(b, size, scan_fsize, tag);
+  kk_census_alloc(b, ctx);
   return b;
 }
 
 static inline kk_block_t* kk_block_alloc_any(kk_ssize_t size, kk_ssize_t scan_fsize, kk_tag_t tag, kk_context_t* ctx) {
   kk_assert_internal(scan_fsize >= 0 && scan_fsize < KK_SCAN_FSIZE_MAX);
   kk_block_t* b = (kk_block_t*)kk_malloc(size, ctx);
+  kk_stat_inc(ctx, block_allocs);
+  kk_stat_add(ctx, block_alloc_bytes, size);
   kk_block_init(b, size, scan_fsize, tag);
+  kk_census_alloc(b, ctx);
   return b;
 }
 
 static inline kk_block_large_t* kk_block_large_alloc(kk_ssize_t size, kk_ssize_t scan_fsize, kk_tag_t tag, kk_context_t* ctx) {
   kk_block_large_t* b = (kk_block_large_t*)kk_malloc(size, ctx);
+  kk_stat_inc(ctx, block_allocs);
+  kk_stat_add(ctx, block_alloc_bytes, size);
   kk_block_large_init(b, size, scan_fsize, tag);
+  kk_census_alloc(&b->_block, ctx);
   return b;
 }
 
 static inline kk_block_t* kk_block_realloc(kk_block_t* b, kk_ssize_t size, kk_context_t* ctx) {
   kk_assert_internal(kk_block_is_unique(b));
-  return (kk_block_t*)kk_realloc(b, size, ctx);
+  kk_census_free(b, ctx);
+  if (kk_unlikely(kk_arena_resident(b, ctx))) {
+    b = kk_arena_realloc(b, size, ctx);  // copies; the old memory stays until the phase ends
+  }
+  else {
+    b = (kk_block_t*)kk_realloc(b, size, ctx);
+  }
+  kk_census_alloc(b, ctx);  // also counts an arena block that was reallocated into the heap
+  return b;
 }
 
 static inline kk_block_t* kk_block_assertx(kk_block_t* b, kk_tag_t tag) {
@@ -576,10 +922,28 @@ static inline kk_block_t* kk_block_assertx(kk_block_t* b, kk_tag_t tag) {
 }
 
 static inline void kk_block_free(kk_block_t* b, kk_context_t* ctx) {
+  if (kk_unlikely(kk_arena_resident(b, ctx))) {
+    return;  // the memory is reclaimed wholesale in `kk_arena_end`
+  }
+  kk_census_free(b, ctx);  // cached reuse blocks count as dead until re-allocated
+  const kk_tag_t tag = kk_block_tag(b);
+  if (kk_unlikely(tag == KK_TAG_EVV_VECTOR || tag == KK_TAG_FUNCTION)) {
+    // effect-heavy code re-installs same-arity evidence vectors and re-allocates
+    // continuation frames (closures, kcompose/cont-apply in the yield path)
+    // constantly; keep the block so the next install or yield allocates nothing
+    kk_reuse_cache_push(b, ctx);
+    return;
+  }
   kk_block_set_invalid(b);
   kk_free(b, ctx);
 }
 
+// Allocate `n` same-sized blocks in one call, returned as reuse tokens: constructor-heavy
+// loops (list- and tree builders) feed one to each constructor allocation (the `at`
+// argument of `kk_block_alloc_at`) instead of paying a call, cache lookup, and branch
+// per cell; unused tokens are returned with `kk_reuse_drop` (see `box.c`).
+kk_decl_export void kk_block_alloc_n(kk_reuse_t* blocks, kk_ssize_t n, kk_ssize_t size, kk_context_t* ctx);
+
 #define kk_block_alloc_as(struct_tp,scan_fsize,tag,ctx)        ((struct_tp*)kk_block_alloc_at(kk_reuse_null, sizeof(struct_tp),scan_fsize,tag,ctx))
 #define kk_block_alloc_at_as(struct_tp,at,scan_fsize,tag,ctx)  ((struct_tp*)kk_block_alloc_at(at, sizeof(struct_tp),scan_fsize,tag,ctx))
 
@@ -612,6 +976,7 @@ static inline kk_block_t* kk_block_dup(kk_block_t* b) {
     return kk_block_check_dup(b, rc);                   // thread-shared or sticky (overflow) ?
   }
   else {
+    kk_stat_inc(kk_get_context(), dups);
     kk_block_refcount_set(b, rc+1);
     return b;
   }
@@ -625,6 +990,7 @@ static inline void kk_block_drop(kk_block_t* b, kk_context_t* ctx) {
     kk_block_check_drop(b, rc, ctx);    // thread-shared, sticky (overflowed), or can be freed?
   }
   else {
+    kk_stat_inc(ctx, drops);
     kk_block_refcount_set(b, rc-1);
   }
 }
@@ -688,6 +1054,7 @@ static inline kk_reuse_t kk_block_dropi_reuse(kk_block_t* b, kk_context_t* ctx)
     for (kk_ssize_t i = 0; i < scan_fsize; i++) {
       kk_box_drop(kk_block_field(b, i), ctx);
     }
+    kk_census_free(b, ctx);  // a reuse token counts as dead until re-allocated
     return b;
   }
   else {
@@ -726,6 +1093,7 @@ static inline kk_reuse_t kk_block_dropn_reuse(kk_block_t* b, kk_ssize_t scan_fsi
     for (kk_ssize_t i = 0; i < scan_fsize; i++) {
       kk_box_drop(kk_block_field(b, i), ctx);
     }
+    kk_census_free(b, ctx);  // a reuse token counts as dead until re-allocated
     return b;
   }
   else if (kk_unlikely(kk_refcount_is_thread_shared(rc))) {  // (signed)rc < 0
@@ -754,7 +1122,7 @@ static inline kk_block_t* kk_block_dup_assert(kk_block_t* b, kk_tag_t tag) {
 static inline void kk_reuse_drop(kk_reuse_t r, kk_context_t* ctx) {
   if (r != NULL) {
     kk_assert_internal(kk_block_is_unique(r));
-    kk_free(r,ctx);
+    kk_reuse_cache_push(r,ctx);
   }
 }
 
@@ -947,6 +1315,23 @@ static inline void kk_datatype_decref(kk_datatype_t d, kk_context_t* ctx) {
   static kk_struct_tp _static_##name = { { KK_HEADER_STATIC(0,KK_TAG_OPEN) }, &kk__static_string_empty._base }; \
   decl kk_struct_tp* name = &_static_##name
 
+/* Static constant constructor blocks.
+   A constructor whose arguments are known at compile time can live in the data
+   segment instead of being allocated at module init (the C backend emits these
+   for top-level constant constructor applications). The contract is:
+   - the block starts with a regular `kk_block_t` header initialized through
+     `KK_HEADER_STATIC`: the stuck refcount means dup and drop never write to
+     the block and it is never freed (see `kk_block_check_dup` in `refcount.c`),
+     so the pages stay clean and shared across forked workers;
+   - natural struct alignment suffices (blocks need at least pointer alignment);
+   - every field initializer is a link-time constant: a value encoding (small
+     integer, char, enum, or singleton tag) or the address of another static block;
+   - open datatypes are excluded (their tag string is assigned at module init),
+     as are blocks holding functions, references, or external pointers. */
+#define kk_static_con_base(scan_fsize,tag)   { { KK_HEADER_STATIC(scan_fsize,tag) } }  // initializes the `_base` of a constructor struct
+#define kk_datatype_static(name)             { (uintptr_t)&(name)._base._block }       // reference another static constructor block
+#define kk_datatype_static_singleton(tag)    { (((kk_uintf_t)(tag))<<2 | 1) }          // as `kk_datatype_from_tag`
+
 
 /*----------------------------------------------------------------------
   Reference counting of pattern matches
@@ -1156,6 +1541,17 @@ typedef struct kk_vector_large_s {  // always use a large block for a vector so
   kk_box_t                vec[1];               // vec[(large_)scan_fsize - 1]
 } *kk_vector_large_t;
 
+// Zero-copy view on a sub-range of a vector (see `kk_vector_view` in `vector.c`).
+// The parent is a scanned field so the generic drop path releases it when the
+// last view drops; the shared element storage must be treated as read-only
+// through a view (in-place updates may only go through a unique parent).
+typedef struct kk_vector_view_s {
+  kk_block_t _block;          // scan_fsize == 1 (just the parent field)
+  kk_box_t   parent;          // the boxed parent vector (never itself a view)
+  kk_ssize_t offset;
+  kk_ssize_t length;
+} *kk_vector_view_t;
+
 
 static inline kk_decl_const kk_vector_t kk_vector_empty(void) {
   return kk_datatype_from_tag((kk_tag_t)1);
@@ -1196,6 +1592,7 @@ static inline kk_vector_t kk_vector_alloc_uninit(kk_ssize_t length, kk_box_t** b
 kk_decl_export void        kk_vector_init_borrow(kk_vector_t _v, kk_ssize_t start, kk_box_t def, kk_context_t* ctx);
 kk_decl_export kk_vector_t kk_vector_realloc(kk_vector_t vec, kk_ssize_t newlen, kk_box_t def, kk_context_t* ctx);
 kk_decl_export kk_vector_t kk_vector_copy(kk_vector_t vec, kk_context_t* ctx);
+kk_decl_export kk_vector_t kk_vector_view(kk_vector_t vec, kk_ssize_t offset, kk_ssize_t length, kk_context_t* ctx);  // O(1) sub-range sharing the parent storage
 
 static inline kk_vector_t kk_vector_alloc(kk_ssize_t length, kk_box_t def, kk_context_t* ctx) {
   kk_vector_t v = kk_vector_alloc_uninit(length, NULL, ctx);
@@ -1204,6 +1601,11 @@ static inline kk_vector_t kk_vector_alloc(kk_ssize_t length, kk_box_t def, kk_co
 }
 
 static inline kk_box_t* kk_vector_buf_borrow(kk_vector_t vd, kk_ssize_t* len) {
+  if (kk_datatype_has_ptr_tag(vd, KK_TAG_VECTOR_VIEW)) {
+    kk_vector_view_t vw = kk_datatype_as_assert(kk_vector_view_t, vd, KK_TAG_VECTOR_VIEW);
+    if (len != NULL) *len = vw->length;
+    return (kk_vector_buf_borrow(kk_datatype_unbox(vw->parent), NULL) + vw->offset);
+  }
   kk_vector_large_t v = kk_vector_as_large_borrow(vd);
   if (kk_unlikely(v==NULL)) {
     if (len != NULL) *len = 0;
@@ -1248,7 +1650,230 @@ static inline kk_decl_const kk_vector_t kk_vector_unbox(kk_box_t v, kk_context_t
 }
 
 
- 
+/*--------------------------------------------------------------------------------------
+  Persistent vectors
+  A 32-way radix-balanced tree where any number of versions share structure:
+  `at`/`set`/`push` are O(log32 n) without requiring uniqueness (see `vector.c`).
+  The nodes and leaves are ordinary boxed vectors so the generic Perceus drop-
+  and thread-share marking paths handle the tree without special cases.
+--------------------------------------------------------------------------------------*/
+
+typedef kk_datatype_t kk_pvec_t;
+
+typedef struct kk_pvec_s {
+  kk_block_t _block;   // scan_fsize == 2 (the root and tail fields)
+  kk_box_t   root;     // boxed tree of full 32-way nodes (an empty vector while all elements fit the tail)
+  kk_box_t   tail;     // boxed leaf with the last 1..32 elements (empty vector when size == 0)
+  kk_ssize_t size;     // total element count
+  kk_ssize_t shift;    // radix shift at the root; 0 when the root is a single leaf
+} *kk_pvec_base_t;
+
+kk_decl_export kk_pvec_t   kk_pvec_empty(kk_context_t* ctx);
+kk_decl_export kk_box_t    kk_pvec_at_borrow(kk_pvec_t p, kk_ssize_t i);
+kk_decl_export kk_pvec_t   kk_pvec_set(kk_pvec_t p, kk_ssize_t i, kk_box_t x, kk_context_t* ctx);
+kk_decl_export kk_pvec_t   kk_pvec_push(kk_pvec_t p, kk_box_t x, kk_context_t* ctx);
+kk_decl_export kk_pvec_t   kk_pvec_from_vector(kk_vector_t v, kk_context_t* ctx);
+kk_decl_export kk_vector_t kk_pvec_to_vector(kk_pvec_t p, kk_context_t* ctx);
+
+static inline kk_decl_pure kk_pvec_base_t kk_pvec_as_base_borrow(kk_pvec_t p) {
+  return kk_datatype_as_assert(kk_pvec_base_t, p, KK_TAG_PVEC);
+}
+
+static inline kk_decl_pure kk_ssize_t kk_pvec_len_borrow(kk_pvec_t p) {
+  return kk_pvec_as_base_borrow(p)->size;
+}
+
+static inline void kk_pvec_drop(kk_pvec_t p, kk_context_t* ctx) {
+  kk_datatype_drop(p, ctx);
+}
+
+static inline kk_pvec_t kk_pvec_dup(kk_pvec_t p) {
+  return kk_datatype_dup(p);
+}
+
+static inline kk_decl_const kk_box_t kk_pvec_box(kk_pvec_t p, kk_context_t* ctx) {
+  kk_unused(ctx);
+  return kk_datatype_box(p);
+}
+
+static inline kk_decl_const kk_pvec_t kk_pvec_unbox(kk_box_t b, kk_context_t* ctx) {
+  kk_unused(ctx);
+  return kk_datatype_unbox(b);
+}
+
+
+/*--------------------------------------------------------------------------------------
+  Unboxed vectors
+  Dense `int64_t` and `double` arrays without per-element boxing. The elements
+  are not heap values so the payload is never scanned (scan_fsize == 0) and the
+  length is kept in the block itself (like a bigint, see `integer.c`).
+--------------------------------------------------------------------------------------*/
+
+typedef kk_datatype_t kk_vector_int64_t;
+typedef kk_datatype_t kk_vector_float64_t;
+
+typedef struct kk_vector_int64_s {
+  kk_block_t  _block;
+  kk_ssize_t  length;
+  int64_t     vec[1];               // vec[length]
+} *kk_vector_int64_base_t;
+
+typedef struct kk_vector_float64_s {
+  kk_block_t  _block;
+  kk_ssize_t  length;
+  double      vec[1];               // vec[length]
+} *kk_vector_float64_base_t;
+
+
+static inline kk_decl_const kk_vector_int64_t kk_vector_int64_empty(void) {
+  return kk_datatype_from_tag((kk_tag_t)1);
+}
+
+static inline kk_decl_const kk_vector_float64_t kk_vector_float64_empty(void) {
+  return kk_datatype_from_tag((kk_tag_t)1);
+}
+
+static inline kk_decl_pure kk_vector_int64_base_t kk_vector_int64_as_base_borrow(kk_vector_int64_t v) {
+  if (kk_datatype_is_singleton(v)) {
+    return NULL;
+  }
+  else {
+    return kk_datatype_as_assert(kk_vector_int64_base_t, v, KK_TAG_VECTOR_INT64);
+  }
+}
+
+static inline kk_decl_pure kk_vector_float64_base_t kk_vector_float64_as_base_borrow(kk_vector_float64_t v) {
+  if (kk_datatype_is_singleton(v)) {
+    return NULL;
+  }
+  else {
+    return kk_datatype_as_assert(kk_vector_float64_base_t, v, KK_TAG_VECTOR_FLOAT64);
+  }
+}
+
+static inline void kk_vector_int64_drop(kk_vector_int64_t v, kk_context_t* ctx) {
+  kk_datatype_drop(v, ctx);
+}
+
+static inline void kk_vector_float64_drop(kk_vector_float64_t v, kk_context_t* ctx) {
+  kk_datatype_drop(v, ctx);
+}
+
+static inline kk_vector_int64_t kk_vector_int64_dup(kk_vector_int64_t v) {
+  return kk_datatype_dup(v);
+}
+
+static inline kk_vector_float64_t kk_vector_float64_dup(kk_vector_float64_t v) {
+  return kk_datatype_dup(v);
+}
+
+static inline kk_vector_int64_t kk_vector_int64_alloc_uninit(kk_ssize_t length, int64_t** buf, kk_context_t* ctx) {
+  if (kk_unlikely(length<=0)) {
+    if (buf != NULL) *buf = NULL;
+    return kk_vector_int64_empty();
+  }
+  else {
+    kk_vector_int64_base_t v = kk_block_as(kk_vector_int64_base_t, kk_block_alloc(
+        kk_ssizeof(struct kk_vector_int64_s) + (length-1)*kk_ssizeof(int64_t),  // length-1 as the vector_int64_s already includes one element
+        0 /* scan_fsize: the elements are unboxed */,
+        KK_TAG_VECTOR_INT64, ctx));
+    v->length = length;
+    if (buf != NULL) *buf = &v->vec[0];
+    return kk_datatype_from_base(v);
+  }
+}
+
+static inline kk_vector_float64_t kk_vector_float64_alloc_uninit(kk_ssize_t length, double** buf, kk_context_t* ctx) {
+  if (kk_unlikely(length<=0)) {
+    if (buf != NULL) *buf = NULL;
+    return kk_vector_float64_empty();
+  }
+  else {
+    kk_vector_float64_base_t v = kk_block_as(kk_vector_float64_base_t, kk_block_alloc(
+        kk_ssizeof(struct kk_vector_float64_s) + (length-1)*kk_ssizeof(double),
+        0 /* scan_fsize: the elements are unboxed */,
+        KK_TAG_VECTOR_FLOAT64, ctx));
+    v->length = length;
+    if (buf != NULL) *buf = &v->vec[0];
+    return kk_datatype_from_base(v);
+  }
+}
+
+kk_decl_export kk_vector_int64_t   kk_vector_int64_alloc(kk_ssize_t length, int64_t def, kk_context_t* ctx);
+kk_decl_export kk_vector_float64_t kk_vector_float64_alloc(kk_ssize_t length, double def, kk_context_t* ctx);
+kk_decl_export kk_vector_int64_t   kk_vector_int64_copy(kk_vector_int64_t vec, kk_context_t* ctx);
+kk_decl_export kk_vector_float64_t kk_vector_float64_copy(kk_vector_float64_t vec, kk_context_t* ctx);
+kk_decl_export kk_vector_int64_t   kk_vector_int64_set(kk_vector_int64_t vec, kk_ssize_t i, int64_t value, kk_context_t* ctx);
+kk_decl_export kk_vector_float64_t kk_vector_float64_set(kk_vector_float64_t vec, kk_ssize_t i, double value, kk_context_t* ctx);
+
+static inline int64_t* kk_vector_int64_buf_borrow(kk_vector_int64_t vd, kk_ssize_t* len) {
+  kk_vector_int64_base_t v = kk_vector_int64_as_base_borrow(vd);
+  if (kk_unlikely(v==NULL)) {
+    if (len != NULL) *len = 0;
+    return NULL;
+  }
+  else {
+    if (len != NULL) *len = v->length;
+    return &(v->vec[0]);
+  }
+}
+
+static inline double* kk_vector_float64_buf_borrow(kk_vector_float64_t vd, kk_ssize_t* len) {
+  kk_vector_float64_base_t v = kk_vector_float64_as_base_borrow(vd);
+  if (kk_unlikely(v==NULL)) {
+    if (len != NULL) *len = 0;
+    return NULL;
+  }
+  else {
+    if (len != NULL) *len = v->length;
+    return &(v->vec[0]);
+  }
+}
+
+static inline kk_decl_pure kk_ssize_t kk_vector_int64_len_borrow(const kk_vector_int64_t v) {
+  kk_ssize_t len;
+  kk_vector_int64_buf_borrow(v, &len);
+  return len;
+}
+
+static inline kk_decl_pure kk_ssize_t kk_vector_float64_len_borrow(const kk_vector_float64_t v) {
+  kk_ssize_t len;
+  kk_vector_float64_buf_borrow(v, &len);
+  return len;
+}
+
+static inline kk_decl_pure int64_t kk_vector_int64_at_borrow(const kk_vector_int64_t v, kk_ssize_t i) {
+  kk_assert(i < kk_vector_int64_len_borrow(v));
+  return kk_vector_int64_buf_borrow(v, NULL)[i];
+}
+
+static inline kk_decl_pure double kk_vector_float64_at_borrow(const kk_vector_float64_t v, kk_ssize_t i) {
+  kk_assert(i < kk_vector_float64_len_borrow(v));
+  return kk_vector_float64_buf_borrow(v, NULL)[i];
+}
+
+static inline kk_decl_const kk_box_t kk_vector_int64_box(kk_vector_int64_t v, kk_context_t* ctx) {
+  kk_unused(ctx);
+  return kk_datatype_box(v);
+}
+
+static inline kk_decl_const kk_box_t kk_vector_float64_box(kk_vector_float64_t v, kk_context_t* ctx) {
+  kk_unused(ctx);
+  return kk_datatype_box(v);
+}
+
+static inline kk_decl_const kk_vector_int64_t kk_vector_int64_unbox(kk_box_t v, kk_context_t* ctx) {
+  kk_unused(ctx);
+  return kk_datatype_unbox(v);
+}
+
+static inline kk_decl_const kk_vector_float64_t kk_vector_float64_unbox(kk_box_t v, kk_context_t* ctx) {
+  kk_unused(ctx);
+  return kk_datatype_unbox(v);
+}
+
+
+
 /*--------------------------------------------------------------------------------------
   References
 --------------------------------------------------------------------------------------*/
@@ -1261,6 +1886,10 @@ kk_decl_export kk_box_t  kk_ref_get_thread_shared(kk_ref_t r, kk_context_t* ctx)
 kk_decl_export kk_box_t  kk_ref_swap_thread_shared_borrow(kk_ref_t r, kk_box_t value);
 kk_decl_export kk_unit_t kk_ref_vector_assign_borrow(kk_ref_t r, kk_integer_t idx, kk_box_t value, kk_context_t* ctx);
 
+// Release the hazard slot of a context (if it acquired one for reading
+// thread-shared refs); called on context teardown (see `ref.c`).
+kk_decl_export void      kk_hazard_slot_release(kk_context_t* ctx);
+
 static inline kk_decl_const kk_box_t kk_ref_box(kk_ref_t r, kk_context_t* ctx) {
   kk_unused(ctx);
   return kk_basetype_box(r);
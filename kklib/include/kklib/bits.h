@@ -31,6 +31,39 @@
 #define kk_bitsx(name)  kk_bits_##name##64
 #endif
 
+/* -----------------------------------------------------------
+  Runtime cpu feature detection
+  `kk_cpu_features` is detected once during process initialization
+  (in `init.c`) so hot kernels can select a simd variant at startup
+  with zero per-call cost; for example:
+
+    static kk_ssize_t (*kernel)(const uint8_t*, kk_ssize_t);  // = NULL
+    ...
+    kk_cpu_dispatch(kernel, KK_CPU_X64_AVX2, &kernel_avx2, &kernel_generic);
+    return kernel(p, n);
+----------------------------------------------------------- */
+
+#define KK_CPU_X64_SSSE3     (KK_U32(1)<<0)
+#define KK_CPU_X64_SSE42     (KK_U32(1)<<1)
+#define KK_CPU_X64_AVX       (KK_U32(1)<<2)   // includes os support for the ymm state
+#define KK_CPU_X64_AVX2      (KK_U32(1)<<3)
+#define KK_CPU_X64_AVX512BW  (KK_U32(1)<<4)   // set only with avx512f and avx512vl as well
+#define KK_CPU_X64_BMI2      (KK_U32(1)<<5)
+#define KK_CPU_ARM_NEON      (KK_U32(1)<<8)
+
+kk_decl_export uint32_t kk_cpu_features;   // detected in `init.c`
+
+static inline bool kk_cpu_has(uint32_t features) {
+  return ((kk_cpu_features & features) == features);
+}
+
+// Resolve `fptr` once on first use to the simd variant if the cpu supports
+// `features`, and to the generic variant otherwise. A statement (not an
+// expression) so `fptr` is never read and assigned in a single expression.
+#define kk_cpu_dispatch(fptr,features,simd,generic) \
+  do { if ((fptr) == NULL) { (fptr) = (kk_cpu_has(features) ? (simd) : (generic)); } } while (0)
+
+
 /* -----------------------------------------------------------
   Is a word a power of two? see: <https://graphics.stanford.edu/~seander/bithacks.html#DetermineIfPowerOf2>
   (0 is not a power of two)
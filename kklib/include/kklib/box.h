@@ -352,9 +352,12 @@ typedef struct kk_boxed_value_s {
     x = kk_basetype_box(p); \
   } while(0)
 
-// `box_any` is used to return when yielding 
+// `box_any` is used to return when yielding
 // (and should be accepted by any unbox operation, and also dup/drop operations. That is why we use a ptr)
+kk_decl_export void kk_box_any_init(kk_context_t* ctx);
+
 static inline kk_box_t kk_box_any(kk_context_t* ctx) {
+  if (kk_unlikely(ctx->kk_box_any == NULL)) { kk_box_any_init(ctx); }  // allocated on first use (most contexts never yield)
   kk_basetype_dup_assert(kk_box_any_t, ctx->kk_box_any, KK_TAG_BOX_ANY);
   return kk_basetype_box(ctx->kk_box_any);
 }
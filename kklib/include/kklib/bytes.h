@@ -17,7 +17,8 @@
   - small byte sequence of at most 7 bytes (ending in a zero byte not included in the length)
   - normal sequence of bytes (ending in a zero byte not included in the length)
   - raw bytes, pointing to an (external) sequence of bytes.
-  
+  - a view: a sub-range sharing the storage of a parent bytes block (see `kk_bytes_view`)
+
   These are not necessarily canonical (e.g. a normal or small bytes can have length 0 instead of being an empty singleton)
 -------------------------------------------------------------------------------------------------------------*/
 
@@ -47,22 +48,36 @@ typedef struct kk_bytes_small_s {
 typedef struct kk_bytes_normal_s {
   struct kk_bytes_s _base;
   kk_ssize_t  length;
+  _Atomic(kk_ssize_t) count;              // cached character count if > 0 (maintained lazily for strings)
   uint8_t buf[1];                         // bytes in-place of `length+1` bytes ending in 0
 } *kk_bytes_normal_t;
 
 typedef struct kk_bytes_raw_s {
   struct kk_bytes_s _base;
-  kk_free_fun_t* free;     
-  const uint8_t* cbuf;                    
+  kk_free_fun_t* free;
+  const uint8_t* cbuf;
   kk_ssize_t        clength;
+  _Atomic(kk_ssize_t) count;              // cached character count if > 0 (maintained lazily for strings)
 } *kk_bytes_raw_t;
 
+// A zero-copy view on a sub-range of a parent bytes block (see `kk_bytes_view`).
+// The parent is a scanned field so the generic drop and mark paths keep it
+// alive (and mark it thread-shared) through the view; the shared storage must
+// be treated as read-only through a view.
+typedef struct kk_bytes_view_s {
+  struct kk_bytes_s _base;                // scan_fsize == 1 (just the parent field)
+  kk_box_t       parent;                  // the boxed parent bytes (never itself a view)
+  const uint8_t* buf;                     // points into the parent's storage
+  kk_ssize_t     length;
+  _Atomic(kk_ssize_t) count;              // cached character count if > 0 (maintained lazily for strings)
+} *kk_bytes_view_t;
+
 // Define bytes literals
 #define kk_define_bytes_literal(decl,name,len,init) \
-  static struct { struct kk_bytes_s _base; kk_ssize_t length; uint8_t buf[len+1]; } _static_##name = \
-    { { { KK_HEADER_STATIC(0,KK_TAG_BYTES) } }, len, init }; \
+  static struct { struct kk_bytes_s _base; kk_ssize_t length; _Atomic(kk_ssize_t) count; uint8_t buf[len+1]; } _static_##name = \
+    { { { KK_HEADER_STATIC(0,KK_TAG_BYTES) } }, len, 0, init }; \
   decl kk_bytes_t name = { &_static_##name._base._block }; \
-  
+
 #define kk_define_bytes_literal_empty(decl,name) \
   decl kk_bytes_t name = { (kk_block_t*)((uintptr_t)(5)) };
 
@@ -92,6 +107,7 @@ static inline kk_bytes_t kk_bytes_dup(kk_bytes_t b) {
 // Adds a terminating zero at the end. Return the raw buffer pointer in `buf` if non-NULL
 kk_decl_export kk_bytes_t kk_bytes_alloc_len(kk_ssize_t len, kk_ssize_t plen, const uint8_t* p, uint8_t** buf, kk_context_t* ctx);
 kk_decl_export kk_bytes_t kk_bytes_adjust_length(kk_bytes_t p, kk_ssize_t newlen, kk_context_t* ctx);
+kk_decl_export kk_bytes_t kk_bytes_view(kk_bytes_t b, kk_ssize_t offset, kk_ssize_t length, kk_context_t* ctx);  // O(1) sub-range sharing the parent storage
 
 // allocate uninitialized bytes
 static inline kk_bytes_t kk_bytes_alloc_buf(kk_ssize_t len, uint8_t** buf, kk_context_t* ctx) {
@@ -110,16 +126,45 @@ static inline kk_bytes_t kk_bytes_alloc_dupn(kk_ssize_t len, const uint8_t* p, k
   return kk_bytes_alloc_len(len, len, p, NULL, ctx);
 }
 
-// Raw bytes that directly points to an external buffer.
-static inline kk_bytes_t kk_bytes_alloc_raw_len(kk_ssize_t len, const uint8_t* p, bool free, kk_context_t* ctx) {
+// Raw bytes that directly point to an external buffer which is released
+// by calling `free` (with the buffer and the raw bytes block) when no longer used.
+static inline kk_bytes_t kk_bytes_alloc_raw_fun(kk_ssize_t len, const uint8_t* p, kk_free_fun_t* free, kk_context_t* ctx) {
   if (len == 0 || p==NULL) return kk_bytes_empty();
   struct kk_bytes_raw_s* br = kk_block_alloc_as(struct kk_bytes_raw_s, 0, KK_TAG_BYTES_RAW, ctx);
-  br->free = (free ? &kk_free_fun : NULL);
+  br->free = free;
   br->cbuf = p;
   br->clength = len;
+  kk_atomic_store_relaxed(&br->count, 0);
   return kk_datatype_from_base(&br->_base);
 }
 
+// Raw bytes that directly points to an external buffer.
+static inline kk_bytes_t kk_bytes_alloc_raw_len(kk_ssize_t len, const uint8_t* p, bool free, kk_context_t* ctx) {
+  return kk_bytes_alloc_raw_fun(len, p, (free ? &kk_free_fun : NULL), ctx);
+}
+
+/*--------------------------------------------------------------------------------------
+  Zero-copy FFI: import foreign buffers, and export (pin) byte storage.
+
+  `kk_bytes_import` wraps a caller-owned buffer as raw bytes without copying; the
+  `release` callback is invoked exactly once -- with the buffer, its length, and the
+  `env` pointer -- when the last reference is dropped, on whatever thread that happens.
+  The buffer must stay valid and unmodified until then.
+
+  `kk_bytes_pin` takes an extra reference and returns a direct pointer to the
+  (contiguous, immutable) byte storage; since blocks never move, the pointer stays
+  valid until the matching `kk_bytes_unpin` releases that reference again. When a
+  pinned pointer or imported bytes crosses threads, first mark the value as
+  thread-shared (`kk_box_mark_shared`) so further reference counting is atomic.
+--------------------------------------------------------------------------------------*/
+
+// Called exactly once when the last reference to an imported buffer is dropped.
+typedef void (kk_bytes_release_fun_t)(const uint8_t* buf, kk_ssize_t len, void* env);
+
+// Import a caller-owned buffer as bytes without copying (see above).
+// An empty (or NULL) buffer is released right away and the empty bytes returned.
+kk_decl_export kk_bytes_t kk_bytes_import(const uint8_t* buf, kk_ssize_t len, kk_bytes_release_fun_t* release, void* env, kk_context_t* ctx);
+
 // Get access to the bytes via a pointer (and retrieve the length as well)
 static inline const uint8_t* kk_bytes_buf_borrow(const kk_bytes_t b, kk_ssize_t* len) {
   static const uint8_t empty[16] = { 0 };
@@ -146,6 +191,11 @@ static inline const uint8_t* kk_bytes_buf_borrow(const kk_bytes_t b, kk_ssize_t*
     if (len != NULL) *len = bn->length;
     return &bn->buf[0];
   }
+  else if (tag == KK_TAG_BYTES_VIEW) {
+    kk_bytes_view_t bv = kk_datatype_as_assert(kk_bytes_view_t, b, KK_TAG_BYTES_VIEW);
+    if (len != NULL) *len = bv->length;
+    return bv->buf;
+  }
   else {
     kk_bytes_raw_t br = kk_datatype_as_assert(kk_bytes_raw_t, b, KK_TAG_BYTES_RAW);
     if (len != NULL) *len = br->clength;
@@ -157,6 +207,40 @@ static inline const char* kk_bytes_cbuf_borrow(const kk_bytes_t b, kk_ssize_t* l
   return (const char*)kk_bytes_buf_borrow(b, len);
 }
 
+// Pin the storage of `b` (borrowed): takes an extra reference and returns a direct
+// pointer that stays valid until a matching `kk_bytes_unpin` of the same bytes.
+static inline const uint8_t* kk_bytes_pin(kk_bytes_t b, kk_ssize_t* len) {
+  kk_bytes_dup(b);
+  return kk_bytes_buf_borrow(b, len);
+}
+
+// Release the reference taken by `kk_bytes_pin` (consumes `b`).
+static inline void kk_bytes_unpin(kk_bytes_t b, kk_context_t* ctx) {
+  kk_bytes_drop(b, ctx);
+}
+
+// The cached character count slot of a bytes block: 0 if not yet known, or NULL for
+// small bytes which are counted directly (see `kk_string_count_borrow` in `string.c`).
+static inline _Atomic(kk_ssize_t)* kk_bytes_cached_count_ref(const kk_bytes_t b) {
+  if (kk_datatype_is_singleton(b)) return NULL;
+  const kk_tag_t tag = kk_datatype_tag(b);
+  if (tag == KK_TAG_BYTES)      { return &kk_datatype_as_assert(kk_bytes_normal_t, b, KK_TAG_BYTES)->count; }
+  if (tag == KK_TAG_BYTES_RAW)  { return &kk_datatype_as_assert(kk_bytes_raw_t, b, KK_TAG_BYTES_RAW)->count; }
+  if (tag == KK_TAG_BYTES_VIEW) { return &kk_datatype_as_assert(kk_bytes_view_t, b, KK_TAG_BYTES_VIEW)->count; }
+  return NULL;
+}
+
+static inline kk_decl_pure bool kk_bytes_is_small_borrow(const kk_bytes_t b) {
+  return kk_datatype_has_ptr_tag(b, KK_TAG_BYTES_SMALL);
+}
+
+// The 8-byte value of a small bytes: the content followed by the ending zero and
+// 0xFF padding. As the padding is canonical, two small bytes are equal
+// iff their values are equal.
+static inline kk_decl_pure uint64_t kk_bytes_small_value_borrow(const kk_bytes_t b) {
+  return kk_datatype_as_assert(kk_bytes_small_t, b, KK_TAG_BYTES_SMALL)->u.buf_value;
+}
+
 
 
 /*--------------------------------------------------------------------------------------------------
@@ -221,7 +305,16 @@ static inline bool kk_bytes_is_neq(kk_bytes_t s1, kk_bytes_t s2, kk_context_t* c
   Utilities
 --------------------------------------------------------------------------------------------------*/
 
-const uint8_t* kk_memmem(const uint8_t* p, kk_ssize_t plen, const uint8_t* pat, kk_ssize_t patlen);
+// Vectorized substring search (see `bytes.c`); returns a pointer to the first
+// occurrence of `pat` in `p`, or NULL if not found.
+kk_decl_export const uint8_t* kk_bytes_find(const uint8_t* p, kk_ssize_t plen, const uint8_t* pat, kk_ssize_t patlen);
+
+static inline const uint8_t* kk_memchr(const void* p, uint8_t b, kk_ssize_t len) {
+  return (len <= 0 ? NULL : (const uint8_t*)memchr(p, b, kk_to_size_t(len)));
+}
+static inline const uint8_t* kk_memmem(const uint8_t* p, kk_ssize_t plen, const uint8_t* pat, kk_ssize_t patlen) {
+  return kk_bytes_find(p, plen, pat, patlen);
+}
 
 static inline void kk_memcpy(void* dest, const void* src, kk_ssize_t len) {
   memcpy(dest, src, kk_to_size_t(len));
@@ -257,4 +350,42 @@ kk_decl_export bool    kk_bytes_ends_with(kk_bytes_t str, kk_bytes_t post, kk_co
 kk_decl_export bool    kk_bytes_contains(kk_bytes_t str, kk_bytes_t sub, kk_context_t* ctx);
 
 
+/*--------------------------------------------------------------------------------------------------
+  Bytes builder: incremental construction of a `kk_bytes_t` in amortized O(1) appends.
+  The builder uniquely owns a single over-allocated bytes block and appends in
+  place, growing geometrically; `kk_bytes_builder_done` trims it to the exact
+  length. Unlike the chunked string builder (see `string.h`) the data stays
+  contiguous, so a builder can double as the backing of a network send buffer:
+  `kk_bytes_builder_reserve` hands out a raw write position and
+  `kk_bytes_builder_commit` accounts for the bytes written into it.
+--------------------------------------------------------------------------------------------------*/
+
+typedef struct kk_bytes_builder_s {
+  kk_bytes_t bytes;    // uniquely owned normal bytes block whose `length` is the capacity
+  kk_ssize_t len;      // used prefix of the block
+} kk_bytes_builder_t;
+
+kk_decl_export void       kk_bytes_builder_init(kk_bytes_builder_t* bb);
+kk_decl_export uint8_t*   kk_bytes_builder_reserve(kk_bytes_builder_t* bb, kk_ssize_t extra, kk_context_t* ctx);
+kk_decl_export void       kk_bytes_builder_append_buf(kk_bytes_builder_t* bb, const uint8_t* p, kk_ssize_t len, kk_context_t* ctx);
+kk_decl_export kk_bytes_t kk_bytes_builder_done(kk_bytes_builder_t* bb, kk_context_t* ctx);   // trims to the exact length; the builder can be reused
+kk_decl_export void       kk_bytes_builder_clear(kk_bytes_builder_t* bb, kk_context_t* ctx);  // discard without materializing
+
+static inline kk_ssize_t kk_bytes_builder_len(const kk_bytes_builder_t* bb) {
+  return bb->len;
+}
+
+// account for `n` bytes written after a `kk_bytes_builder_reserve`
+static inline void kk_bytes_builder_commit(kk_bytes_builder_t* bb, kk_ssize_t n) {
+  kk_assert_internal(n >= 0);
+  bb->len += n;
+}
+
+static inline void kk_bytes_builder_append(kk_bytes_builder_t* bb, kk_bytes_t b, kk_context_t* ctx) {
+  kk_ssize_t len;
+  const uint8_t* p = kk_bytes_buf_borrow(b, &len);
+  kk_bytes_builder_append_buf(bb, p, len, ctx);
+  kk_bytes_drop(b, ctx);
+}
+
 #endif // KK_BYTES_H
@@ -248,6 +248,10 @@ static inline bool kk_integer_small_eq(kk_integer_t x, kk_integer_t y) {
 }
 
 
+// Static initializer for a small integer literal; use only in static constant
+// constructor blocks (see `kk_static_con_base` in `kklib.h`).
+#define kk_integer_static(i)  { (uintptr_t)(((i)<<2) | 1) }  /* as kk_integer_from_small */
+
 #define kk_integer_zero     (kk_integer_from_small(0))
 #define kk_integer_one      (kk_integer_from_small(1))
 #define kk_integer_min_one  (kk_integer_from_small(-1))
@@ -306,6 +310,7 @@ kk_decl_export kk_decl_noinline kk_ssize_t kk_integer_clamp_ssize_t_bigint(kk_in
 kk_decl_export kk_decl_noinline double     kk_integer_as_double_bigint(kk_integer_t i);
 
 kk_decl_export kk_decl_noinline kk_integer_t  kk_integer_add_generic(kk_integer_t x, kk_integer_t y, kk_context_t* ctx);
+kk_decl_export kk_decl_noinline kk_integer_t  kk_integer_add_into(kk_integer_t acc, kk_integer_t x, kk_context_t* ctx);  // in-place accumulate for reduction loops
 kk_decl_export kk_decl_noinline kk_integer_t  kk_integer_sub_generic(kk_integer_t x, kk_integer_t y, kk_context_t* ctx);
 kk_decl_export kk_decl_noinline kk_integer_t  kk_integer_mul_generic(kk_integer_t x, kk_integer_t y, kk_context_t* ctx);
 
@@ -26,6 +26,48 @@ kk_decl_export int  kk_os_read_line(kk_string_t* result, kk_context_t* ctx);
 kk_decl_export int  kk_os_read_text_file(kk_string_t path, kk_string_t* result, kk_context_t* ctx);
 kk_decl_export int  kk_os_write_text_file(kk_string_t path, kk_string_t content, kk_context_t* ctx);
 
+// Heap snapshots: serialize a graph of constant heap blocks into a relocatable file
+// and load it back by memory mapping the file directly as (stuck, thread shared) heap
+// blocks, shared between processes and never freed. Saving fails with `ENOTSUP` when
+// the graph holds non-constant data -- closures, mutable references, or blocks with
+// raw C pointers (see the snapshot section in `os.c`).
+kk_decl_export int  kk_os_snapshot_save(kk_string_t path, kk_box_t root, kk_context_t* ctx);
+kk_decl_export int  kk_os_snapshot_load(kk_string_t path, kk_box_t* root, kk_context_t* ctx);
+
+// Asynchronous file i/o: the returned promise resolves with an (errno,result)
+// pair that `kk_os_aio_await` unpacks (see the async section in `os.c`).
+kk_decl_export kk_box_t kk_os_read_text_file_async(kk_string_t path, kk_context_t* ctx);
+kk_decl_export kk_box_t kk_os_write_text_file_async(kk_string_t path, kk_string_t content, kk_context_t* ctx);
+kk_decl_export int      kk_os_aio_await(kk_box_t pr, kk_box_t* result, kk_context_t* ctx);
+
+// Streaming file reader: read a file incrementally in utf-8 boundary aligned chunks;
+// a chunk of length 0 signals the end of the file (see the streaming section in `os.c`).
+kk_decl_export int  kk_os_freader_open(kk_string_t path, kk_ssize_t chunk_size, kk_box_t* reader, kk_context_t* ctx);
+kk_decl_export int  kk_os_freader_next(kk_box_t reader, kk_bytes_t* chunk, kk_context_t* ctx);
+kk_decl_export void kk_os_freader_close(kk_box_t reader, kk_context_t* ctx);
+
+// Buffered line reader: read lines from a file or stdin through a large internal
+// buffer; long lines are returned as zero-copy views into the buffer. `read_line`
+// sets `has_line` to `false` at the end of the input and `read_lines` returns an
+// empty vector (an empty line is a valid line, see the line reader section in `os.c`).
+kk_decl_export int  kk_os_lreader_open(kk_string_t path, kk_ssize_t buf_size, kk_box_t* reader, kk_context_t* ctx);
+kk_decl_export kk_box_t kk_os_lreader_stdin(kk_ssize_t buf_size, kk_context_t* ctx);
+kk_decl_export int  kk_os_lreader_read_line(kk_box_t reader, kk_string_t* line, bool* has_line, kk_context_t* ctx);
+kk_decl_export int  kk_os_lreader_read_lines(kk_box_t reader, kk_ssize_t max_lines, kk_vector_t* lines, kk_context_t* ctx);
+kk_decl_export void kk_os_lreader_close(kk_box_t reader, kk_context_t* ctx);
+
+// Streaming directory traversal: iterate over directory entries one at a time so recursive
+// walks run in constant memory; an empty name signals the end of the directory. The entry
+// kind comes from the directory stream itself and needs no extra `stat` call per entry
+// (see the streaming section in `os.c`).
+#define KK_DIRENT_UNKNOWN  (0)   // the file system did not report a kind
+#define KK_DIRENT_FILE     (1)
+#define KK_DIRENT_DIR      (2)
+#define KK_DIRENT_SYMLINK  (3)
+kk_decl_export int  kk_os_diriter_open(kk_string_t dir, kk_box_t* iter, kk_context_t* ctx);
+kk_decl_export int  kk_os_diriter_next(kk_box_t iter, kk_string_t* name, int* kind, kk_context_t* ctx);
+kk_decl_export void kk_os_diriter_close(kk_box_t iter, kk_context_t* ctx);
+
 kk_decl_export int  kk_os_ensure_dir(kk_string_t dir, int mode, kk_context_t* ctx);
 kk_decl_export int  kk_os_copy_file(kk_string_t from, kk_string_t to, bool preserve_mtime, kk_context_t* ctx);
 kk_decl_export bool kk_os_is_directory(kk_string_t path, kk_context_t* ctx);
@@ -35,9 +77,19 @@ kk_decl_export int  kk_os_list_directory(kk_string_t dir, kk_vector_t* contents,
 kk_decl_export int  kk_os_run_command(kk_string_t cmd, kk_string_t* output, kk_context_t* ctx);
 kk_decl_export int  kk_os_run_system(kk_string_t cmd, kk_context_t* ctx);
 
+// Start a command without blocking; many can be in flight at once as a single supervisor
+// thread polls all output pipes. Await the promise with `kk_os_aio_await`.
+kk_decl_export kk_box_t kk_os_run_command_async(kk_string_t cmd, kk_context_t* ctx);
+
 kk_decl_export kk_secs_t  kk_timer_ticks(kk_asecs_t* atto_secs, kk_context_t* ctx);
 kk_decl_export kk_asecs_t kk_timer_resolution(kk_context_t* ctx);
 
+// Low overhead timestamps for high-frequency tracing; both share the `kk_timer_ticks`
+// timeline (see `time.c`). `coarse` reads the kernel coarse clock (~1-16ms resolution,
+// no syscall); `fast` extrapolates from a calibrated cycle counter when available.
+kk_decl_export kk_secs_t  kk_timer_ticks_coarse(kk_asecs_t* atto_secs, kk_context_t* ctx);
+kk_decl_export kk_secs_t  kk_timer_ticks_fast(kk_asecs_t* atto_secs, kk_context_t* ctx);
+
 kk_decl_export kk_secs_t  kk_time_unix_now(kk_asecs_t* atto_secs, kk_context_t* ctx);
 kk_decl_export kk_asecs_t kk_time_resolution(kk_context_t* ctx);
 
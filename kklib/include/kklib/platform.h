@@ -146,6 +146,7 @@
 #define kk_decl_noinline   __attribute__((noinline))
 #define kk_decl_align(a)   __attribute__((aligned(a)))
 #define kk_decl_thread     __thread
+#define kk_cpu_prefetch(p) __builtin_prefetch(p)
 #elif defined(_MSC_VER)
 #pragma warning(disable:4214)  // using bit field types other than int
 #pragma warning(disable:4101)  // unreferenced local variable
@@ -160,6 +161,11 @@
 #define kk_decl_noinline   __declspec(noinline)
 #define kk_decl_align(a)   __declspec(align(a))
 #define kk_decl_thread     __declspec(thread)
+#if defined(_M_X64) || defined(_M_IX86)
+#define kk_cpu_prefetch(p) _mm_prefetch((const char*)(p), _MM_HINT_T0)
+#else
+#define kk_cpu_prefetch(p) ((void)(p))
+#endif
 #ifndef __cplusplus
 #error "when using cl (the Microsoft Visual C++ compiler), use the /TP option to always compile in C++ mode."
 #endif
@@ -169,8 +175,9 @@
 #define kk_decl_const
 #define kk_decl_pure
 #define kk_decl_noinline   
-#define kk_decl_align(a)   
+#define kk_decl_align(a)
 #define kk_decl_thread     __thread
+#define kk_cpu_prefetch(p) ((void)(p))
 #endif
 
 // Assertions; kk_assert_internal is only enabled when KK_DEBUG_FULL is defined
@@ -55,6 +55,21 @@ kk_decl_export bool     kk_srandom_is_strong(kk_context_t* ctx);
 kk_decl_export int32_t  kk_srandom_range_int32(int32_t min, int32_t max, kk_context_t* ctx);  // unbiased range
 kk_decl_export uint32_t kk_srandom_range_uint32(uint32_t max, kk_context_t* ctx);             // unbiased range
 kk_decl_export double   kk_srandom_double(kk_context_t* ctx);
+kk_decl_export void     kk_srandom_bytes(uint8_t* buf, kk_ssize_t len, kk_context_t* ctx);    // bulk fill (vectorized)
+
+/*--------------------------------------------------------------------------------------
+  Deterministic splittable pseudo random numbers (pcg based); fast but not secure.
+  The context carries a `kk_prandom_t` seeded to a fixed default so runs are
+  reproducible; every task scheduled on a task group splits off its own child
+  stream, which makes parallel simulations reproducible regardless of how the
+  tasks end up distributed over the worker threads.
+--------------------------------------------------------------------------------------*/
+
+kk_decl_export void     kk_prandom_init(kk_prandom_t* rnd, uint64_t seed, uint64_t stream);
+kk_decl_export uint32_t kk_prandom_uint32(kk_prandom_t* rnd);
+kk_decl_export uint64_t kk_prandom_uint64(kk_prandom_t* rnd);
+kk_decl_export double   kk_prandom_double(kk_prandom_t* rnd);                   // in [0,1)
+kk_decl_export void     kk_prandom_split(kk_prandom_t* rnd, kk_prandom_t* child);
 
 
 #endif // include guard
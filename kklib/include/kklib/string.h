@@ -117,9 +117,9 @@ static inline kk_string_t kk_string_empty(void) {
 
 // Define string literals
 #define kk_define_string_literal(decl,name,len,chars) \
-  static struct { struct kk_bytes_s _base; size_t length; char str[len+1]; } _static_##name = \
-    { { { KK_HEADER_STATIC(0,KK_TAG_STRING) } }, len, chars }; \
-  decl kk_string_t name = { { (uintptr_t)&_static_##name._base._block } };  
+  static struct { struct kk_bytes_s _base; kk_ssize_t length; _Atomic(kk_ssize_t) count; char str[len+1]; } _static_##name = \
+    { { { KK_HEADER_STATIC(0,KK_TAG_STRING) } }, len, 0, chars }; \
+  decl kk_string_t name = { { (uintptr_t)&_static_##name._base._block } };
 
 #define kk_define_string_literal_empty(decl,name) \
   decl kk_string_t name = { { (kk_block_t*)((uintptr_t)(5)) } };
@@ -228,6 +228,13 @@ static inline kk_string_t kk_string_alloc_raw(const char* s, bool free, kk_conte
   return kk_string_alloc_raw_len(kk_sstrlen(s), s, free, ctx);
 }
 
+// Import a caller-owned buffer as a string without copying (see `kk_bytes_import` in
+// `bytes.h` for the release contract). Must be valid utf-8 ending in a zero byte.
+static inline kk_string_t kk_string_import(kk_ssize_t len, const char* s, kk_bytes_release_fun_t* release, void* env, kk_context_t* ctx) {
+  kk_assert_internal(s == NULL || (s[len]==0 && kk_utf8_is_validn(len, (const uint8_t*)s)));
+  return kk_unsafe_bytes_as_string(kk_bytes_import((const uint8_t*)s, len, release, env, ctx));
+}
+
 static inline const uint8_t* kk_string_buf_borrow(const kk_string_t str, kk_ssize_t* len) {
   return kk_bytes_buf_borrow(str.bytes, len);  
 }
@@ -236,6 +243,17 @@ static inline const char* kk_string_cbuf_borrow(const kk_string_t str, kk_ssize_
   return (const char*)kk_string_buf_borrow(str, len);
 }
 
+// Pin the utf-8 storage of `str` (borrowed); the returned pointer stays valid until
+// a matching `kk_string_unpin` of the same string (see `kk_bytes_pin` in `bytes.h`).
+static inline const char* kk_string_pin(kk_string_t str, kk_ssize_t* len) {
+  return (const char*)kk_bytes_pin(str.bytes, len);
+}
+
+// Release the reference taken by `kk_string_pin` (consumes `str`).
+static inline void kk_string_unpin(kk_string_t str, kk_context_t* ctx) {
+  kk_bytes_unpin(str.bytes, ctx);
+}
+
 static inline int kk_string_cmp_cstr_borrow(const kk_string_t s, const char* t) {
   return strcmp(kk_string_cbuf_borrow(s,NULL), t);
 }
@@ -365,6 +383,28 @@ static inline kk_string_t    kk_string_alloc_from_qutf16w(const wchar_t* wstr, k
   return kk_string_alloc_from_qutf16((const uint16_t*)wstr, ctx);
 }
 
+/*--------------------------------------------------------------------------------------------------
+  String interning: `kk_string_intern` returns the canonical copy of a string from a process
+  wide table so equal interned strings are pointer equal and each symbol is in memory once.
+--------------------------------------------------------------------------------------------------*/
+
+// Interned strings are marked in the (otherwise unused) `_field_idx` header byte: the intern
+// table keeps at most one live copy of each byte sequence so two _distinct_ marked pointers
+// are guaranteed unequal (see `kk_string_is_eq_borrow`).
+#define KK_STRING_INTERNED  (0xA5)
+
+// Return the canonical copy of `s` (interning it first if needed); consumes `s`.
+kk_decl_export kk_string_t kk_string_intern(kk_string_t s, kk_context_t* ctx);
+
+// Release the intern table entries; canonical strings still referenced elsewhere
+// stay valid (and compare byte-wise again).
+kk_decl_export void kk_string_intern_clear(kk_context_t* ctx);
+
+static inline bool kk_string_is_interned_borrow(kk_string_t s) {
+  return (kk_datatype_is_ptr(s.bytes) && kk_datatype_as_ptr(s.bytes)->header._field_idx == KK_STRING_INTERNED);
+}
+
+
 /*--------------------------------------------------------------------------------------------------
   Utilities that can use the bytes functions
 --------------------------------------------------------------------------------------------------*/
@@ -378,19 +418,24 @@ static inline int kk_string_cmp(kk_string_t str1, kk_string_t str2, kk_context_t
 }
 
 static inline bool kk_string_is_eq_borrow(kk_string_t s1, kk_string_t s2) {
+  if (kk_string_ptr_eq_borrow(s1, s2)) return true;
+  if (kk_string_is_interned_borrow(s1) && kk_string_is_interned_borrow(s2)) return false; // distinct interned strings differ
   return (kk_string_cmp_borrow(s1, s2) == 0);
 }
 
 static inline bool kk_string_is_neq_borrow(kk_string_t s1, kk_string_t s2) {
-  return (kk_string_cmp_borrow(s1, s2) != 0);
+  return !kk_string_is_eq_borrow(s1, s2);
 }
 
 static inline bool kk_string_is_eq(kk_string_t s1, kk_string_t s2, kk_context_t* ctx) {
-  return (kk_string_cmp(s1, s2, ctx) == 0);
+  bool eq = kk_string_is_eq_borrow(s1, s2);
+  kk_string_drop(s1, ctx);
+  kk_string_drop(s2, ctx);
+  return eq;
 }
 
 static inline bool kk_string_is_neq(kk_string_t s1, kk_string_t s2, kk_context_t* ctx) {
-  return (kk_string_cmp(s1, s2, ctx) != 0);
+  return !kk_string_is_eq(s1, s2, ctx);
 }
 
 static inline kk_string_t kk_string_cat(kk_string_t s1, kk_string_t s2, kk_context_t* ctx) {
@@ -413,6 +458,16 @@ static inline kk_string_t kk_string_repeat(kk_string_t s, kk_ssize_t n, kk_conte
   return kk_unsafe_bytes_as_string(kk_bytes_repeat(s.bytes, n, ctx));
 }
 
+// Vectorized substring search on the underlying utf-8 bytes; borrows both strings
+// and returns a pointer into `str` to the first occurrence of `sub`, or NULL.
+static inline const uint8_t* kk_string_find_borrow(kk_string_t str, kk_string_t sub) {
+  kk_ssize_t len;
+  const uint8_t* s = kk_string_buf_borrow(str, &len);
+  kk_ssize_t sublen;
+  const uint8_t* t = kk_string_buf_borrow(sub, &sublen);
+  return kk_bytes_find(s, len, t, sublen);
+}
+
 static inline kk_ssize_t kk_string_index_of1(kk_string_t str, kk_string_t sub, kk_context_t* ctx) {     // returns 0 for not found, or index + 1
   return kk_bytes_index_of1(str.bytes, sub.bytes, ctx);
 }
@@ -438,8 +493,9 @@ static inline bool   kk_string_contains(kk_string_t str, kk_string_t sub, kk_con
   Utilities that are string specific
 --------------------------------------------------------------------------------------------------*/
 
-kk_decl_export kk_ssize_t kk_decl_pure kk_string_count_borrow(kk_string_t str);  // number of code points
+kk_decl_export kk_ssize_t kk_decl_pure kk_string_count_borrow(kk_string_t str);  // number of code points (cached on large string blocks)
 kk_decl_export kk_ssize_t kk_decl_pure kk_string_count(kk_string_t str, kk_context_t* ctx);  // number of code points
+kk_decl_export bool kk_decl_pure kk_string_is_ascii_borrow(kk_string_t str);  // true if all characters are a single byte; chars can then be indexed by byte directly
 kk_decl_export kk_ssize_t kk_decl_pure kk_string_count_pattern_borrow(kk_string_t str, kk_string_t pattern);
 
 kk_decl_export int kk_string_icmp_borrow(kk_string_t str1, kk_string_t str2);             // ascii case insensitive
@@ -471,5 +527,48 @@ kk_decl_export kk_string_t kk_double_show_fixed(double d, int32_t prec, kk_conte
 kk_decl_export kk_string_t kk_double_show_exp(double d, int32_t prec, kk_context_t* ctx);
 kk_decl_export kk_string_t kk_double_show(double d, int32_t prec, kk_context_t* ctx);
 
+// Shortest round-trip formatting and fast parsing (Grisu2 / Eisel-Lemire, see `double.c`)
+kk_decl_export kk_string_t kk_double_show_shortest(double d, kk_context_t* ctx);
+kk_decl_export double      kk_double_parse(const char* s, const char** end, kk_context_t* ctx);
+
+
+/*--------------------------------------------------------------------------------------------------
+  String builder: incremental string construction in amortized O(1) appends
+  (repeated `kk_string_cat` copies both operands and is quadratic). The
+  appended bytes are kept in a list of chunks and copied once into the
+  final string on `kk_string_builder_done`.
+--------------------------------------------------------------------------------------------------*/
+
+struct kk_string_builder_chunk_s;
+
+typedef struct kk_string_builder_s {
+  struct kk_string_builder_chunk_s* head;  // list of chunks in append order
+  struct kk_string_builder_chunk_s* tail;
+  kk_ssize_t total;                        // total appended bytes
+} kk_string_builder_t;
+
+kk_decl_export void        kk_string_builder_init(kk_string_builder_t* sb);
+kk_decl_export void        kk_string_builder_append_buf(kk_string_builder_t* sb, const uint8_t* p, kk_ssize_t len, kk_context_t* ctx);
+kk_decl_export kk_string_t kk_string_builder_done(kk_string_builder_t* sb, kk_context_t* ctx);  // frees the chunks; the builder can be reused
+kk_decl_export void        kk_string_builder_clear(kk_string_builder_t* sb, kk_context_t* ctx); // discard without materializing
+
+static inline void kk_string_builder_append(kk_string_builder_t* sb, kk_string_t s, kk_context_t* ctx) {
+  kk_ssize_t len;
+  const uint8_t* p = kk_string_buf_borrow(s, &len);
+  kk_string_builder_append_buf(sb, p, len, ctx);
+  kk_string_drop(s, ctx);
+}
+
+static inline void kk_string_builder_append_valid_utf8(kk_string_builder_t* sb, const char* s, kk_context_t* ctx) {
+  kk_assert_internal(kk_utf8_is_valid(s));
+  kk_string_builder_append_buf(sb, (const uint8_t*)s, kk_sstrlen(s), ctx);
+}
+
+static inline void kk_string_builder_append_char(kk_string_builder_t* sb, kk_char_t c, kk_context_t* ctx) {
+  uint8_t buf[8];
+  kk_ssize_t count;
+  kk_utf8_write(c, buf, &count);
+  kk_string_builder_append_buf(sb, buf, count, ctx);
+}
 
 #endif // include guard
@@ -15,6 +15,8 @@
 
 typedef kk_box_t  kk_promise_t;
 
+kk_decl_export kk_promise_t kk_promise_alloc( kk_context_t* ctx );
+kk_decl_export void         kk_promise_set( kk_promise_t pr, kk_box_t r, kk_context_t* ctx );
 kk_decl_export kk_box_t     kk_promise_get( kk_promise_t pr, kk_context_t* ctx );
 
 /*--------------------------------------------------------------------------------------
@@ -22,11 +24,48 @@ kk_decl_export kk_box_t     kk_promise_get( kk_promise_t pr, kk_context_t* ctx )
 --------------------------------------------------------------------------------------*/
 
 kk_decl_export kk_promise_t kk_task_schedule( kk_function_t fun, kk_context_t* ctx );
+kk_decl_export kk_promise_t kk_io_task_schedule( kk_function_t fun, kk_context_t* ctx );  // on the dedicated (blocking) i/o task group
 // kk_decl_export kk_promise_t kk_task_schedule_n( kk_ssize_t count, kk_ssize_t stride, kk_function_t fun, kk_function_t combine, kk_context_t* ctx );
 
 kk_decl_export void kk_task_set_default_concurrency(kk_ssize_t thread_count, kk_context_t* ctx);
 // kk_decl_export void kk_task_group_free( kk_task_group_t* tg, kk_context_t* ctx );
 
+/*--------------------------------------------------------------------------------------
+   Fork-join: potentially-parallel calls with lazy task creation.
+   `kk_task_fork` publishes a stack-allocated frame on the forking worker's own
+   deque; it only becomes a real parallel task if an idle worker steals it. An
+   un-stolen frame is popped back at the join and runs inline, so fine-grained
+   divide-and-conquer recursion pays no heap task, promise, or futex per fork.
+--------------------------------------------------------------------------------------*/
+
+typedef struct kk_fork_s {
+  kk_function_t     fun;      // owned by the frame until it runs
+  kk_box_t          result;   // set by a stealer before `state` becomes available
+  kk_promise_t      promise;  // used instead of the deque on threads outside the task pool
+  _Atomic(uint32_t) state;    // promise states; only meaningful for a stolen frame
+  bool              queued;   // `false` when the frame never entered the deque
+} kk_fork_t;
+
+kk_decl_export void     kk_task_fork( kk_fork_t* fork, kk_function_t fun, kk_context_t* ctx );
+kk_decl_export kk_box_t kk_task_join( kk_fork_t* fork, kk_context_t* ctx );
+kk_decl_export kk_box_t kk_task_fork_join2( kk_function_t left, kk_function_t right, kk_function_t combine, kk_context_t* ctx );
+
+// Parallel vector primitives: split the index range over the task group in
+// cache-line-aligned chunks (see `thread.c`). For the fold, `fun` must be
+// associative with `init` as its unit as chunk partials are combined in order.
+kk_decl_export kk_vector_t kk_vector_par_map( kk_vector_t v, kk_function_t fun, kk_context_t* ctx );
+kk_decl_export kk_box_t    kk_vector_par_fold( kk_vector_t v, kk_box_t init, kk_function_t fun, kk_context_t* ctx );
+
+/*--------------------------------------------------------------------------------------
+   Channels: bounded lock-free queues for streaming between tasks
+--------------------------------------------------------------------------------------*/
+typedef kk_box_t kk_chan_t;
+
+kk_decl_export kk_chan_t kk_chan_alloc( kk_ssize_t capacity, kk_context_t* ctx );
+kk_decl_export bool      kk_chan_send( kk_chan_t ch, kk_box_t value, kk_context_t* ctx );   // blocks while full; `false` when closed (the value is dropped)
+kk_decl_export bool      kk_chan_recv( kk_chan_t ch, kk_box_t* result, kk_context_t* ctx ); // blocks while empty; `false` when closed and drained
+kk_decl_export void      kk_chan_close( kk_chan_t ch, kk_context_t* ctx );
+
 /*--------------------------------------------------------------------------------------
    Lvars
 --------------------------------------------------------------------------------------*/
@@ -21,6 +21,7 @@
 
 #include "bits.c"
 #include "box.c"
+#include "double.c"
 #include "bytes.c"
 #include "init.c"
 #include "integer.c"
@@ -8,6 +8,100 @@
 #include "kklib.h"
 
 
+/*----------------------------------------------------------------
+  Arena allocation phases (see `kk_arena_t` in `kklib.h`)
+----------------------------------------------------------------*/
+
+static kk_arena_chunk_t* kk_arena_chunk_alloc(kk_context_t* ctx) {
+  kk_arena_chunk_t* c = (kk_arena_chunk_t*)kk_malloc(KK_ARENA_CHUNK_SIZE, ctx);
+  c->next = NULL;
+  c->end = (uint8_t*)c + KK_ARENA_CHUNK_SIZE;
+  return c;
+}
+
+// Start a bump-allocation phase: until the matching `kk_arena_end` all small
+// block allocations come from the arena. Phases do not nest.
+kk_decl_export void kk_arena_begin(kk_context_t* ctx) {
+  kk_assert(ctx->arena.chunks == NULL);
+  kk_arena_chunk_t* c = kk_arena_chunk_alloc(ctx);
+  ctx->arena.chunks = c;
+  ctx->arena.top = (uint8_t*)(c + 1);
+  ctx->arena.end = c->end;
+}
+
+// Release every allocation of the phase in one sweep. All arena blocks must
+// be dead by now: only their children were released on their final drop.
+kk_decl_export void kk_arena_end(kk_context_t* ctx) {
+  kk_arena_chunk_t* c = ctx->arena.chunks;
+  ctx->arena.chunks = NULL;
+  ctx->arena.top = NULL;
+  ctx->arena.end = NULL;
+  while (c != NULL) {
+    kk_arena_chunk_t* next = c->next;
+    kk_free(c, ctx);
+    c = next;
+  }
+}
+
+// Slow path of `kk_block_alloc_fresh`: the current chunk is full so start a
+// new one. Returns NULL for oversized requests which go to the heap instead
+// (and are then freed individually as usual).
+kk_decl_export kk_block_t* kk_arena_alloc(kk_ssize_t size, kk_context_t* ctx) {
+  kk_assert_internal(ctx->arena.top != NULL);
+  const kk_ssize_t asize = (size + 7) & ~KK_IZ(7);
+  if (asize > KK_ARENA_MAX_ALLOC) return NULL;
+  kk_arena_chunk_t* c = kk_arena_chunk_alloc(ctx);
+  c->next = ctx->arena.chunks;
+  ctx->arena.chunks = c;
+  uint8_t* p = (uint8_t*)(c + 1);
+  ctx->arena.top = p + asize;
+  ctx->arena.end = c->end;
+  return (kk_block_t*)p;
+}
+
+// Grow a unique arena-resident block (see `kk_block_realloc`): the fresh copy
+// comes from the arena again and the old memory stays until the phase ends.
+// The old block size is not tracked so the copy is bounded by the extent of
+// its chunk (reading over neighbouring arena blocks is harmless).
+kk_decl_export kk_block_t* kk_arena_realloc(kk_block_t* b, kk_ssize_t size, kk_context_t* ctx) {
+  kk_arena_chunk_t* c = ctx->arena.chunks;
+  while (c != NULL && !((uint8_t*)b >= (uint8_t*)(c + 1) && (uint8_t*)b < c->end)) { c = c->next; }
+  kk_assert_internal(c != NULL);
+  kk_block_t* nb = kk_block_alloc_fresh(size, ctx);
+  const kk_ssize_t avail = (c->end - (uint8_t*)b);
+  memcpy(nb, b, (size <= avail ? (size_t)size : (size_t)avail));
+  return nb;
+}
+
+
+/*----------------------------------------------------------------
+  Batch block allocation
+----------------------------------------------------------------*/
+
+// Allocate `n` blocks of `size` bytes in one call and hand them out as reuse
+// tokens: the reuse cache is drained first and the rest is served in tight
+// passes, so a list- or tree builder pays one call per strip instead of a
+// call, size-class lookup, and branch per cell. Each block is still an
+// individual heap allocation as blocks are freed individually; carving many
+// cells out of one request is what an arena phase provides (`kk_arena_begin`).
+kk_decl_export void kk_block_alloc_n(kk_reuse_t* blocks, kk_ssize_t n, kk_ssize_t size, kk_context_t* ctx) {
+  kk_ssize_t cached = 0;
+  while (cached < n) {
+    kk_block_t* b = kk_reuse_cache_pop(size, ctx);
+    if (b == NULL) break;
+    blocks[cached++] = b;
+  }
+  for (kk_ssize_t i = cached; i < n; i++) {
+    blocks[i] = kk_block_alloc_fresh(size, ctx);
+  }
+  for (kk_ssize_t i = 0; i < n; i++) {
+    // give each block a valid unique header so it can serve as a reuse token
+    // (`kk_block_alloc_at` re-initializes it with the real tag and scan size)
+    kk_block_init(blocks[i], size, 0, KK_TAG_BOX);
+  }
+}
+
+
 /*----------------------------------------------------------------
   Integer boxing
 ----------------------------------------------------------------*/
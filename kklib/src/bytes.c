@@ -39,6 +39,7 @@ kk_decl_export kk_decl_noinline kk_bytes_t kk_bytes_alloc_len(kk_ssize_t len, kk
       kk_memcpy(&b->buf[0], p, plen);
     }
     b->length = len;
+    kk_atomic_store_relaxed(&b->count, 0);
     b->buf[len] = 0;
     if (buf != NULL) *buf = &b->buf[0];
     // todo: kk_assert valid utf-8 in debug mode
@@ -47,6 +48,43 @@ kk_decl_export kk_decl_noinline kk_bytes_t kk_bytes_alloc_len(kk_ssize_t len, kk
 }
 
 
+/*--------------------------------------------------------------------------------------------------
+  Zero-copy import of foreign buffers (see `bytes.h` for the contract)
+--------------------------------------------------------------------------------------------------*/
+
+// An imported buffer extends a raw bytes block with the release callback and its
+// environment; all raw paths (drop, mark, borrow) treat it as plain raw bytes.
+typedef struct kk_bytes_import_s {
+  struct kk_bytes_raw_s   _raw;       // must come first: freed as a raw block
+  kk_bytes_release_fun_t* release;
+  void*                   env;
+} *kk_bytes_import_t;
+
+static void kk_bytes_import_free(void* p, kk_block_t* block, kk_context_t* ctx) {
+  kk_unused(ctx);
+  kk_bytes_import_t imp = (kk_bytes_import_t)block;
+  kk_assert_internal((const uint8_t*)p == imp->_raw.cbuf);
+  if (imp->release != NULL) {
+    (imp->release)((const uint8_t*)p, imp->_raw.clength, imp->env);
+  }
+}
+
+kk_decl_export kk_bytes_t kk_bytes_import(const uint8_t* buf, kk_ssize_t len, kk_bytes_release_fun_t* release, void* env, kk_context_t* ctx) {
+  if (buf == NULL || len <= 0) {
+    if (release != NULL) { release(buf, 0, env); }
+    return kk_bytes_empty();
+  }
+  kk_bytes_import_t imp = kk_block_alloc_as(struct kk_bytes_import_s, 0, KK_TAG_BYTES_RAW, ctx);
+  imp->_raw.free = &kk_bytes_import_free;
+  imp->_raw.cbuf = buf;
+  imp->_raw.clength = len;
+  kk_atomic_store_relaxed(&imp->_raw.count, 0);
+  imp->release = release;
+  imp->env = env;
+  return kk_datatype_from_base(&imp->_raw._base);
+}
+
+
 kk_bytes_t kk_bytes_adjust_length(kk_bytes_t b, kk_ssize_t newlen, kk_context_t* ctx) {
   if (newlen<=0) {
     kk_bytes_drop(b, ctx);
@@ -63,6 +101,7 @@ kk_bytes_t kk_bytes_adjust_length(kk_bytes_t b, kk_ssize_t newlen, kk_context_t*
     kk_assert_internal(kk_datatype_has_tag(b, KK_TAG_BYTES) && kk_datatype_is_unique(b));
     kk_bytes_normal_t nb = kk_datatype_as_assert(kk_bytes_normal_t, b, KK_TAG_BYTES);
     nb->length = newlen;
+    kk_atomic_store_relaxed(&nb->count, 0);  // invalidate the cached character count
     nb->buf[newlen] = 0;
     // kk_assert_internal(kk_bytes_is_valid(kk_bytes_dup(s),ctx));
     return b;
@@ -87,22 +126,256 @@ kk_bytes_t kk_bytes_adjust_length(kk_bytes_t b, kk_ssize_t newlen, kk_context_t*
 
 
 /*--------------------------------------------------------------------------------------------------
-  Compare
+  Views
+  A view shares the parent's storage so taking a sub-range is O(1); the parent
+  is kept alive through the view's scanned parent field and released by the
+  generic drop path when the last view drops. Views of views are flattened so
+  chains never build up.
 --------------------------------------------------------------------------------------------------*/
 
-const uint8_t* kk_memmem(const uint8_t* p, kk_ssize_t plen, const uint8_t* pat, kk_ssize_t patlen) {
-  // todo: optimize search algo?
-  kk_assert(p != NULL && pat != NULL);
-  if (plen <= 0 || patlen <= 0 || patlen > plen) return NULL;
-  const uint8_t* end = p + (plen - (patlen-1));
-  for (; p < end; p++) {
-    if (kk_memcmp(p, pat, patlen) == 0) return p;
+kk_bytes_t kk_bytes_view(kk_bytes_t b, kk_ssize_t offset, kk_ssize_t length, kk_context_t* ctx) {
+  kk_ssize_t len;
+  const uint8_t* buf = kk_bytes_buf_borrow(b, &len);
+  if (offset < 0) { offset = 0; }
+  if (offset > len) { offset = len; }
+  if (length > len - offset) { length = len - offset; }
+  if (length <= 0) {
+    kk_bytes_drop(b, ctx);
+    return kk_bytes_empty();
+  }
+  if (offset == 0 && length == len) {
+    return b;  // the whole range (also catches a view over its full range)
+  }
+  if (length <= KK_BYTES_SMALL_MAX) {
+    // a small range is cheaper as a copy than as a view pinning the parent
+    kk_bytes_t t = kk_bytes_alloc_dupn(length, buf + offset, ctx);
+    kk_bytes_drop(b, ctx);
+    return t;
+  }
+  if (kk_datatype_has_ptr_tag(b, KK_TAG_BYTES_VIEW)) {
+    // flatten: view into the view's parent directly (`buf` stays valid)
+    kk_bytes_t parent = kk_datatype_unbox(kk_box_dup(kk_datatype_as_assert(kk_bytes_view_t, b, KK_TAG_BYTES_VIEW)->parent));
+    kk_bytes_drop(b, ctx);
+    b = parent;
+  }
+  kk_bytes_view_t bv = kk_block_alloc_as(struct kk_bytes_view_s, 1, KK_TAG_BYTES_VIEW, ctx);
+  bv->parent = kk_datatype_box(b);
+  bv->buf = buf + offset;
+  bv->length = length;
+  kk_atomic_store_relaxed(&bv->count, 0);
+  return kk_datatype_from_base(&bv->_base);
+}
+
+
+/*--------------------------------------------------------------------------------------------------
+  Substring search
+  `kk_bytes_find` filters candidate positions 16 or 32 bytes at a time by comparing
+  the first and last pattern byte in parallel and verifying candidates with `memcmp`
+  (Mula, "SIMD-friendly algorithms for substring searching", 2018). The portable
+  fallback -- and the unsearched tail of the vector loops -- uses the linear-time,
+  constant-space two-way algorithm of Crochemore and Perrin ("Two-way string
+  matching", J. ACM 38(3), 1991). All split/index-of/replace/count paths (for both
+  bytes and strings) go through here via `kk_memmem`.
+--------------------------------------------------------------------------------------------------*/
+
+#if defined(__SSE2__) || (defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define KK_FIND_SSE2   (1)
+#include <emmintrin.h>
+#if defined(__AVX2__)
+// compiled with avx2 enabled
+#define KK_FIND_AVX2   (1)
+#define kk_target_avx2
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+// msvc compiles the intrinsics regardless of the target; select on the cpu at runtime
+#define KK_FIND_AVX2   (1)
+#define kk_target_avx2
+#include <immintrin.h>
+#elif defined(__GNUC__)
+// compile the kernel for avx2 and select on the cpu at runtime (see `bits.h`)
+#define KK_FIND_AVX2   (1)
+#define kk_target_avx2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define KK_FIND_NEON   (1)
+#include <arm_neon.h>
+#endif
+
+// Compute the maximal suffix of `pat` (under the reversed byte ordering when `rev`);
+// return its starting position - 1 and set its period.
+static kk_ssize_t kk_find_maximal_suffix(const uint8_t* pat, kk_ssize_t patlen, bool rev, kk_ssize_t* period) {
+  kk_ssize_t ms = -1;
+  kk_ssize_t j = 0;
+  kk_ssize_t k = 1;
+  kk_ssize_t p = 1;
+  while (j + k < patlen) {
+    const uint8_t a = pat[j + k];
+    const uint8_t b = pat[ms + k];
+    if (rev ? (a > b) : (a < b)) {
+      j += k; k = 1; p = j - ms;
+    }
+    else if (a == b) {
+      if (k != p) { k++; }
+               else { j += p; k = 1; }
+    }
+    else {
+      ms = j; j = ms + 1; k = 1; p = 1;
+    }
+  }
+  *period = p;
+  return ms;
+}
+
+// Two-way search: worst-case linear and constant space, unlike the naive
+// quadratic scan this replaced (periodic patterns on periodic text).
+static const uint8_t* kk_find_twoway(const uint8_t* s, kk_ssize_t slen, const uint8_t* pat, kk_ssize_t patlen) {
+  if (patlen > slen) return NULL;
+  // critical factorization: the larger of the maximal suffixes under both orderings
+  kk_ssize_t p1; const kk_ssize_t ms1 = kk_find_maximal_suffix(pat, patlen, false, &p1);
+  kk_ssize_t p2; const kk_ssize_t ms2 = kk_find_maximal_suffix(pat, patlen, true, &p2);
+  const kk_ssize_t ell = (ms1 > ms2 ? ms1 : ms2);
+  kk_ssize_t per = (ms1 > ms2 ? p1 : p2);
+  kk_ssize_t j = 0;
+  if (kk_memcmp(pat, pat + per, ell + 1) == 0) {
+    // periodic pattern: remember the already matched prefix when shifting by the period
+    kk_ssize_t memory = -1;
+    while (j <= slen - patlen) {
+      kk_ssize_t i = (ell > memory ? ell : memory) + 1;
+      while (i < patlen && pat[i] == s[j + i]) { i++; }
+      if (i >= patlen) {
+        i = ell;
+        while (i > memory && pat[i] == s[j + i]) { i--; }
+        if (i <= memory) return (s + j);
+        j += per;
+        memory = patlen - per - 1;
+      }
+      else {
+        j += (i - ell);
+        memory = -1;
+      }
+    }
+  }
+  else {
+    per = (ell + 1 > patlen - ell - 1 ? ell + 1 : patlen - ell - 1) + 1;
+    while (j <= slen - patlen) {
+      kk_ssize_t i = ell + 1;
+      while (i < patlen && pat[i] == s[j + i]) { i++; }
+      if (i >= patlen) {
+        i = ell;
+        while (i >= 0 && pat[i] == s[j + i]) { i--; }
+        if (i < 0) return (s + j);
+        j += per;
+      }
+      else {
+        j += (i - ell);
+      }
+    }
   }
   return NULL;
 }
 
+#if defined(KK_FIND_SSE2)
+static const uint8_t* kk_find_sse2(const uint8_t* s, kk_ssize_t slen, const uint8_t* pat, kk_ssize_t patlen) {
+  const __m128i first = _mm_set1_epi8((char)pat[0]);
+  const __m128i last  = _mm_set1_epi8((char)pat[patlen - 1]);
+  kk_ssize_t i = 0;
+  while (i <= slen - patlen - 15) {
+    const __m128i vf = _mm_loadu_si128((const __m128i*)(s + i));
+    const __m128i vl = _mm_loadu_si128((const __m128i*)(s + i + patlen - 1));
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(vf, first), _mm_cmpeq_epi8(vl, last)));
+    while (mask != 0) {
+      const kk_ssize_t ofs = kk_bits_ctz32(mask);
+      if (kk_memcmp(s + i + ofs + 1, pat + 1, patlen - 2) == 0) return (s + i + ofs);
+      mask &= (mask - 1);  // clear the lowest candidate bit
+    }
+    i += 16;
+  }
+  return kk_find_twoway(s + i, slen - i, pat, patlen);  // fewer than 16 candidate positions left
+}
+#endif
+
+#if defined(KK_FIND_AVX2)
+static kk_target_avx2 const uint8_t* kk_find_avx2(const uint8_t* s, kk_ssize_t slen, const uint8_t* pat, kk_ssize_t patlen) {
+  const __m256i first = _mm256_set1_epi8((char)pat[0]);
+  const __m256i last  = _mm256_set1_epi8((char)pat[patlen - 1]);
+  kk_ssize_t i = 0;
+  while (i <= slen - patlen - 31) {
+    const __m256i vf = _mm256_loadu_si256((const __m256i*)(s + i));
+    const __m256i vl = _mm256_loadu_si256((const __m256i*)(s + i + patlen - 1));
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(vf, first), _mm256_cmpeq_epi8(vl, last)));
+    while (mask != 0) {
+      const kk_ssize_t ofs = kk_bits_ctz32(mask);
+      if (kk_memcmp(s + i + ofs + 1, pat + 1, patlen - 2) == 0) return (s + i + ofs);
+      mask &= (mask - 1);
+    }
+    i += 32;
+  }
+#if defined(KK_FIND_SSE2)
+  return kk_find_sse2(s + i, slen - i, pat, patlen);
+#else
+  return kk_find_twoway(s + i, slen - i, pat, patlen);
+#endif
+}
+#endif
+
+#if defined(KK_FIND_NEON)
+static const uint8_t* kk_find_neon(const uint8_t* s, kk_ssize_t slen, const uint8_t* pat, kk_ssize_t patlen) {
+  const uint8x16_t first = vdupq_n_u8(pat[0]);
+  const uint8x16_t last  = vdupq_n_u8(pat[patlen - 1]);
+  kk_ssize_t i = 0;
+  while (i <= slen - patlen - 15) {
+    const uint8x16_t vf = vld1q_u8(s + i);
+    const uint8x16_t vl = vld1q_u8(s + i + patlen - 1);
+    const uint8x16_t cand = vandq_u8(vceqq_u8(vf, first), vceqq_u8(vl, last));
+    // narrow the byte mask to a nibble mask: 4 bits per candidate byte
+    uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cand), 4)), 0);
+    while (mask != 0) {
+      const kk_ssize_t ofs = kk_bits_ctz64(mask) / 4;
+      if (kk_memcmp(s + i + ofs + 1, pat + 1, patlen - 2) == 0) return (s + i + ofs);
+      mask &= ~(KK_U64(0xF) << (4*ofs));  // clear the whole nibble
+    }
+    i += 16;
+  }
+  return kk_find_twoway(s + i, slen - i, pat, patlen);
+}
+#endif
+
+#if defined(KK_FIND_AVX2) && !defined(__AVX2__)
+typedef const uint8_t* (*kk_find_fun_t)(const uint8_t*, kk_ssize_t, const uint8_t*, kk_ssize_t);
+static kk_find_fun_t kk_find_fun;  // resolved on first use (see `kk_cpu_dispatch` in `bits.h`)
+#endif
+
+const uint8_t* kk_bytes_find(const uint8_t* p, kk_ssize_t plen, const uint8_t* pat, kk_ssize_t patlen) {
+  kk_assert(p != NULL && pat != NULL);
+  if (plen <= 0 || patlen <= 0 || patlen > plen) return NULL;
+  if (patlen == 1) return kk_memchr(p, pat[0], plen);
+#if defined(KK_FIND_AVX2) && defined(__AVX2__)
+  return kk_find_avx2(p, plen, pat, patlen);
+#elif defined(KK_FIND_AVX2)
+  kk_cpu_dispatch(kk_find_fun, KK_CPU_X64_AVX2, &kk_find_avx2, &kk_find_sse2);
+  return kk_find_fun(p, plen, pat, patlen);
+#elif defined(KK_FIND_SSE2)
+  return kk_find_sse2(p, plen, pat, patlen);
+#elif defined(KK_FIND_NEON)
+  return kk_find_neon(p, plen, pat, patlen);
+#else
+  return kk_find_twoway(p, plen, pat, patlen);
+#endif
+}
+
+
+/*--------------------------------------------------------------------------------------------------
+  Compare
+--------------------------------------------------------------------------------------------------*/
+
 int kk_bytes_cmp_borrow(kk_bytes_t b1, kk_bytes_t b2) {
   if (kk_bytes_ptr_eq_borrow(b1, b2)) return 0;
+  if (kk_bytes_is_small_borrow(b1) && kk_bytes_is_small_borrow(b2)) {
+    // equality as a single word compare; ordering still needs the byte-wise
+    // path below as an embedded zero byte orders differently than the padding
+    if (kk_bytes_small_value_borrow(b1) == kk_bytes_small_value_borrow(b2)) return 0;
+  }
   kk_ssize_t len1;
   const uint8_t* s1 = kk_bytes_buf_borrow(b1,&len1);
   kk_ssize_t len2;
@@ -135,21 +408,34 @@ kk_ssize_t kk_decl_pure kk_bytes_count_pattern_borrow(kk_bytes_t b, kk_bytes_t p
   const uint8_t* s   = kk_bytes_buf_borrow(b,&len);
   if (patlen <= 0)  return kk_bytes_len_borrow(b);
   if (patlen > len) return 0;
-  
-  //todo: optimize by doing backward Boyer-Moore? or use forward Knuth-Morris-Pratt?
+
   kk_ssize_t count = 0;
-  const uint8_t* end = s + (len - (patlen - 1));
-  for (const uint8_t* p = s; p < end; p++) {
-    if (kk_memcmp(p, pat, patlen) == 0) {
-      count++;
-      p += (patlen - 1);
-    }    
+  const uint8_t* const end = s + len;
+  for (const uint8_t* p = s; (p = kk_bytes_find(p, end - p, pat, patlen)) != NULL; p += patlen) {
+    count++;
   }
   return count;
 }
 
 
 kk_bytes_t kk_bytes_cat(kk_bytes_t b1, kk_bytes_t b2, kk_context_t* ctx) {
+#ifdef KK_ARCH_LITTLE_ENDIAN
+  if (kk_bytes_is_small_borrow(b1) && kk_bytes_is_small_borrow(b2)) {
+    const kk_ssize_t len1 = kk_bytes_len_borrow(b1);
+    const kk_ssize_t len2 = kk_bytes_len_borrow(b2);
+    if (len1 + len2 <= KK_BYTES_SMALL_MAX) {
+      // compose the result as a single word; the shifted second value keeps its
+      // ending zero and 0xFF padding in place
+      const uint64_t u1 = kk_bytes_small_value_borrow(b1);
+      const uint64_t u2 = kk_bytes_small_value_borrow(b2);
+      kk_bytes_small_t bs = kk_block_alloc_as(struct kk_bytes_small_s, 0, KK_TAG_BYTES_SMALL, ctx);
+      bs->u.buf_value = (len1 == 0 ? u2 : ((u1 & ((KK_U64(1) << (8*len1)) - 1)) | (u2 << (8*len1))));
+      kk_bytes_drop(b1, ctx);
+      kk_bytes_drop(b2, ctx);
+      return kk_datatype_from_base(&bs->_base);
+    }
+  }
+#endif
   kk_ssize_t len1;
   const uint8_t* s1 = kk_bytes_buf_borrow(b1, &len1);
   kk_ssize_t len2;
@@ -410,3 +696,84 @@ bool kk_bytes_contains(kk_bytes_t b, kk_bytes_t sub, kk_context_t* ctx) {
 }
 
 
+
+
+/*--------------------------------------------------------------------------------------------------
+  Bytes builder
+  A single uniquely owned over-allocated bytes block with in-place appends;
+  grows geometrically through `kk_block_realloc` and trims to the exact length
+  on `done`, so encoders avoid the copy-both-sides cost of repeated `kk_bytes_cat`.
+--------------------------------------------------------------------------------------------------*/
+
+#define KK_BYTES_BUILDER_MIN_CAPACITY  (64)
+
+void kk_bytes_builder_init(kk_bytes_builder_t* bb) {
+  bb->bytes = kk_bytes_empty();
+  bb->len = 0;
+}
+
+static kk_ssize_t kk_bytes_builder_capacity_(const kk_bytes_builder_t* bb) {
+  if (!kk_datatype_has_tag(bb->bytes, KK_TAG_BYTES)) return 0;  // still the empty singleton
+  return kk_datatype_as_assert(kk_bytes_normal_t, bb->bytes, KK_TAG_BYTES)->length;
+}
+
+// Ensure room for `extra` more bytes and return the raw write position.
+// (the position is invalidated by any further reserve or append!)
+uint8_t* kk_bytes_builder_reserve(kk_bytes_builder_t* bb, kk_ssize_t extra, kk_context_t* ctx) {
+  if (extra < 0) extra = 0;
+  const kk_ssize_t needed = bb->len + extra;
+  const kk_ssize_t capacity = kk_bytes_builder_capacity_(bb);
+  if (needed > capacity || capacity == 0) {
+    kk_ssize_t newcap = (capacity <= 0 ? KK_BYTES_BUILDER_MIN_CAPACITY : 2*capacity);
+    while (newcap < needed) { newcap *= 2; }
+    if (capacity == 0) {
+      bb->bytes = kk_bytes_alloc_buf(newcap, NULL, ctx);
+    }
+    else {
+      // the builder owns the block uniquely so we can realloc in place
+      kk_assert_internal(kk_datatype_is_unique(bb->bytes));
+      kk_bytes_normal_t nb = kk_datatype_as_assert(kk_bytes_normal_t, bb->bytes, KK_TAG_BYTES);
+      nb = (kk_bytes_normal_t)kk_block_realloc(&nb->_base._block, kk_ssizeof(struct kk_bytes_normal_s) - 1 + newcap + 1, ctx);
+      nb->length = newcap;
+      bb->bytes = kk_datatype_from_base(&nb->_base);
+    }
+  }
+  kk_bytes_normal_t nb = kk_datatype_as_assert(kk_bytes_normal_t, bb->bytes, KK_TAG_BYTES);
+  return &nb->buf[bb->len];
+}
+
+void kk_bytes_builder_append_buf(kk_bytes_builder_t* bb, const uint8_t* p, kk_ssize_t len, kk_context_t* ctx) {
+  if (p == NULL || len <= 0) return;
+  uint8_t* q = kk_bytes_builder_reserve(bb, len, ctx);
+  kk_memcpy(q, p, len);
+  bb->len += len;
+}
+
+void kk_bytes_builder_clear(kk_bytes_builder_t* bb, kk_context_t* ctx) {
+  kk_bytes_drop(bb->bytes, ctx);
+  kk_bytes_builder_init(bb);
+}
+
+kk_bytes_t kk_bytes_builder_done(kk_bytes_builder_t* bb, kk_context_t* ctx) {
+  kk_bytes_t b;
+  const kk_ssize_t len = bb->len;
+  const kk_ssize_t capacity = kk_bytes_builder_capacity_(bb);
+  kk_assert_internal(len <= capacity);
+  if (len <= 0 || len > capacity) {
+    kk_bytes_drop(bb->bytes, ctx);
+    b = kk_bytes_empty();
+  }
+  else {
+    kk_bytes_normal_t nb = kk_datatype_as_assert(kk_bytes_normal_t, bb->bytes, KK_TAG_BYTES);
+    if (3*(capacity/4) >= len) {
+      // release the slack when under 75% full (just as `kk_bytes_adjust_length`)
+      nb = (kk_bytes_normal_t)kk_block_realloc(&nb->_base._block, kk_ssizeof(struct kk_bytes_normal_s) - 1 + len + 1, ctx);
+    }
+    nb->length = len;
+    kk_atomic_store_relaxed(&nb->count, 0);
+    nb->buf[len] = 0;
+    b = kk_datatype_from_base(&nb->_base);
+  }
+  kk_bytes_builder_init(bb);
+  return b;
+}
@@ -133,6 +133,307 @@ void kk_info_message(const char* fmt, ...) {
   va_end(args);
 }
 
+/*--------------------------------------------------------------------------------------------------
+  Runtime statistics (the counters are only updated when compiled with `-DKK_STATS`)
+--------------------------------------------------------------------------------------------------*/
+
+void kk_stats_snapshot( kk_stats_t* stats, kk_context_t* ctx ) {
+  *stats = ctx->stats;
+}
+
+void kk_stats_print( kk_context_t* ctx ) {
+  const kk_stats_t* s = &ctx->stats;
+#ifndef KK_STATS
+  kk_info_message("stats: compile with -DKK_STATS to enable the runtime counters\n");
+#endif
+  kk_info_message("stats: allocated: %" PRId64 " blocks, %" PRId64 " bytes\n", s->block_allocs, s->block_alloc_bytes);
+  kk_info_message("stats: dup/drop : %" PRId64 "/%" PRId64 " thread-local, %" PRId64 "/%" PRId64 " atomic\n",
+                   s->dups, s->drops, s->dups_atomic, s->drops_atomic);
+  kk_info_message("stats: huge     : %" PRId64 " large allocations advised, %" PRId64 " bytes\n", s->huge_allocs, s->huge_alloc_bytes);
+  kk_info_message("stats: handlers : %" PRId64 " evidence inserts\n", s->evv_inserts);
+  kk_info_message("stats: tasks    : %" PRId64 " enqueued\n", s->task_enqueues);
+}
+
+/*--------------------------------------------------------------------------------------------------
+  Heap census (the per-tag live counters are only updated when compiled with `-DKK_HEAP_CENSUS`;
+  see `kk_census_alloc`/`kk_census_free` in `kklib.h` for the counter updates)
+--------------------------------------------------------------------------------------------------*/
+
+#ifdef KK_HEAP_CENSUS
+_Atomic(int64_t) kk_census_count[KK_CENSUS_BUCKETS];
+_Atomic(int64_t) kk_census_bytes[KK_CENSUS_BUCKETS];
+#endif
+
+static const char* kk_census_special_name[KK_TAG_LAST - KK_TAG_OPEN] = {
+  "open", "box", "box-any", "ref", "function", "bigint",
+  "bytes-small", "bytes", "bytes-view", "vector", "vector-int64", "vector-float64",
+  "vector-view", "pvec", "int64", "double", "int32", "float", "int16",
+  "cfunptr", "intptr", "evv-vector", "nothing", "just", "cptr-raw", "bytes-raw"
+};
+
+void kk_heap_census(kk_census_entry_t census[KK_CENSUS_BUCKETS], kk_context_t* ctx) {
+  kk_unused(ctx);
+#ifdef KK_HEAP_CENSUS
+  for (kk_ssize_t i = 0; i < KK_CENSUS_BUCKETS; i++) {
+    census[i].count = kk_atomic_load_relaxed(&kk_census_count[i]);
+    census[i].bytes = kk_atomic_load_relaxed(&kk_census_bytes[i]);
+  }
+#else
+  memset(census, 0, KK_CENSUS_BUCKETS*sizeof(kk_census_entry_t));
+#endif
+}
+
+void kk_heap_census_print(kk_context_t* ctx) {
+#ifndef KK_HEAP_CENSUS
+  kk_info_message("census: compile with -DKK_HEAP_CENSUS to enable the live heap counters\n");
+#endif
+  kk_census_entry_t census[KK_CENSUS_BUCKETS];
+  kk_heap_census(census, ctx);
+  int64_t total_count = 0;
+  int64_t total_bytes = 0;
+  for (kk_ssize_t i = 0; i < KK_CENSUS_BUCKETS; i++) {
+    if (census[i].count == 0 && census[i].bytes == 0) continue;  // only print tags that are (or were) in use
+    total_count += census[i].count;
+    total_bytes += census[i].bytes;
+    char tagname[32];
+    if (i < KK_CENSUS_CTOR_TAGS - 1)       { snprintf(tagname, sizeof(tagname), "tag %d", (int)i); }
+    else if (i == KK_CENSUS_CTOR_TAGS - 1) { snprintf(tagname, sizeof(tagname), "tag %d+", (int)i); }
+    else { snprintf(tagname, sizeof(tagname), "%s", kk_census_special_name[i - KK_CENSUS_CTOR_TAGS]); }
+    kk_info_message("census: %-14s: %10" PRId64 " blocks, %12" PRId64 " bytes\n", tagname, census[i].count, census[i].bytes);
+  }
+  kk_info_message("census: %-14s: %10" PRId64 " blocks, %12" PRId64 " bytes\n", "live total", total_count, total_bytes);
+}
+
+// Periodic census dump: a single detached thread that prints the census every
+// `millisecs`. A new interval takes effect after the current sleep; an interval
+// of zero (or negative) lets the thread exit after its sleep.
+#ifndef WIN32
+#include <pthread.h>
+#include <time.h>
+#endif
+
+static _Atomic(int64_t) kk_census_dump_msecs;  // current dump interval; 0 when no dump is active
+
+static void kk_census_dump_loop(void) {
+  int64_t msecs;
+  while ((msecs = kk_atomic_load_relaxed(&kk_census_dump_msecs)) > 0) {
+#ifdef WIN32
+    Sleep((DWORD)msecs);
+#else
+    struct timespec ts;
+    ts.tv_sec  = (time_t)(msecs / 1000);
+    ts.tv_nsec = (long)((msecs % 1000) * 1000000);
+    nanosleep(&ts, NULL);
+#endif
+    if (kk_atomic_load_relaxed(&kk_census_dump_msecs) <= 0) break;  // stopped during the sleep
+    kk_heap_census_print(kk_get_context());
+  }
+}
+
+#ifdef WIN32
+static DWORD WINAPI kk_census_dump_thread(LPVOID arg) {
+  kk_unused(arg);
+  kk_census_dump_loop();
+  return 0;
+}
+#else
+static void* kk_census_dump_thread(void* arg) {
+  kk_unused(arg);
+  kk_census_dump_loop();
+  return NULL;
+}
+#endif
+
+void kk_heap_census_dump_every(int64_t millisecs, kk_context_t* ctx) {
+  kk_unused(ctx);
+  const int64_t prev = kk_atomic_load_relaxed(&kk_census_dump_msecs);
+  kk_atomic_store_relaxed(&kk_census_dump_msecs, (millisecs > 0 ? millisecs : 0));
+  if (millisecs <= 0 || prev > 0) return;  // stopped, or the running thread picks up the new interval
+#ifdef WIN32
+  HANDLE th = CreateThread(NULL, 0, &kk_census_dump_thread, NULL, 0, NULL);
+  if (th != NULL) { CloseHandle(th); }
+  else { kk_atomic_store_relaxed(&kk_census_dump_msecs, 0); }
+#else
+  pthread_t th;
+  if (pthread_create(&th, NULL, &kk_census_dump_thread, NULL) == 0) { pthread_detach(th); }
+  else { kk_atomic_store_relaxed(&kk_census_dump_msecs, 0); }
+#endif
+}
+
+/*--------------------------------------------------------------------------------------------------
+  Runtime cpu feature detection (see `bits.h` for the flags and the dispatch helper)
+--------------------------------------------------------------------------------------------------*/
+
+uint32_t kk_cpu_features = 0;
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#if defined(_MSC_VER)
+static void kk_cpuidex(int32_t info[4], int32_t leaf, int32_t subleaf) {
+  __cpuidex(info, leaf, subleaf);
+}
+static uint64_t kk_xgetbv0(void) {
+  return _xgetbv(0);
+}
+#else
+#include <cpuid.h>
+static void kk_cpuidex(int32_t info[4], int32_t leaf, int32_t subleaf) {
+  uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+  __get_cpuid_count((uint32_t)leaf, (uint32_t)subleaf, &eax, &ebx, &ecx, &edx);
+  info[0] = (int32_t)eax; info[1] = (int32_t)ebx; info[2] = (int32_t)ecx; info[3] = (int32_t)edx;
+}
+static uint64_t kk_xgetbv0(void) {
+  uint32_t lo, hi;
+  __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return (((uint64_t)hi << 32) | lo);
+}
+#endif
+
+static void kk_cpu_features_detect(void) {
+  int32_t info[4];
+  kk_cpuidex(info, 0, 0);
+  const int32_t max_leaf = info[0];
+  if (max_leaf < 1) return;
+  kk_cpuidex(info, 1, 0);
+  const uint32_t ecx1 = (uint32_t)info[2];
+  if ((ecx1 & (KK_U32(1)<<9))  != 0) { kk_cpu_features |= KK_CPU_X64_SSSE3; }
+  if ((ecx1 & (KK_U32(1)<<20)) != 0) { kk_cpu_features |= KK_CPU_X64_SSE42; }
+  // avx needs os support for the extended register state (osxsave and xcr0)
+  const bool osxsave = ((ecx1 & (KK_U32(1)<<27)) != 0);
+  const uint64_t xcr0 = (osxsave ? kk_xgetbv0() : 0);
+  const bool avx_os    = ((xcr0 & 0x06) == 0x06);  // xmm and ymm state
+  const bool avx512_os = ((xcr0 & 0xE6) == 0xE6);  // plus opmask and zmm state
+  if (avx_os && (ecx1 & (KK_U32(1)<<28)) != 0) { kk_cpu_features |= KK_CPU_X64_AVX; }
+  if (max_leaf >= 7) {
+    kk_cpuidex(info, 7, 0);
+    const uint32_t ebx7 = (uint32_t)info[1];
+    if ((ebx7 & (KK_U32(1)<<8)) != 0)           { kk_cpu_features |= KK_CPU_X64_BMI2; }
+    if (avx_os && (ebx7 & (KK_U32(1)<<5)) != 0) { kk_cpu_features |= KK_CPU_X64_AVX2; }
+    if (avx512_os && (ebx7 & (KK_U32(1)<<16)) != 0   // avx512f
+                  && (ebx7 & (KK_U32(1)<<30)) != 0   // avx512bw
+                  && (ebx7 & (KK_U32(1)<<31)) != 0)  // avx512vl
+    {
+      kk_cpu_features |= KK_CPU_X64_AVX512BW;
+    }
+  }
+}
+
+#elif defined(__aarch64__) || defined(_M_ARM64)
+static void kk_cpu_features_detect(void) {
+  kk_cpu_features |= KK_CPU_ARM_NEON;  // always available on aarch64
+}
+
+#elif defined(__arm__) && defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+static void kk_cpu_features_detect(void) {
+  if ((getauxval(AT_HWCAP) & HWCAP_NEON) != 0) { kk_cpu_features |= KK_CPU_ARM_NEON; }
+}
+
+#else
+static void kk_cpu_features_detect(void) { }
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------
+  Context recycling pool
+  Building a context from scratch (evidence vector, box-any block, random
+  state) shows up when an embedding spins up short-lived threads constantly.
+  On thread exit a clean context is reset and parked on a small free-list and
+  `kk_get_context` takes from it, making thread onboarding O(1). With mimalloc
+  the context lives in its own thread-local heap and is torn down with it
+  instead (heaps cannot move between threads), which is already cheap there.
+--------------------------------------------------------------------------------------------------*/
+
+// Fully tear down a context (also used when draining the recycling pool at process exit).
+static void kk_context_teardown(kk_context_t* ctx) {
+  kk_hazard_slot_release(ctx);
+#ifdef KK_MIMALLOC
+  mi_heap_t* heap = ctx->heap;
+#endif
+  kk_block_drop(ctx->evv, ctx);
+  if (ctx->kk_box_any != NULL) { kk_basetype_free(ctx->kk_box_any, ctx); }
+  // kk_basetype_drop_assert(ctx->kk_box_any, KK_TAG_BOX_ANY, ctx);
+  kk_deferred_reclaim(-1, ctx);  // free any pending drop cascades
+  kk_rc_bias_flush(ctx);         // return banked references to thread-shared blocks
+  kk_reuse_cache_clear(ctx);     // free any blocks retained for reuse
+  if (ctx->arena.chunks != NULL) { kk_arena_end(ctx); }  // release a leftover arena phase
+#ifdef KK_MIMALLOC
+  mi_free(ctx);
+  mi_heap_delete(heap);  // blocks still live (thread-shared) migrate to the default heap
+#else
+  kk_free(ctx,ctx);
+#endif
+}
+
+#ifndef KK_MIMALLOC
+#define KK_CONTEXT_POOL_MAX  (64)
+
+static _Atomic(int32_t)  context_pool_lock;  // 0 = free (tiny spinlock; pool operations are O(1))
+static kk_context_t*     context_pool;       // parked contexts, linked through `pool_next`
+static kk_ssize_t        context_pool_size;
+
+static void kk_context_pool_acquire(void) {
+  int32_t expected = 0;
+  while (!kk_atomic_cas_weak_acq_rel(&context_pool_lock, &expected, 1)) { expected = 0; }
+}
+
+static void kk_context_pool_release(void) {
+  kk_atomic_store_release(&context_pool_lock, 0);
+}
+
+static kk_context_t* kk_context_pool_pop(void) {
+  kk_context_pool_acquire();
+  kk_context_t* ctx = context_pool;
+  if (ctx != NULL) {
+    context_pool = ctx->pool_next;
+    context_pool_size--;
+  }
+  kk_context_pool_release();
+  return ctx;
+}
+
+// Park a context for reuse by a future thread; returns `false` when the pool
+// is full or the context did not exit cleanly (so it is torn down instead).
+static bool kk_context_pool_push(kk_context_t* ctx) {
+  if (ctx->yielding != 0 || ctx->evv != kk_evv_empty_singleton) return false;
+  if (context_pool_size >= KK_CONTEXT_POOL_MAX) return false;  // racy read; the bound is approximate
+  // reset to a fresh state: pending frees are flushed while the blocks that
+  // make reuse cheap (the reuse cache, box-any, strong random state) stay
+  kk_deferred_reclaim(-1, ctx);
+  ctx->deferred_reclaim = false;
+  kk_rc_bias_flush(ctx);
+  if (ctx->arena.chunks != NULL) { kk_arena_end(ctx); }
+  kk_integer_drop(ctx->unique, ctx);
+  ctx->unique = kk_integer_one;
+  ctx->marker_unique = 0;
+  memset(ctx->evv_cache, 0, sizeof(ctx->evv_cache));  // block addresses may recycle across threads
+  memset(&ctx->stats, 0, sizeof(ctx->stats));
+  ctx->task_group = NULL;
+  ctx->heap_escaped = false;
+  ctx->argc = 0;
+  ctx->argv = NULL;
+  ctx->process_start = 0;
+  kk_context_pool_acquire();
+  if (context_pool_size >= KK_CONTEXT_POOL_MAX) {
+    kk_context_pool_release();
+    return false;
+  }
+  ctx->pool_next = context_pool;
+  context_pool = ctx;
+  context_pool_size++;
+  kk_context_pool_release();
+  return true;
+}
+
+static void kk_context_pool_drain(void) {
+  kk_context_t* ctx = kk_context_pool_pop();
+  while (ctx != NULL) {
+    kk_context_teardown(ctx);
+    ctx = kk_context_pool_pop();
+  }
+}
+#endif
+
 /*--------------------------------------------------------------------------------------------------
   Process init/done
 --------------------------------------------------------------------------------------------------*/
@@ -141,6 +442,9 @@ static bool process_initialized; // = false
 static void kklib_done(void) {
   if (!process_initialized) return;
   kk_free_context();
+#ifndef KK_MIMALLOC
+  kk_context_pool_drain();
+#endif
   process_initialized = false;
 }
 
@@ -174,7 +478,8 @@ static void kklib_init(void) {
   __cpuid(cpu_info, 7);
   kk_has_tzcnt = ((cpu_info[1] & (KK_I32(1)<<3)) != 0);    // bmi1: https://en.wikipedia.org/wiki/X86_Bit_manipulation_instruction_set
 #endif
-  atexit(&kklib_done);  
+  kk_cpu_features_detect();
+  atexit(&kklib_done);
 }
 
 /*--------------------------------------------------------------------------------------------------
@@ -195,8 +500,22 @@ kk_context_t* kk_get_context(void) {
   kk_context_t* ctx = context;
   if (ctx!=NULL) return ctx;
   kklib_init();
+#ifndef KK_MIMALLOC
+  ctx = kk_context_pool_pop();
+  if (ctx != NULL) {
+    // recycle a parked context: O(1) onboarding for short-lived threads
+    ctx->thread_id = (size_t)(&context);
+    kk_prandom_init(&ctx->prandom, 0, 0);  // the same fixed stream a fresh context gets
+    context = ctx;
+    return ctx;
+  }
+#endif
 #ifdef KK_MIMALLOC
-  mi_heap_t* heap = mi_heap_get_default(); //  mi_heap_new();
+  // give each context its own heap: as long as nothing in it is ever marked
+  // thread-shared (`heap_escaped` stays clear) the whole heap -- including the
+  // context itself -- can be torn down in one sweep in `kk_free_context`
+  mi_heap_t* heap = mi_heap_new();
+  if (heap == NULL) { heap = mi_heap_get_default(); }
   ctx = (kk_context_t*)mi_heap_zalloc(heap, sizeof(kk_context_t));
   ctx->heap = heap;
 #else
@@ -205,30 +524,172 @@ kk_context_t* kk_get_context(void) {
   ctx->evv = kk_block_dup(kk_evv_empty_singleton);
   ctx->thread_id = (size_t)(&context);
   ctx->unique = kk_integer_one;
+  kk_prandom_init(&ctx->prandom, 0, 0);  // fixed default seed for reproducible runs; tasks split off their own stream
   context = ctx;
-  ctx->kk_box_any = kk_block_alloc_as(struct kk_box_any_s, 0, KK_TAG_BOX_ANY, ctx);  
-  ctx->kk_box_any->_unused = kk_integer_zero;
+  // the box-any block and the strong random state are allocated on first use
+  // (`kk_box_any_init`, `kk_srandom_round`): build tools invoke compiled
+  // programs thousands of times and most never yield or touch OS entropy.
   // todo: register a thread_done function to release the context on thread terminatation.
   return ctx;
 }
 
+// Lazily allocate the box-any block (see `kk_box_any` in `box.h`).
+kk_decl_export void kk_box_any_init(kk_context_t* ctx) {
+  kk_assert_internal(ctx->kk_box_any == NULL);
+  ctx->kk_box_any = kk_block_alloc_as(struct kk_box_any_s, 0, KK_TAG_BOX_ANY, ctx);
+  ctx->kk_box_any->_unused = kk_integer_zero;
+}
+
 void kk_free_context(void) {
   if (context != NULL) {
-    kk_block_drop(context->evv, context);
-    kk_basetype_free(context->kk_box_any,context);
-    // kk_basetype_drop_assert(context->kk_box_any, KK_TAG_BOX_ANY, context);
-    // TODO: process delayed_free
 #ifdef KK_MIMALLOC
-    // mi_heap_t* heap = context->heap;
-    mi_free(context);
-    // mi_heap_delete(heap);
+    mi_heap_t* heap = context->heap;
+    if (!context->heap_escaped && heap != mi_heap_get_default()) {
+      // nothing in this heap was ever marked thread-shared and no thread-shared
+      // block was ever referenced from it: every allocation -- pending drop
+      // cascades, the reuse cache, and the context itself -- is owned here, so
+      // release them all in one sweep (O(1) teardown for short-lived contexts)
+      kk_hazard_slot_release(context);
+      context = NULL;
+      mi_heap_destroy(heap);
+      return;
+    }
 #else
-    kk_free(context,context);
+    // park the context for reuse by a future thread; its heap state, reuse
+    // cache and hazard slot stay with it
+    if (kk_context_pool_push(context)) {
+      context = NULL;
+      return;
+    }
 #endif
+    kk_context_teardown(context);
     context = NULL;
   }
 }
 
+/*--------------------------------------------------------------------------------------------------
+  Sampling profiler: a `SIGPROF` timer samples the per-context function marker
+  (see the profile section in `kklib.h`; the markers are only maintained with `-DKK_PROFILE`).
+  Samples land in a fixed open-addressed table keyed on the marker pointer so the
+  signal handler only does relaxed atomic loads, adds, and compare-and-swaps.
+--------------------------------------------------------------------------------------------------*/
+
+#ifndef WIN32
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+#define KK_PROFILE_SLOTS  (1024)   // power of two
+
+typedef struct kk_profile_slot_s {
+  _Atomic(const char*) name;
+  _Atomic(int64_t)     hits;        // samples taken while executing normally
+  _Atomic(int64_t)     yield_hits;  // samples taken while yielding to a handler
+} kk_profile_slot_t;
+
+static kk_profile_slot_t kk_profile_slots[KK_PROFILE_SLOTS];
+static _Atomic(int64_t)  kk_profile_total;   // all samples taken
+static _Atomic(int64_t)  kk_profile_lost;    // samples dropped on a full table
+
+static const char* kk_profile_no_marker = "<no marker>";  // runtime- or foreign code, or compiled without -DKK_PROFILE
+
+// Async-signal safe: reads the tls context directly (never allocates one) and
+// touches only the preallocated atomic slots.
+static void kk_profile_sample(int sig) {
+  kk_unused(sig);
+  kk_context_t* ctx = context;
+  if (ctx == NULL) return;
+  const bool in_yield = (ctx->yielding != KK_YIELD_NONE);
+  const char* name = (in_yield ? kk_atomic_load_relaxed(&ctx->profile_yield_fun)
+                               : kk_atomic_load_relaxed(&ctx->profile_fun));
+  if (name == NULL) { name = kk_profile_no_marker; }
+  kk_atomic_inc_relaxed(&kk_profile_total);
+  size_t i = ((((uintptr_t)name) >> 4) * KK_U64(2654435761)) & (KK_PROFILE_SLOTS - 1);
+  for (size_t probes = 0; probes < KK_PROFILE_SLOTS; probes++, i = ((i + 1) & (KK_PROFILE_SLOTS - 1))) {
+    const char* slot_name = kk_atomic_load_relaxed(&kk_profile_slots[i].name);
+    if (slot_name == NULL) {
+      if (!kk_atomic_cas_strong_relaxed(&kk_profile_slots[i].name, &slot_name, name)) {
+        if (slot_name != name) continue;  // another sample claimed the slot for a different function
+      }
+    }
+    else if (slot_name != name) continue;
+    kk_atomic_inc_relaxed(in_yield ? &kk_profile_slots[i].yield_hits : &kk_profile_slots[i].hits);
+    return;
+  }
+  kk_atomic_inc_relaxed(&kk_profile_lost);
+}
+
+bool kk_profile_start(int64_t hz, kk_context_t* ctx) {
+  kk_unused(ctx);
+#ifdef WIN32
+  kk_unused(hz);
+  return false;  // no profiling timer on windows (yet)
+#else
+  kk_profile_stop(ctx);
+  for (size_t i = 0; i < KK_PROFILE_SLOTS; i++) {
+    kk_atomic_store_relaxed(&kk_profile_slots[i].name, (const char*)NULL);
+    kk_atomic_store_relaxed(&kk_profile_slots[i].hits, KK_I64(0));
+    kk_atomic_store_relaxed(&kk_profile_slots[i].yield_hits, KK_I64(0));
+  }
+  kk_atomic_store_relaxed(&kk_profile_total, KK_I64(0));
+  kk_atomic_store_relaxed(&kk_profile_lost, KK_I64(0));
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = &kk_profile_sample;
+  sigemptyset(&sa.sa_mask);
+  sa.sa_flags = SA_RESTART;
+  if (sigaction(SIGPROF, &sa, NULL) != 0) return false;
+  if (hz <= 0) { hz = 100; }
+  else if (hz > 10000) { hz = 10000; }
+  struct itimerval tv;
+  tv.it_interval.tv_sec  = 0;
+  tv.it_interval.tv_usec = (suseconds_t)(1000000 / hz);
+  tv.it_value = tv.it_interval;
+  return (setitimer(ITIMER_PROF, &tv, NULL) == 0);
+#endif
+}
+
+void kk_profile_stop(kk_context_t* ctx) {
+  kk_unused(ctx);
+#ifndef WIN32
+  struct itimerval tv;
+  memset(&tv, 0, sizeof(tv));
+  setitimer(ITIMER_PROF, &tv, NULL);  // the handler stays installed; pending signals are harmless
+#endif
+}
+
+void kk_profile_print(kk_context_t* ctx) {
+  kk_unused(ctx);
+#ifndef KK_PROFILE
+  kk_info_message("profile: compile with -DKK_PROFILE to attribute samples to koka functions\n");
+#endif
+  const int64_t total = kk_atomic_load_relaxed(&kk_profile_total);
+  // collect and sort the used slots on total hits (at most KK_PROFILE_SLOTS entries)
+  kk_profile_slot_t* used[KK_PROFILE_SLOTS];
+  kk_ssize_t n = 0;
+  for (kk_ssize_t i = 0; i < KK_PROFILE_SLOTS; i++) {
+    if (kk_atomic_load_relaxed(&kk_profile_slots[i].name) == NULL) continue;
+    kk_profile_slot_t* s = &kk_profile_slots[i];
+    const int64_t shits = kk_atomic_load_relaxed(&s->hits) + kk_atomic_load_relaxed(&s->yield_hits);
+    kk_ssize_t j = n++;
+    while (j > 0) {
+      kk_profile_slot_t* p = used[j-1];
+      if (kk_atomic_load_relaxed(&p->hits) + kk_atomic_load_relaxed(&p->yield_hits) >= shits) break;
+      used[j] = p; j--;
+    }
+    used[j] = s;
+  }
+  for (kk_ssize_t i = 0; i < n; i++) {
+    const int64_t hits  = kk_atomic_load_relaxed(&used[i]->hits);
+    const int64_t yhits = kk_atomic_load_relaxed(&used[i]->yield_hits);
+    kk_info_message("profile: %6.2f%% %8" PRId64 " samples (%" PRId64 " in yield): %s\n",
+                    (total > 0 ? 100.0 * (double)(hits + yhits) / (double)total : 0.0),
+                    hits + yhits, yhits, kk_atomic_load_relaxed(&used[i]->name));
+  }
+  kk_info_message("profile: total %" PRId64 " samples (%" PRId64 " lost)\n",
+                  total, kk_atomic_load_relaxed(&kk_profile_lost));
+}
+
 /*--------------------------------------------------------------------------------------------------
   Called from main
 --------------------------------------------------------------------------------------------------*/
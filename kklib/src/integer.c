@@ -275,9 +275,13 @@ static kk_bigint_t* kk_bigint_trim(kk_bigint_t* x, bool allow_realloc, kk_contex
   return kk_bigint_trim_to(x, i, allow_realloc, ctx);
 }
 
-static kk_bigint_t* bigint_alloc_reuse_(kk_bigint_t* x, kk_ssize_t count, kk_context_t* ctx) {
+static bool bigint_can_reuse_(kk_bigint_t* x, kk_ssize_t count) {
   kk_ssize_t d = (bigint_available_(x) - count);
-  if (d >= 0 && d <= MAX_EXTRA && bigint_is_unique_(x)) {   // reuse?
+  return (d >= 0 && d <= MAX_EXTRA && bigint_is_unique_(x));
+}
+
+static kk_bigint_t* bigint_alloc_reuse_(kk_bigint_t* x, kk_ssize_t count, kk_context_t* ctx) {
+  if (bigint_can_reuse_(x, count)) {
     return kk_bigint_trim_to(x, count, false /* no realloc */, ctx);
   }
   else {
@@ -285,6 +289,22 @@ static kk_bigint_t* bigint_alloc_reuse_(kk_bigint_t* x, kk_ssize_t count, kk_con
   }
 }
 
+// Reuse `x` if possible, and otherwise `y` (for in-place addition/subtraction where
+// either operand may be the unique accumulator); allocates fresh as a last resort.
+static kk_bigint_t* bigint_alloc_reuse2_(kk_bigint_t* x, kk_bigint_t* y, kk_ssize_t count, kk_context_t* ctx) {
+  if (bigint_can_reuse_(x, count)) {
+    return kk_bigint_trim_to(x, count, false /* no realloc */, ctx);
+  }
+  else if (bigint_can_reuse_(y, count)) {
+    kk_bigint_t* z = kk_bigint_trim_to(y, count, false /* no realloc */, ctx);
+    z->is_neg = x->is_neg;
+    return z;
+  }
+  else {
+    return bigint_alloc(count, bigint_is_neg_(x), ctx);
+  }
+}
+
 static kk_bigint_t* bigint_copy(kk_bigint_t* x, kk_ssize_t extra, kk_context_t* ctx) {
   kk_assert_internal(extra <= MAX_EXTRA);
   if (extra > MAX_EXTRA) extra = MAX_EXTRA;
@@ -515,6 +535,27 @@ static kk_string_t kk_int_to_string(kk_intx_t n, kk_context_t* ctx) {
 /*----------------------------------------------------------------------
   Parse an integer
 ----------------------------------------------------------------------*/
+
+// Parse 8 ascii digits at once: swar validation and multiply-add conversion
+// (as in Lemire's `fast_float`). Returns `false` if not all 8 bytes are digits.
+static bool kk_parse_digits8(const char* p, uint32_t* v) {
+  uint64_t w;
+  kk_memcpy(&w, p, 8);
+#if defined(KK_ARCH_BIG_ENDIAN)
+  w = kk_bits_bswap64(w);
+#endif
+  if (((w & KK_U64(0xF0F0F0F0F0F0F0F0)) |
+       (((w + KK_U64(0x0606060606060606)) & KK_U64(0xF0F0F0F0F0F0F0F0)) >> 4)) != KK_U64(0x3333333333333333)) {
+    return false;
+  }
+  w -= KK_U64(0x3030303030303030);
+  w = (w * 2561) >> 8;                                         // pairs of digits
+  w = ((w & KK_U64(0x00FF00FF00FF00FF)) * 6553601) >> 16;      // groups of four
+  w = ((w & KK_U64(0x0000FFFF0000FFFF)) * KK_U64(42949672960001)) >> 32;  // all eight
+  *v = (uint32_t)w;
+  return true;
+}
+
 kk_decl_export bool kk_integer_parse(const char* s, kk_integer_t* res, kk_context_t* ctx) {
   kk_assert_internal(s!=NULL && res != NULL);
   if (res==NULL) return false;
@@ -532,6 +573,27 @@ kk_decl_export bool kk_integer_parse(const char* s, kk_integer_t* res, kk_contex
     return kk_integer_hex_parse(s, res, ctx);
   }
   if (!kk_ascii_is_digit(s[i])) return false;  // must start with a digit
+  // fast path: a plain digit run that fits a machine integer (the common case for
+  // csv-style input). Underscores, fractions, exponents, and bignum-range runs all
+  // fall through to the general parser below.
+  {
+    const kk_ssize_t maxdigits = 18;  // 18 digits always fit an int64_t
+    const kk_ssize_t nleft = kk_sstrlen(s + i);
+    kk_ssize_t n = 0;
+    uint64_t d = 0;
+    uint32_t v;
+    while (nleft - n >= 8 && n < maxdigits && kk_parse_digits8(s + i + n, &v)) {
+      d = (d * 100000000) + v;  // on overrun `d` wraps but is rejected below
+      n += 8;
+    }
+    for (; kk_ascii_is_digit(s[i + n]); n++) {
+      d = (10 * d) + (uint64_t)(s[i + n] - '0');
+    }
+    if (s[i + n] == 0 && n <= maxdigits) {
+      *res = kk_integer_from_int64((is_neg ? -(int64_t)d : (int64_t)d), ctx);
+      return true;
+    }
+  }
   // significant
   for (; s[i] != 0; i++) {
     char c = s[i];
@@ -650,12 +712,175 @@ kk_integer_t kk_integer_from_str(const char* num, kk_context_t* ctx) {
 }
 
 
+/*----------------------------------------------------------------------
+  GMP kernels (KK_USE_GMP, see the CMake option)
+  Optionally route the superlinear operations -- multiplication and
+  division -- through the mpn layer of libgmp whose assembly kernels
+  beat the portable loops below by a wide margin on large counts. The
+  decimal digit representation is kept as is (it is what makes the
+  string conversions fast), so operands are converted to binary limbs
+  at the call boundary and the result is converted back; the small-int
+  fast paths and the `KK_TAG_BIGINT` block wrapping are unaffected.
+  The conversions cost O(n^2/64) with mpn single-limb kernels which is
+  far below the cost of the schoolbook division they replace.
+----------------------------------------------------------------------*/
+
+#if defined(KK_USE_GMP)
+#include <gmp.h>
+#if (GMP_NAIL_BITS != 0)
+#error "the kklib GMP kernels require nail-less limbs"
+#endif
+
+#define KK_GMP_BITS_PER_DIGIT  (DIGIT_BITS==64 ? 60 : 30)  // upper bound on significant bits per decimal digit
+#define KK_GMP_MUL_MIN_COUNT   (16)  // below these counts the native kernels win (conversion overhead)
+#define KK_GMP_DIV_MIN_COUNT   (8)
+
+static kk_ssize_t kk_gmp_limb_estimate(kk_ssize_t count) {
+  return ((count * KK_GMP_BITS_PER_DIGIT) / GMP_NUMB_BITS) + 2;
+}
+
+// Convert the decimal digits to binary limbs; returns the limb count (0 for zero).
+static mp_size_t kk_bigint_to_limbs(const kk_bigint_t* b, mp_ptr rp) {
+  kk_assert_internal(DIGIT_BITS <= GMP_NUMB_BITS);
+  mp_size_t rn = 0;
+  for (kk_ssize_t i = bigint_count_(b); i > 0; i--) {
+    mp_limb_t carry = (rn > 0 ? mpn_mul_1(rp, rp, rn, (mp_limb_t)BASE) : 0);
+    const mp_limb_t d = (mp_limb_t)b->digits[i-1];
+    if (rn > 0)      { carry += mpn_add_1(rp, rp, rn, d); }  // cannot overflow: carry < BASE
+    else if (d != 0) { rp[rn++] = d; continue; }
+    if (carry != 0)  { rp[rn++] = carry; }
+  }
+  return rn;
+}
+
+// Convert binary limbs back to decimal digits (destroys `xp`).
+static kk_bigint_t* kk_bigint_of_limbs(mp_ptr xp, mp_size_t xn, bool is_neg, kk_context_t* ctx) {
+  while (xn > 0 && xp[xn-1] == 0) { xn--; }
+  if (xn == 0) return bigint_from_int(0, ctx);
+  const kk_ssize_t est = (((kk_ssize_t)xn * GMP_NUMB_BITS) / (KK_GMP_BITS_PER_DIGIT - 1)) + 1;  // a digit holds at least 59 (resp 29) bits
+  kk_bigint_t* b = bigint_alloc(est, is_neg, ctx);
+  kk_ssize_t j = 0;
+  while (xn > 0) {
+    const mp_limb_t r = mpn_divrem_1(xp, 0, xp, xn, (mp_limb_t)BASE);
+    while (xn > 0 && xp[xn-1] == 0) { xn--; }
+    b->digits[j++] = (kk_digit_t)r;
+  }
+  kk_assert_internal(j <= est && b->digits[j-1] != 0);
+  return kk_bigint_trim_to(b, j, true, ctx);
+}
+
+static kk_bigint_t* bigint_mul_gmp(kk_bigint_t* x, kk_bigint_t* y, kk_context_t* ctx) {
+  const bool is_neg = (bigint_is_neg_(x) != bigint_is_neg_(y));
+  const kk_ssize_t xlimbs = kk_gmp_limb_estimate(bigint_count_(x));
+  const kk_ssize_t ylimbs = kk_gmp_limb_estimate(bigint_count_(y));
+  mp_ptr xp = (mp_ptr)kk_malloc(2*(xlimbs + ylimbs)*kk_ssizeof(mp_limb_t), ctx);
+  mp_ptr yp = xp + xlimbs;
+  mp_ptr rp = yp + ylimbs;
+  const mp_size_t xn = kk_bigint_to_limbs(x, xp);
+  const mp_size_t yn = kk_bigint_to_limbs(y, yp);
+  drop_bigint(x, ctx);
+  drop_bigint(y, ctx);
+  kk_bigint_t* z;
+  if (xn == 0 || yn == 0) {
+    z = bigint_from_int(0, ctx);
+  }
+  else {
+    if (xn >= yn) { mpn_mul(rp, xp, xn, yp, yn); }
+    else          { mpn_mul(rp, yp, yn, xp, xn); }
+    z = kk_bigint_of_limbs(rp, xn + yn, is_neg, ctx);
+  }
+  kk_free(xp, ctx);
+  return z;
+}
+
+// Truncated division as in `bigint_cdiv_cmod`: the quotient is negative when the
+// signs differ, and the remainder takes the sign of `x`.
+static kk_bigint_t* bigint_cdiv_cmod_gmp(kk_bigint_t* x, kk_bigint_t* y, kk_bigint_t** pmod, kk_context_t* ctx) {
+  const bool q_neg = (bigint_is_neg_(x) != bigint_is_neg_(y));
+  const bool r_neg = bigint_is_neg_(x);
+  const kk_ssize_t xlimbs = kk_gmp_limb_estimate(bigint_count_(x));
+  const kk_ssize_t ylimbs = kk_gmp_limb_estimate(bigint_count_(y));
+  mp_ptr xp = (mp_ptr)kk_malloc((2*xlimbs + 2*ylimbs + 1)*kk_ssizeof(mp_limb_t), ctx);
+  mp_ptr yp = xp + xlimbs;
+  mp_ptr qp = yp + ylimbs;       // xn - yn + 1 quotient limbs
+  mp_ptr rp = qp + xlimbs + 1;   // yn remainder limbs
+  const mp_size_t xn = kk_bigint_to_limbs(x, xp);
+  const mp_size_t yn = kk_bigint_to_limbs(y, yp);
+  drop_bigint(x, ctx);
+  drop_bigint(y, ctx);
+  kk_assert_internal(yn > 0);    // division by zero is excluded by the callers
+  kk_bigint_t* q;
+  if (xn < yn) {  // |x| < |y|
+    q = bigint_from_int(0, ctx);
+    if (pmod != NULL) { *pmod = kk_bigint_of_limbs(xp, xn, r_neg, ctx); }
+  }
+  else {
+    mpn_tdiv_qr(qp, rp, 0, xp, xn, yp, yn);
+    q = kk_bigint_of_limbs(qp, xn - yn + 1, q_neg, ctx);
+    if (pmod != NULL) { *pmod = kk_bigint_of_limbs(rp, yn, r_neg, ctx); }
+  }
+  kk_free(xp, ctx);
+  return q;
+}
+#endif  // KK_USE_GMP
+
+
 /*----------------------------------------------------------------------
   Parse an integer as hexadecimal
 ----------------------------------------------------------------------*/
 
 static kk_bigint_t* kk_bigint_mul_small(kk_bigint_t* x, kk_digit_t y, kk_context_t* ctx);
 static kk_bigint_t* kk_bigint_add_abs_small(kk_bigint_t* x, kk_digit_t y, kk_context_t* ctx);
+static kk_bigint_t* bigint_add(kk_bigint_t* x, kk_bigint_t* y, bool y_isneg, kk_context_t* ctx);
+static kk_bigint_t* bigint_neg(kk_bigint_t* x, kk_context_t* ctx);
+static kk_bigint_t* bigint_mul(kk_bigint_t* x, kk_bigint_t* y, kk_context_t* ctx);
+static kk_bigint_t* bigint_mul_toom3(kk_bigint_t* x, kk_bigint_t* y, kk_context_t* ctx);
+static bool use_karatsuba(kk_ssize_t i, kk_ssize_t j);
+
+static kk_bigint_t* bigint_mul_auto(kk_bigint_t* x, kk_bigint_t* y, kk_context_t* ctx) {
+#if defined(KK_USE_GMP)
+  if (bigint_count_(x) >= KK_GMP_MUL_MIN_COUNT && bigint_count_(y) >= KK_GMP_MUL_MIN_COUNT) {
+    return bigint_mul_gmp(x, y, ctx);
+  }
+#endif
+  return (use_karatsuba(bigint_count_(x), bigint_count_(y)) ? bigint_mul_toom3(x, y, ctx) : bigint_mul(x, y, ctx));
+}
+
+// BASE_HEX^exp through binary exponentiation
+static kk_bigint_t* bigint_base_hex_pow(kk_ssize_t exp, kk_context_t* ctx) {
+  kk_bigint_t* acc = bigint_from_uint64(1, ctx);
+  kk_bigint_t* sq  = bigint_from_uint64(BASE_HEX, ctx);
+  while (exp > 0) {
+    if ((exp & 1) == 1) { acc = bigint_mul_auto(acc, dup_bigint(sq), ctx); }
+    exp >>= 1;
+    if (exp > 0) { sq = bigint_mul_auto(dup_bigint(sq), sq, ctx); }
+  }
+  drop_bigint(sq, ctx);
+  return acc;
+}
+
+#define KK_HEX_PARSE_SMALL  (16)  // below this many chunks use the sequential multiply-add
+
+// Combine `n` hex chunks (each a base BASE_HEX "digit", most significant first) into
+// a bigint by recursive splitting so parsing long hex numbers is subquadratic: the
+// halves combine through a (toom-3) multiplication with a power of BASE_HEX.
+static kk_bigint_t* bigint_from_hex_chunks(const kk_digit_t* chunks, kk_ssize_t n, kk_context_t* ctx) {
+  if (n <= KK_HEX_PARSE_SMALL) {
+    kk_bigint_t* b = bigint_from_uint64(0, ctx);
+    for (kk_ssize_t i = 0; i < n; i++) {
+      b = kk_bigint_mul_small(b, BASE_HEX, ctx);
+      b = kk_bigint_add_abs_small(b, chunks[i], ctx);
+    }
+    return b;
+  }
+  else {
+    const kk_ssize_t nlo = n/2;  // chunks in the low (least significant) part
+    kk_bigint_t* hi = bigint_from_hex_chunks(chunks, n - nlo, ctx);
+    kk_bigint_t* lo = bigint_from_hex_chunks(chunks + (n - nlo), nlo, ctx);
+    hi = bigint_mul_auto(hi, bigint_base_hex_pow(nlo, ctx), ctx);
+    return bigint_add(hi, lo, false /* lo->is_neg */, ctx);
+  }
+}
 
 bool kk_integer_hex_parse(const char* s, kk_integer_t* res, kk_context_t* ctx) {
   kk_assert_internal(s!=NULL && res != NULL);
@@ -708,16 +933,10 @@ bool kk_integer_hex_parse(const char* s, kk_integer_t* res, kk_context_t* ctx) {
     return true;
   }
   
-  // otherwise construct a big int
-  const kk_ssize_t count = (kk_ssize_t)(ceil((double)hdigits * KK_LOG16_DIV_LOG10)) + 1; // conservatively overallocate to max needed.
-  kk_extra_t ecount = (count >= MAX_EXTRA ? MAX_EXTRA-1 : (kk_extra_t)count);
-  kk_bigint_t* b = bigint_alloc(ecount, is_neg, ctx);
-  ecount--;
-  b->extra += ecount;
-  b->count -= ecount;
-  b->digits[0] = 0;
-
-  // create in chucks of LOG_BASE_HEX digits
+  // otherwise construct a big int; first gather chunks of LOG_BASE_HEX digits
+  const kk_ssize_t nchunks = (hdigits + LOG_BASE_HEX - 1) / LOG_BASE_HEX;  // round up
+  kk_digit_t* chunks = (kk_digit_t*)kk_malloc(nchunks * kk_ssizeof(kk_digit_t), ctx);
+  kk_ssize_t k = 0;
   kk_ssize_t chunk = hdigits%LOG_BASE_HEX; if (chunk==0) chunk = LOG_BASE_HEX; // initial number of digits to read
   const char* p = start;
   while (p < end) {
@@ -728,15 +947,18 @@ bool kk_integer_hex_parse(const char* s, kk_integer_t* res, kk_context_t* ctx) {
       if (kk_ascii_is_hexdigit(c)) {
         j++;
         kk_digit_t hd = (kk_digit_t)(kk_ascii_is_digit(c) ? c - '0' : 10 + (kk_ascii_is_lower(c) ? c - 'a' : c - 'A'));
-        d = 16*d + hd; 
+        d = 16*d + hd;
         kk_assert_internal(d<BASE);
       }
     }
-    // and multiply-add
-    b = kk_bigint_mul_small(b, BASE_HEX, ctx);
-    b = kk_bigint_add_abs_small(b, d, ctx);
+    kk_assert_internal(k < nchunks);
+    chunks[k++] = d;
     chunk = LOG_BASE_HEX;  // after the first chunk, the chunk is always a full LOG_BASE_HEX
   }
+  // and combine them by recursive splitting
+  kk_bigint_t* b = bigint_from_hex_chunks(chunks, k, ctx);
+  kk_free(chunks, ctx);
+  if (is_neg) { b = bigint_neg(b, ctx); }
   *res = integer_bigint(b, ctx);
   return true;
 }
@@ -791,7 +1013,7 @@ static kk_bigint_t* bigint_add_abs(kk_bigint_t* x, kk_bigint_t* y, kk_context_t*
 
   // allocate result bigint
   const kk_ssize_t cz = ((bigint_last_digit_(x) + bigint_last_digit_(y) + 1) >= BASE ? cx + 1 : cx);
-  kk_bigint_t* z = bigint_alloc_reuse_(x, cz, ctx); // if z==x, we reused x.
+  kk_bigint_t* z = bigint_alloc_reuse2_(x, y, cz, ctx); // if z==x (or z==y), we reused it in place.
   //z->is_neg = x->is_neg;
 
   kk_assert_internal(cx>=cy);
@@ -840,7 +1062,7 @@ static kk_bigint_t* bigint_add_abs(kk_bigint_t* x, kk_bigint_t* y, kk_context_t*
   }
   kk_assert_internal(i == bigint_count_(z) || i+1 == bigint_count_(z));
   if (z != x) drop_bigint(x,ctx);
-  drop_bigint(y,ctx);
+  if (z != y) drop_bigint(y,ctx);
   return kk_bigint_trim_to(z, i, true /* allow realloc */, ctx);
 }
 
@@ -905,7 +1127,7 @@ static kk_bigint_t* kk_bigint_sub_abs(kk_bigint_t* x, kk_bigint_t* y, kk_context
   kk_ssize_t cx = bigint_count_(x);
   kk_ssize_t cy = bigint_count_(y);
   kk_assert_internal(cx>=cy);
-  kk_bigint_t* z = bigint_alloc_reuse_(x, cx, ctx);
+  kk_bigint_t* z = bigint_alloc_reuse2_(x, y, cx, ctx);
   //z->is_neg = x->is_neg;
   kk_assert_internal(bigint_count_(z) >= cx);
   kk_digit_t borrow = 0;
@@ -945,7 +1167,7 @@ static kk_bigint_t* kk_bigint_sub_abs(kk_bigint_t* x, kk_bigint_t* y, kk_context
     }
     drop_bigint(x,ctx);
   }
-  drop_bigint(y,ctx);
+  if (z != y) drop_bigint(y,ctx);
   return kk_bigint_trim(z,true,ctx);
 }
 
@@ -1015,11 +1237,11 @@ static kk_bigint_t* kk_bigint_shift_left(kk_bigint_t* x, kk_ssize_t digits, kk_c
 }
 
 static kk_bigint_t* kk_bigint_slice(kk_bigint_t* x, kk_ssize_t lo, kk_ssize_t hi, kk_context_t* ctx) {
+  if (lo >= x->count) lo = x->count;
+  if (hi > x->count)  hi = x->count;   // clamp before the fast path: `trim_to` must never grow `count`
   if (lo <= 0 && bigint_is_unique_(x)) {
     return kk_bigint_trim_to(x, hi, false, ctx);
   }
-  if (lo >= x->count) lo = x->count;
-  if (hi > x->count)  hi = x->count;
   const kk_ssize_t cz = hi - lo;
   kk_bigint_t* z = bigint_alloc(cz, x->is_neg, ctx);
   if (cz==0) {
@@ -1030,6 +1252,7 @@ static kk_bigint_t* kk_bigint_slice(kk_bigint_t* x, kk_ssize_t lo, kk_ssize_t hi
   else if (lo < x->count) {
     kk_memcpy(&z->digits[0], &x->digits[lo], kk_ssizeof(kk_digit_t)*cz);
   }
+  drop_bigint(x,ctx);
   return z;
 }
 
@@ -1054,6 +1277,70 @@ static kk_bigint_t* bigint_mul_karatsuba(kk_bigint_t* x, kk_bigint_t* y, kk_cont
   return kk_bigint_trim(prod,true, ctx);
 }
 
+static kk_bigint_t* kk_bigint_cdiv_cmod_small(kk_bigint_t* x, kk_digit_t y, kk_digit_t* pmod, kk_context_t* ctx);
+
+// Toom-3: split in three parts and evaluate at 0, 1, -1, -2, and infinity,
+// using Bodrato's interpolation sequence; all divisions are exact.
+// (M. Bodrato, "Towards optimal Toom-Cook multiplication", WAIFI'07)
+#define TOOM3_CUTOFF  (128)
+
+static kk_bigint_t* bigint_mul_toom3(kk_bigint_t* x, kk_bigint_t* y, kk_context_t* ctx) {
+  const kk_ssize_t cmax = (x->count >= y->count ? x->count : y->count);
+  const kk_ssize_t cmin = (x->count >= y->count ? y->count : x->count);
+  if (cmax < TOOM3_CUTOFF || 3*cmin <= cmax) {  // too small, or too skewed for a balanced 3-way split
+    return bigint_mul_karatsuba(x, y, ctx);
+  }
+  const kk_ssize_t n = (cmax + 2) / 3;
+
+  // split in three parts: x = x2*BASE^2n + x1*BASE^n + x0  (and y alike)
+  kk_bigint_t* x2 = kk_bigint_slice(dup_bigint(x), 2*n, x->count, ctx);
+  kk_bigint_t* x1 = kk_bigint_slice(dup_bigint(x), n, 2*n, ctx);
+  kk_bigint_t* x0 = kk_bigint_slice(x, 0, n, ctx);
+  kk_bigint_t* y2 = kk_bigint_slice(dup_bigint(y), 2*n, y->count, ctx);
+  kk_bigint_t* y1 = kk_bigint_slice(dup_bigint(y), n, 2*n, ctx);
+  kk_bigint_t* y0 = kk_bigint_slice(y, 0, n, ctx);
+
+  // evaluate both operands at 1, -1, and -2  (x(-2) == 2*(x(-1) + x2) - x0)
+  kk_bigint_t* t    = bigint_add(dup_bigint(x0), dup_bigint(x2), x2->is_neg, ctx);
+  kk_bigint_t* ex1  = bigint_add(dup_bigint(t), dup_bigint(x1), x1->is_neg, ctx);
+  kk_bigint_t* exm1 = kk_bigint_sub(t, x1, x1->is_neg, ctx);
+  kk_bigint_t* exm2 = kk_bigint_sub(kk_bigint_mul_small(bigint_add(dup_bigint(exm1), dup_bigint(x2), x2->is_neg, ctx), 2, ctx),
+                                    dup_bigint(x0), x0->is_neg, ctx);
+  t = bigint_add(dup_bigint(y0), dup_bigint(y2), y2->is_neg, ctx);
+  kk_bigint_t* ey1  = bigint_add(dup_bigint(t), dup_bigint(y1), y1->is_neg, ctx);
+  kk_bigint_t* eym1 = kk_bigint_sub(t, y1, y1->is_neg, ctx);
+  kk_bigint_t* eym2 = kk_bigint_sub(kk_bigint_mul_small(bigint_add(dup_bigint(eym1), dup_bigint(y2), y2->is_neg, ctx), 2, ctx),
+                                    dup_bigint(y0), y0->is_neg, ctx);
+
+  // five recursive multiplications (of a third of the size each)
+  kk_bigint_t* p0   = bigint_mul_toom3(x0, y0, ctx);
+  kk_bigint_t* p1   = bigint_mul_toom3(ex1, ey1, ctx);
+  kk_bigint_t* pm1  = bigint_mul_toom3(exm1, eym1, ctx);
+  kk_bigint_t* pm2  = bigint_mul_toom3(exm2, eym2, ctx);
+  kk_bigint_t* pinf = bigint_mul_toom3(x2, y2, ctx);
+
+  // interpolate
+  kk_bigint_t* r3 = kk_bigint_cdiv_cmod_small(kk_bigint_sub(pm2, dup_bigint(p1), p1->is_neg, ctx), 3, NULL, ctx);
+  kk_bigint_t* r1 = kk_bigint_cdiv_cmod_small(kk_bigint_sub(p1, dup_bigint(pm1), pm1->is_neg, ctx), 2, NULL, ctx);
+  kk_bigint_t* r2 = kk_bigint_sub(pm1, dup_bigint(p0), p0->is_neg, ctx);
+  kk_bigint_t* pinf2 = kk_bigint_mul_small(dup_bigint(pinf), 2, ctx);
+  r3 = bigint_add(kk_bigint_cdiv_cmod_small(kk_bigint_sub(dup_bigint(r2), r3, r3->is_neg, ctx), 2, NULL, ctx),
+                  pinf2, pinf2->is_neg, ctx);
+  r2 = kk_bigint_sub(bigint_add(r2, dup_bigint(r1), r1->is_neg, ctx), dup_bigint(pinf), pinf->is_neg, ctx);
+  r1 = kk_bigint_sub(r1, dup_bigint(r3), r3->is_neg, ctx);
+
+  // and recompose the result
+  t = kk_bigint_shift_left(r1, n, ctx);
+  kk_bigint_t* prod = bigint_add(p0, t, t->is_neg, ctx);
+  t = kk_bigint_shift_left(r2, 2*n, ctx);
+  prod = bigint_add(prod, t, t->is_neg, ctx);
+  t = kk_bigint_shift_left(r3, 3*n, ctx);
+  prod = bigint_add(prod, t, t->is_neg, ctx);
+  t = kk_bigint_shift_left(pinf, 4*n, ctx);
+  prod = bigint_add(prod, t, t->is_neg, ctx);
+  return kk_bigint_trim(prod, true, ctx);
+}
+
 
 /*----------------------------------'------------------------------------
   Pow
@@ -1135,6 +1422,11 @@ static kk_bigint_t* bigint_cdiv_cmod(kk_bigint_t* x, kk_bigint_t* y, kk_bigint_t
   kk_ssize_t cx = bigint_count_(x);
   kk_ssize_t cy = bigint_count_(y);
   kk_assert_internal(cx >= cy);
+#if defined(KK_USE_GMP)
+  if (cy >= KK_GMP_DIV_MIN_COUNT) {
+    return bigint_cdiv_cmod_gmp(x, y, pmod, ctx);
+  }
+#endif
   uint8_t is_neg = (bigint_is_neg_(x) != bigint_is_neg_(y) ? 1 : 0);
   kk_bigint_t* z = bigint_alloc_zero(cx - cy + 1, is_neg, ctx);
   // normalize
@@ -1297,6 +1589,30 @@ kk_integer_t kk_integer_add_generic(kk_integer_t x, kk_integer_t y, kk_context_t
   return integer_bigint(bigint_add(bx, by, by->is_neg, ctx), ctx);
 }
 
+// Add `x` into the accumulator `acc`. Functionally `kk_integer_add(acc,x,ctx)`, but a
+// unique bigint accumulator that runs out of room is grown with headroom digits so
+// tight reduction loops keep adding in place instead of allocating every iteration.
+#define ACC_EXTRA  (32)
+
+kk_integer_t kk_integer_add_into(kk_integer_t acc, kk_integer_t x, kk_context_t* ctx) {
+  if (kk_is_smallint(acc) && kk_is_smallint(x)) {
+    return kk_integer_add(acc, x, ctx);
+  }
+  kk_bigint_t* bacc = kk_integer_to_bigint(acc, ctx);
+  kk_bigint_t* bx = kk_integer_to_bigint(x, ctx);
+  const kk_ssize_t cacc = bigint_count_(bacc);
+  const kk_ssize_t cx = bigint_count_(bx);
+  const kk_ssize_t cz = (cacc >= cx ? cacc : cx) + 1;
+  if (bigint_is_unique_(bacc) && bigint_available_(bacc) < cz) {
+    // grow the accumulator (with headroom) so `bigint_add` can reuse it in place
+    kk_ssize_t dcount = bigint_roundup_count(cz + ACC_EXTRA);
+    kk_bigint_t* b = (kk_bigint_t*)kk_block_realloc(bigint_ptr_(bacc), kk_ssizeof(kk_bigint_t) - kk_ssizeof(kk_digit_t) + dcount*kk_ssizeof(kk_digit_t), ctx);
+    b->extra = (kk_extra_t)(dcount - b->count);
+    bacc = b;
+  }
+  return integer_bigint(bigint_add(bacc, bx, bx->is_neg, ctx), ctx);
+}
+
 kk_integer_t kk_integer_sub_generic(kk_integer_t x, kk_integer_t y, kk_context_t* ctx) {
   kk_assert_internal(kk_is_integer(x)&&kk_is_integer(y));
   kk_bigint_t* bx = kk_integer_to_bigint(x, ctx);
@@ -1313,7 +1629,7 @@ kk_integer_t kk_integer_mul_generic(kk_integer_t x, kk_integer_t y, kk_context_t
   kk_bigint_t* bx = kk_integer_to_bigint(x, ctx);
   kk_bigint_t* by = kk_integer_to_bigint(y, ctx);
   bool usek = use_karatsuba(bx->count, by->count);
-  return integer_bigint((usek ? bigint_mul_karatsuba(bx,by, ctx) : bigint_mul(bx, by, ctx)), ctx);
+  return integer_bigint((usek ? bigint_mul_toom3(bx,by, ctx) : bigint_mul(bx, by, ctx)), ctx);
 }
 
 
@@ -187,6 +187,38 @@ static int kk_posix_write_retry(const kk_file_t out, const uint8_t* buf, const k
   Text files
 --------------------------------------------------------------------------------------------------*/
 
+#if !defined(WIN32)
+#include <sys/mman.h>
+
+// files at least this large are memory mapped instead of read into a fresh buffer
+#define KK_OS_MMAP_THRESHOLD  (64*1024)
+
+// free function for mmap-backed raw bytes: unmap the file mapping
+static void kk_os_mmap_free(void* p, kk_block_t* b, kk_context_t* ctx) {
+  kk_unused(ctx);
+  struct kk_bytes_raw_s* raw = (struct kk_bytes_raw_s*)b;
+  munmap(p, (size_t)raw->clength);
+}
+
+// Read a whole file through a memory map wrapped as raw bytes: a valid utf-8
+// file becomes a zero-copy string and the mapping is released on the final drop.
+static int kk_os_mmap_text_file(kk_file_t f, kk_ssize_t len, kk_string_t* result, kk_context_t* ctx) {
+  // we rely on the zero fill of the final page for the terminating zero that
+  // string buffers guarantee; a file of exactly a page multiple has none, so
+  // let the caller fall back to a regular read in that case.
+  const long page = sysconf(_SC_PAGESIZE);
+  if (page <= 0 || (len % page) == 0) return EINVAL;
+  void* m = mmap(NULL, (size_t)len, PROT_READ, MAP_PRIVATE, f, 0);
+  if (m == MAP_FAILED) return errno;
+#if defined(MADV_SEQUENTIAL)
+  madvise(m, (size_t)len, MADV_SEQUENTIAL);  // validation streams through the pages once
+#endif
+  kk_bytes_t buf = kk_bytes_alloc_raw_fun(len, (const uint8_t*)m, &kk_os_mmap_free, ctx);
+  *result = kk_string_convert_from_qutf8(buf, ctx);
+  return 0;
+}
+#endif
+
 kk_decl_export int kk_os_read_text_file(kk_string_t path, kk_string_t* result, kk_context_t* ctx)
 {
   kk_file_t f;
@@ -199,6 +231,16 @@ kk_decl_export int kk_os_read_text_file(kk_string_t path, kk_string_t* result, k
     kk_posix_close(f);
     return err;
   }
+#if !defined(WIN32)
+  if (len >= KK_OS_MMAP_THRESHOLD) {
+    err = kk_os_mmap_text_file(f, len, result, ctx);
+    if (err == 0) {
+      kk_posix_close(f);
+      return 0;
+    }
+    // on failure fall through to a regular read
+  }
+#endif
   uint8_t* cbuf;
   kk_bytes_t buf = kk_bytes_alloc_buf(len, &cbuf, ctx);
 
@@ -240,20 +282,1003 @@ kk_decl_export int kk_os_write_text_file(kk_string_t path, kk_string_t content,
 
 
 
+/*--------------------------------------------------------------------------------------------------
+  Huge pages
+  Called from `kk_malloc` (and variants) for allocations of at least
+  `KK_HUGE_PAGE_THRESHOLD` bytes; see the documentation in `kklib.h`. The advice is
+  best effort: it fails silently when transparent huge pages are disabled system
+  wide, and `khugepaged` may take a while to actually collapse the pages.
+--------------------------------------------------------------------------------------------------*/
+
+kk_decl_export void kk_huge_page_advise(void* p, kk_ssize_t sz, kk_context_t* ctx) {
+  kk_unused(ctx);
+  if (p == NULL) return;
+  kk_stat_inc(ctx, huge_allocs);
+  kk_stat_add(ctx, huge_alloc_bytes, sz);
+#if !defined(WIN32) && defined(MADV_HUGEPAGE)
+  // advise only the page-aligned interior of the allocation so a neighbouring
+  // allocation sharing the first or last page is never affected
+  const long page = sysconf(_SC_PAGESIZE);
+  if (page <= 0) return;
+  const uintptr_t mask = (uintptr_t)page - 1;
+  const uintptr_t lo = ((uintptr_t)p + mask) & ~mask;
+  const uintptr_t hi = ((uintptr_t)p + (uintptr_t)sz) & ~mask;
+  if (hi > lo) {
+    madvise((void*)lo, (size_t)(hi - lo), MADV_HUGEPAGE);
+  }
+#else
+  kk_unused(sz);
+#endif
+}
+
+
+/*--------------------------------------------------------------------------------------------------
+  Heap snapshots
+  Serialize a reachable graph of constant heap blocks into a relocatable file, and load it
+  back by memory mapping the file directly as heap blocks: startup becomes an `mmap` instead
+  of rebuilding the data, the untouched pages stay shared between processes, and the kernel
+  pages the data in on demand. Pointer fields are stored as payload offsets together with a
+  relocation table; the load rewrites each relocated field once (copy-on-write touches only
+  the pointer-bearing pages). Every block is written with a stuck reference count (`RC_STUCK`,
+  as static literals use, see `refcount.c`) so it counts as thread shared and is never freed:
+  dup and drop never write to a mapped page, and the mapping stays valid for the lifetime of
+  the process (it is intentionally never unmapped, like the static data segment).
+
+  Only immutable data can be snapshotted: blocks holding raw C- or function pointers, closures,
+  evidence vectors, and mutable references are rejected with `ENOTSUP`. Byte- and vector views
+  stay zero-copy: their parent reference is relocated like any pointer field and the interior
+  buffer pointer of a bytes view is stored as an offset from the payload base.
+--------------------------------------------------------------------------------------------------*/
+
+#define KK_SNAPSHOT_MAGIC  KK_U64(0x70616E736B6F6B01)          // "\x01koksnap" (little endian)
+#define KK_SNAPSHOT_CHECK  (KK_U64(0x0A0B0C0D00000000) | (8*sizeof(void*)))  // word size, and the byte pattern checks endianness
+
+typedef struct kk_snapshot_header_s {
+  uint64_t magic;         // KK_SNAPSHOT_MAGIC
+  uint64_t check;         // KK_SNAPSHOT_CHECK as written by the saver
+  uint64_t payload_size;  // total bytes of serialized blocks (each 8-byte aligned)
+  uint64_t reloc_count;   // entries in the relocation table following the payload
+  uint64_t root;          // payload offset of the root block; or the verbatim box of a value root (odd)
+  uint64_t reserved[3];   // pad to 64 bytes so the payload stays aligned
+} kk_snapshot_header_t;
+
+// The byte size of a heap block. Blocks of a tag that embeds a raw pointer (or mutable
+// state) cannot be relocated into a snapshot; for those `0` is returned.
+static kk_ssize_t kk_snapshot_block_size(kk_block_t* b) {
+  const kk_tag_t tag = kk_block_tag(b);
+  switch (tag) {
+    case KK_TAG_BYTES_SMALL:
+      return kk_ssizeof(struct kk_bytes_small_s);
+    case KK_TAG_BYTES:          // includes the terminating zero through the `buf[1]` member
+      return kk_ssizeof(struct kk_bytes_normal_s) + ((kk_bytes_normal_t)b)->length;
+    case KK_TAG_BYTES_VIEW:
+      return kk_ssizeof(struct kk_bytes_view_s);
+    case KK_TAG_VECTOR: {       // always a large block; the length is in the first field
+      const kk_ssize_t n = (kk_ssize_t)kk_intf_unbox(((kk_block_large_t*)b)->large_scan_fsize);
+      return kk_ssizeof(struct kk_block_large_s) + (n - 1)*kk_ssizeof(kk_box_t);
+    }
+    case KK_TAG_VECTOR_VIEW:
+      return kk_ssizeof(struct kk_vector_view_s);
+    case KK_TAG_VECTOR_INT64:
+      return kk_ssizeof(struct kk_vector_int64_s) + (((kk_vector_int64_base_t)b)->length - 1)*kk_ssizeof(int64_t);
+    case KK_TAG_VECTOR_FLOAT64:
+      return kk_ssizeof(struct kk_vector_float64_s) + (((kk_vector_float64_base_t)b)->length - 1)*kk_ssizeof(double);
+    case KK_TAG_PVEC:
+      return kk_ssizeof(struct kk_pvec_s);
+    case KK_TAG_INT64: case KK_TAG_DOUBLE: case KK_TAG_INTPTR:
+      return kk_ssizeof(kk_block_t) + kk_ssizeof(int64_t);
+    case KK_TAG_INT32: case KK_TAG_FLOAT: case KK_TAG_INT16:   // <= 32-bit platforms only
+      return kk_ssizeof(kk_block_t) + kk_ssizeof(int64_t);     // conservative; blocks are allocated word aligned
+    case KK_TAG_BIGINT:
+      // the digit count is private to `integer.c` but bigints are always heap allocated
+      // so the usable size covers the digits (as in the heap census, see `kklib.h`)
+      return (kk_ssize_t)kk_malloc_usable_size(b);
+    case KK_TAG_REF:            // mutable; a snapshot holds constant data only
+    case KK_TAG_FUNCTION:       // embeds a C function pointer (possibly as a boxed value)
+    case KK_TAG_EVV_VECTOR:     // evidence is full of closures and is runtime internal
+    case KK_TAG_CFUNPTR:
+    case KK_TAG_CPTR_RAW:
+    case KK_TAG_BYTES_RAW:      // points to storage outside the heap (possibly a file mapping)
+      return 0;
+    default:                    // constructors (and open-, box-, just blocks): boxed scan fields only
+      if (b->header.scan_fsize == KK_SCAN_FSIZE_MAX) {
+        return kk_ssizeof(struct kk_block_large_s) + (kk_block_scan_fsize(b) - 1)*kk_ssizeof(kk_box_t);
+      }
+      return kk_ssizeof(kk_block_t) + kk_block_scan_fsize(b)*kk_ssizeof(kk_box_t);
+  }
+}
+
+// Serialization state. The payload buffer can reallocate while blocks are still being
+// interned so in-progress blocks are tracked by payload offset, never by pointer.
+typedef struct kk_snapshot_save_s {
+  uint8_t*    buf;            // serialized blocks (the payload)
+  kk_ssize_t  size;
+  kk_ssize_t  capacity;
+  uintptr_t*  map;            // open addressing map: block pointer -> its payload offset
+  kk_ssize_t* map_offset;
+  kk_ssize_t  map_capacity;   // always a power of two
+  kk_ssize_t  map_count;
+  kk_ssize_t* relocs;         // payload offsets of fields holding a payload offset to rewrite on load
+  kk_ssize_t  reloc_count;
+  kk_ssize_t  reloc_capacity;
+  kk_block_t** todo;          // interned blocks whose fields still need rewriting
+  kk_ssize_t* todo_offset;    // the payload offset of each `todo` entry
+  kk_ssize_t  todo_count;
+  kk_ssize_t  todo_capacity;
+} kk_snapshot_save_t;
+
+static void kk_snapshot_save_done(kk_snapshot_save_t* st, kk_context_t* ctx) {
+  kk_free(st->buf, ctx);
+  kk_free(st->map, ctx);
+  kk_free(st->map_offset, ctx);
+  kk_free(st->relocs, ctx);
+  kk_free(st->todo, ctx);
+  kk_free(st->todo_offset, ctx);
+}
+
+static void kk_snapshot_map_grow(kk_snapshot_save_t* st, kk_context_t* ctx) {
+  const kk_ssize_t newcap = (st->map_capacity == 0 ? 1024 : 2*st->map_capacity);
+  uintptr_t* map = (uintptr_t*)kk_zalloc(newcap*kk_ssizeof(uintptr_t), ctx);
+  kk_ssize_t* offsets = (kk_ssize_t*)kk_malloc(newcap*kk_ssizeof(kk_ssize_t), ctx);
+  for (kk_ssize_t i = 0; i < st->map_capacity; i++) {
+    const uintptr_t key = st->map[i];
+    if (key == 0) continue;
+    kk_ssize_t j = (kk_ssize_t)((key >> 3) & (uintptr_t)(newcap - 1));
+    while (map[j] != 0) { j = (j + 1) & (newcap - 1); }
+    map[j] = key;
+    offsets[j] = st->map_offset[i];
+  }
+  kk_free(st->map, ctx);
+  kk_free(st->map_offset, ctx);
+  st->map = map;
+  st->map_offset = offsets;
+  st->map_capacity = newcap;
+}
+
+// Intern a block: copy it into the payload once with a stuck refcount and return its
+// payload offset (or a negative error). The scan fields are rewritten later from the
+// `todo` list so deep structures (long lists) serialize without unbounded recursion.
+static kk_ssize_t kk_snapshot_intern(kk_snapshot_save_t* st, kk_block_t* b, kk_context_t* ctx) {
+  if (4*(st->map_count+1) > 3*st->map_capacity) { kk_snapshot_map_grow(st, ctx); }
+  kk_ssize_t i = (kk_ssize_t)((((uintptr_t)b) >> 3) & (uintptr_t)(st->map_capacity - 1));
+  while (st->map[i] != 0) {
+    if (st->map[i] == (uintptr_t)b) return st->map_offset[i];    // already interned (shared or cyclic)
+    i = (i + 1) & (st->map_capacity - 1);
+  }
+  const kk_ssize_t bsize = kk_snapshot_block_size(b);
+  if (bsize <= 0) return -ENOTSUP;
+  const kk_ssize_t asize = (bsize + 7) & ~(kk_ssize_t)7;         // keep every block 8-byte aligned
+  const kk_ssize_t offset = st->size;
+  if (offset + asize > st->capacity) {
+    kk_ssize_t newcap = (st->capacity == 0 ? (kk_ssize_t)0x10000 : 2*st->capacity);
+    while (offset + asize > newcap) newcap *= 2;
+    st->buf = (uint8_t*)kk_realloc(st->buf, newcap, ctx);
+    st->capacity = newcap;
+  }
+  kk_memcpy(st->buf + offset, b, bsize);
+  kk_memset(st->buf + offset + bsize, 0, asize - bsize);
+  kk_block_refcount_set((kk_block_t*)(st->buf + offset), KK_U32(0x80000000));  // RC_STUCK: shared, and never freed (as KK_HEADER_STATIC)
+  // the intern mark means "currently canonical in the process-wide intern table" (see
+  // `KK_STRING_INTERNED` in `string.h`) which must not be serialized: a loaded marked copy
+  // would wrongly compare unequal to an equal interned string by pointer inequality alone
+  ((kk_block_t*)(st->buf + offset))->header._field_idx = 0;
+  st->map[i] = (uintptr_t)b;
+  st->map_offset[i] = offset;
+  st->map_count++;
+  st->size += asize;
+  if (st->todo_count >= st->todo_capacity) {
+    st->todo_capacity = (st->todo_capacity == 0 ? 1024 : 2*st->todo_capacity);
+    st->todo = (kk_block_t**)kk_realloc(st->todo, st->todo_capacity*kk_ssizeof(kk_block_t*), ctx);
+    st->todo_offset = (kk_ssize_t*)kk_realloc(st->todo_offset, st->todo_capacity*kk_ssizeof(kk_ssize_t), ctx);
+  }
+  st->todo[st->todo_count] = b;
+  st->todo_offset[st->todo_count] = offset;
+  st->todo_count++;
+  return offset;
+}
+
+// Record that the `kk_box_t` (or interior pointer) at payload offset `at` holds a payload
+// offset that the load must rewrite to a real pointer.
+static void kk_snapshot_reloc(kk_snapshot_save_t* st, kk_ssize_t at, kk_context_t* ctx) {
+  if (st->reloc_count >= st->reloc_capacity) {
+    st->reloc_capacity = (st->reloc_capacity == 0 ? 1024 : 2*st->reloc_capacity);
+    st->relocs = (kk_ssize_t*)kk_realloc(st->relocs, st->reloc_capacity*kk_ssizeof(kk_ssize_t), ctx);
+  }
+  st->relocs[st->reloc_count++] = at;
+}
+
+// Rewrite the fields of an interned block: every pointer field is replaced by the payload
+// offset of the (recursively interned) target block plus a relocation entry. Value boxes
+// (including boxed doubles, small ints, singletons, and `kk_box_null`) copy verbatim.
+static int kk_snapshot_fields(kk_snapshot_save_t* st, kk_block_t* b, kk_ssize_t offset, kk_context_t* ctx) {
+  const kk_ssize_t scan_fsize = kk_block_scan_fsize(b);
+  for (kk_ssize_t i = 0; i < scan_fsize; i++) {
+    const kk_box_t field = kk_block_field(b, i);
+    if (!kk_box_is_ptr(field)) continue;
+    const kk_ssize_t child = kk_snapshot_intern(st, kk_ptr_unbox(field), ctx);
+    if (child < 0) return (int)(-child);
+    const kk_ssize_t at = offset + kk_ssizeof(kk_header_t) + i*kk_ssizeof(kk_box_t);
+    ((kk_box_t*)(st->buf + at))->box = (uintptr_t)child;    // offsets are even and cannot be mistaken for a value box
+    kk_snapshot_reloc(st, at, ctx);
+  }
+  if (kk_block_has_tag(b, KK_TAG_BYTES_VIEW)) {
+    // the interior buffer pointer points into the parent block (field 0, relocated above):
+    // store it as an offset from the payload base as well
+    kk_bytes_view_t v = (kk_bytes_view_t)b;
+    const kk_ssize_t parent = (kk_ssize_t)(((kk_box_t*)(st->buf + offset + kk_ssizeof(kk_header_t)))->box);
+    const kk_ssize_t at = offset + (kk_ssize_t)offsetof(struct kk_bytes_view_s, buf);
+    *((uintptr_t*)(st->buf + at)) = (uintptr_t)(parent + (v->buf - (const uint8_t*)kk_ptr_unbox(v->parent)));
+    kk_snapshot_reloc(st, at, ctx);
+  }
+  return 0;
+}
+
+// Serialize the graph reachable from `root` into the file at `path`.
+// Fails with `ENOTSUP` when the graph holds non-constant data (see the section comment).
+kk_decl_export int kk_os_snapshot_save(kk_string_t path, kk_box_t root, kk_context_t* ctx)
+{
+  kk_snapshot_save_t st;
+  kk_memset(&st, 0, sizeof(st));
+  kk_snapshot_header_t header;
+  kk_memset(&header, 0, sizeof(header));
+  header.magic = KK_SNAPSHOT_MAGIC;
+  header.check = KK_SNAPSHOT_CHECK;
+  int err = 0;
+  if (kk_box_is_ptr(root)) {
+    const kk_ssize_t offset = kk_snapshot_intern(&st, kk_ptr_unbox(root), ctx);
+    if (offset < 0) err = (int)(-offset);
+    header.root = (uint64_t)offset;
+  }
+  else {
+    header.root = (uint64_t)root.box;          // a value box is stored verbatim (always odd)
+  }
+  while (err == 0 && st.todo_count > 0) {      // breadth-first over the interned blocks
+    st.todo_count--;
+    err = kk_snapshot_fields(&st, st.todo[st.todo_count], st.todo_offset[st.todo_count], ctx);
+  }
+  header.payload_size = (uint64_t)st.size;
+  header.reloc_count = (uint64_t)st.reloc_count;
+
+  kk_file_t f = 0;
+  if (err == 0) {
+    err = kk_posix_open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644, &f, ctx);
+    path = kk_string_empty();                  // consumed by the open
+  }
+  if (err == 0) {
+    kk_ssize_t nwritten;
+    err = kk_posix_write_retry(f, (const uint8_t*)&header, kk_ssizeof(header), &nwritten);
+    if (err == 0 && nwritten < kk_ssizeof(header)) err = EIO;
+    if (err == 0 && st.size > 0) {
+      err = kk_posix_write_retry(f, st.buf, st.size, &nwritten);
+      if (err == 0 && nwritten < st.size) err = EIO;
+    }
+    if (err == 0 && st.reloc_count > 0) {
+      const kk_ssize_t rsize = st.reloc_count*kk_ssizeof(kk_ssize_t);
+      err = kk_posix_write_retry(f, (const uint8_t*)st.relocs, rsize, &nwritten);
+      if (err == 0 && nwritten < rsize) err = EIO;
+    }
+    kk_posix_close(f);
+  }
+  kk_snapshot_save_done(&st, ctx);
+  kk_string_drop(path, ctx);
+  kk_box_drop(root, ctx);
+  return err;
+}
+
+// Map a snapshot written by `kk_os_snapshot_save` and return its root. The blocks are
+// permanent (stuck, like static literals) and the mapping lives until the process exits.
+kk_decl_export int kk_os_snapshot_load(kk_string_t path, kk_box_t* root, kk_context_t* ctx)
+{
+  *root = kk_box_null;
+  kk_file_t f;
+  int err = kk_posix_open(path, O_RDONLY, 0, &f, ctx);
+  if (err != 0) return err;
+  kk_ssize_t fsize;
+  err = kk_posix_fsize(f, &fsize);
+  if (err != 0 || fsize < kk_ssizeof(kk_snapshot_header_t)) {
+    kk_posix_close(f);
+    return (err != 0 ? err : EINVAL);
+  }
+  uint8_t* m = NULL;
+#if !defined(WIN32)
+  // map privately: the relocation pass below copies only the written (pointer-bearing)
+  // pages while the rest stays demand-paged and shared between processes
+  m = (uint8_t*)mmap(NULL, (size_t)fsize, PROT_READ | PROT_WRITE, MAP_PRIVATE, f, 0);
+  if (m == MAP_FAILED) m = NULL;
+#endif
+  if (m == NULL) {                             // windows, or when the mapping failed
+    m = (uint8_t*)kk_malloc(fsize, ctx);
+    kk_ssize_t nread;
+    err = kk_posix_read_retry(f, m, fsize, &nread);
+    if (err == 0 && nread < fsize) err = EIO;
+    if (err != 0) {
+      kk_free(m, ctx);
+      kk_posix_close(f);
+      return err;
+    }
+  }
+  kk_posix_close(f);                           // the mapping (or buffer) survives the descriptor
+
+  const kk_snapshot_header_t* header = (const kk_snapshot_header_t*)m;
+  uint8_t* base = m + sizeof(kk_snapshot_header_t);
+  const kk_ssize_t psize = (kk_ssize_t)header->payload_size;
+  const kk_ssize_t reloc_count = (kk_ssize_t)header->reloc_count;
+  if (header->magic != KK_SNAPSHOT_MAGIC || header->check != KK_SNAPSHOT_CHECK ||
+      psize < 0 || reloc_count < 0 ||
+      fsize < kk_ssizeof(kk_snapshot_header_t) + psize + reloc_count*kk_ssizeof(kk_ssize_t)) {
+    return EINVAL;                             // wrong format, or a different word size or endianness
+  }
+  const kk_ssize_t* relocs = (const kk_ssize_t*)(base + psize);
+  for (kk_ssize_t i = 0; i < reloc_count; i++) {
+    const kk_ssize_t at = relocs[i];
+    if (at < 0 || (at & (kk_ssizeof(uintptr_t)-1)) != 0 || at > psize - kk_ssizeof(uintptr_t)) return EINVAL;
+    uintptr_t* field = (uintptr_t*)(base + at);
+    if (*field >= (uintptr_t)psize) return EINVAL;
+    *field = (uintptr_t)(base + *field);
+  }
+  if ((header->root & 1) != 0) {               // a value box: stored verbatim
+    root->box = (uintptr_t)header->root;
+  }
+  else {
+    if ((kk_ssize_t)header->root >= psize) return EINVAL;
+    *root = kk_ptr_box((kk_block_t*)(base + (kk_ssize_t)header->root));
+  }
+  return 0;
+}
+
+
+
+/*--------------------------------------------------------------------------------------------------
+  Asynchronous file I/O
+  Reads and writes can complete into a promise (see `thread.h`) so file i/o
+  never stalls a cpu-bound task group worker. On Linux the data transfer is
+  submitted to an io_uring instance drained by a single completion thread;
+  when io_uring is unavailable at runtime (seccomp etc.), and on other
+  platforms, the blocking operation runs on the dedicated i/o task group.
+--------------------------------------------------------------------------------------------------*/
+#include "kklib/thread.h"
+
+// An async operation resolves its promise with an (errno,result) pair.
+struct kk_aio_result_s {
+  kk_block_t _block;
+  kk_box_t   err;       // boxed errno; 0 when the operation succeeded
+  kk_box_t   result;    // string content for reads; unit for writes
+};
+
+static kk_box_t kk_aio_result_box(int err, kk_box_t result, kk_context_t* ctx) {
+  struct kk_aio_result_s* r = kk_block_alloc_as(struct kk_aio_result_s, 2, KK_TAG_BOX, ctx);
+  r->err = kk_intf_box(err);
+  r->result = result;
+  return kk_ptr_box(&r->_block);
+}
+
+// Await an async operation: returns the errno (0 on success) and the result.
+kk_decl_export int kk_os_aio_await(kk_promise_t pr, kk_box_t* result, kk_context_t* ctx) {
+  kk_box_t b = kk_promise_get(pr, ctx);
+  struct kk_aio_result_s* r = (struct kk_aio_result_s*)kk_ptr_unbox(b);
+  const int err = (int)kk_intf_unbox(kk_box_dup(r->err));
+  *result = kk_box_dup(r->result);
+  kk_box_drop(b, ctx);
+  return err;
+}
+
+// ----------------------------------------------------
+// Fallback: run the blocking operation on the i/o task group
+
+struct kk_aio_read_fun_s {
+  struct kk_function_s _base;
+  kk_box_t path;
+};
+
+static kk_box_t kk_aio_read_fun(kk_function_t fself, kk_context_t* ctx) {
+  struct kk_aio_read_fun_s* self = kk_function_as(struct kk_aio_read_fun_s*, fself);
+  kk_string_t path = kk_string_unbox(kk_box_dup(self->path));
+  kk_function_drop(fself, ctx);
+  kk_string_t content = kk_string_empty();
+  const int err = kk_os_read_text_file(path, &content, ctx);
+  return kk_aio_result_box(err, kk_string_box(content), ctx);
+}
+
+static kk_promise_t kk_aio_schedule_read(kk_string_t path, kk_context_t* ctx) {
+  struct kk_aio_read_fun_s* f = kk_function_alloc_as(struct kk_aio_read_fun_s, 2, ctx);
+  f->_base.fun = kk_cfun_ptr_box(&kk_aio_read_fun, ctx);
+  f->path = kk_string_box(path);
+  return kk_io_task_schedule(&f->_base, ctx);
+}
+
+struct kk_aio_write_fun_s {
+  struct kk_function_s _base;
+  kk_box_t path;
+  kk_box_t content;
+};
+
+static kk_box_t kk_aio_write_fun(kk_function_t fself, kk_context_t* ctx) {
+  struct kk_aio_write_fun_s* self = kk_function_as(struct kk_aio_write_fun_s*, fself);
+  kk_string_t path = kk_string_unbox(kk_box_dup(self->path));
+  kk_string_t content = kk_string_unbox(kk_box_dup(self->content));
+  kk_function_drop(fself, ctx);
+  const int err = kk_os_write_text_file(path, content, ctx);
+  return kk_aio_result_box(err, kk_unit_box(kk_Unit), ctx);
+}
+
+static kk_promise_t kk_aio_schedule_write(kk_string_t path, kk_string_t content, kk_context_t* ctx) {
+  struct kk_aio_write_fun_s* f = kk_function_alloc_as(struct kk_aio_write_fun_s, 3, ctx);
+  f->_base.fun = kk_cfun_ptr_box(&kk_aio_write_fun, ctx);
+  f->path = kk_string_box(path);
+  f->content = kk_string_box(content);
+  return kk_io_task_schedule(&f->_base, ctx);
+}
+
+// ----------------------------------------------------
+// io_uring (Linux)
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define KK_HAS_IO_URING
+#endif
+#endif
+
+#ifdef KK_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <pthread.h>
+
+#define KK_AIO_RING_ENTRIES  (64)
+
+typedef struct kk_aio_ring_s {
+  int       fd;
+  uint32_t  entries;
+  uint32_t* sq_head;     // consumed by the kernel
+  uint32_t* sq_tail;     // produced under `aio_submit_lock`
+  uint32_t  sq_mask;
+  uint32_t* sq_array;
+  struct io_uring_sqe* sqes;
+  uint32_t* cq_head;     // consumed by the completion thread
+  uint32_t* cq_tail;     // produced by the kernel
+  uint32_t  cq_mask;
+  struct io_uring_cqe* cqes;
+} kk_aio_ring_t;
+
+static kk_aio_ring_t   aio_ring;
+static bool            aio_ring_ok = false;
+static pthread_mutex_t aio_submit_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t  aio_once = PTHREAD_ONCE_INIT;
+
+// One in-flight operation; `user_data` of the submission points back to it.
+typedef struct kk_aio_op_s {
+  kk_promise_t promise;   // resolved on completion
+  kk_file_t    fd;
+  bool         is_read;
+  kk_ssize_t   len;
+  uint8_t*     cbuf;      // target (read) or source (write) buffer
+  kk_bytes_t   buf;       // read target; owns `cbuf`
+  kk_string_t  content;   // write source; owns `cbuf`
+  struct iovec iov;
+  _Atomic(uint32_t) published;  // release/acquire edge from submitter to completion thread
+} kk_aio_op_t;
+
+static void kk_aio_complete(kk_aio_op_t* op, int32_t res, kk_context_t* ctx) {
+  const uint32_t published = kk_atomic_load_acquire(&op->published);  // pairs with the release in `kk_aio_submit`
+  kk_assert_internal(published == 1); kk_unused_internal(published);
+  int err = 0;
+  kk_box_t result;
+  if (op->is_read) {
+    kk_bytes_t buf = op->buf;
+    if (res < 0) {
+      err = (int)(-res);
+      kk_bytes_drop(buf, ctx);
+      result = kk_string_box(kk_string_empty());
+    }
+    else {
+      if (res < op->len) { buf = kk_bytes_adjust_length(buf, res, ctx); }
+      result = kk_string_box(kk_string_convert_from_qutf8(buf, ctx));
+    }
+  }
+  else {
+    if (res < 0) { err = (int)(-res); }
+    else if (res < op->len) {
+      // partial write: finish with a (rare) blocking retry
+      kk_ssize_t nwritten;
+      err = kk_posix_write_retry(op->fd, op->cbuf + res, op->len - res, &nwritten);
+      if (err == 0 && nwritten < op->len - res) { err = EIO; }
+    }
+    kk_string_drop(op->content, ctx);
+    result = kk_unit_box(kk_Unit);
+  }
+  kk_posix_close(op->fd);
+  kk_promise_set(op->promise, kk_aio_result_box(err, result, ctx), ctx);  // consumes the promise reference
+  kk_free(op, ctx);
+}
+
+static void* kk_aio_completion_thread(void* arg) {
+  kk_unused(arg);
+  kk_context_t* ctx = kk_get_context();
+  while (true) {
+    const long n = syscall(SYS_io_uring_enter, aio_ring.fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+    if (n < 0 && errno != EINTR) break;  // ring went away; should not happen
+    uint32_t head = *aio_ring.cq_head;
+    const uint32_t tail = kk_atomic_load_acquire((_Atomic(uint32_t)*)aio_ring.cq_tail);
+    while (head != tail) {
+      struct io_uring_cqe* cqe = &aio_ring.cqes[head & aio_ring.cq_mask];
+      kk_aio_complete((kk_aio_op_t*)(uintptr_t)cqe->user_data, cqe->res, ctx);
+      head++;
+    }
+    kk_atomic_store_release((_Atomic(uint32_t)*)aio_ring.cq_head, head);
+  }
+  kk_free_context();
+  return NULL;
+}
+
+static void kk_aio_ring_init(void) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  const int fd = (int)syscall(SYS_io_uring_setup, KK_AIO_RING_ENTRIES, &params);
+  if (fd < 0) return;  // not available (old kernel, seccomp): use the i/o task group
+  size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    if (cq_size > sq_size) { sq_size = cq_size; }
+    cq_size = sq_size;
+  }
+  uint8_t* sq = (uint8_t*)mmap(NULL, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, IORING_OFF_SQ_RING);
+  if (sq == MAP_FAILED) { close(fd); return; }
+  uint8_t* cq = sq;
+  if (!single_mmap) {
+    cq = (uint8_t*)mmap(NULL, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, IORING_OFF_CQ_RING);
+    if (cq == MAP_FAILED) { munmap(sq, sq_size); close(fd); return; }
+  }
+  struct io_uring_sqe* sqes = (struct io_uring_sqe*)mmap(NULL, params.sq_entries * sizeof(struct io_uring_sqe),
+                                                          PROT_READ | PROT_WRITE, MAP_SHARED, fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    if (!single_mmap) { munmap(cq, cq_size); }
+    munmap(sq, sq_size); close(fd);
+    return;
+  }
+  aio_ring.fd       = fd;
+  aio_ring.entries  = params.sq_entries;
+  aio_ring.sq_head  = (uint32_t*)(sq + params.sq_off.head);
+  aio_ring.sq_tail  = (uint32_t*)(sq + params.sq_off.tail);
+  aio_ring.sq_mask  = *(uint32_t*)(sq + params.sq_off.ring_mask);
+  aio_ring.sq_array = (uint32_t*)(sq + params.sq_off.array);
+  aio_ring.sqes     = sqes;
+  aio_ring.cq_head  = (uint32_t*)(cq + params.cq_off.head);
+  aio_ring.cq_tail  = (uint32_t*)(cq + params.cq_off.tail);
+  aio_ring.cq_mask  = *(uint32_t*)(cq + params.cq_off.ring_mask);
+  aio_ring.cqes     = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+  pthread_t th;
+  if (pthread_create(&th, NULL, &kk_aio_completion_thread, NULL) != 0) return;
+  pthread_detach(th);
+  aio_ring_ok = true;
+}
+
+// Submit an operation; returns `false` if the ring is full (the caller falls
+// back to the i/o task group). Uses READV/WRITEV for kernel 5.1 compatibility.
+static bool kk_aio_submit(kk_aio_op_t* op) {
+  op->iov.iov_base = op->cbuf;
+  op->iov.iov_len  = (size_t)op->len;
+  pthread_mutex_lock(&aio_submit_lock);
+  const uint32_t tail = *aio_ring.sq_tail;  // we are the only producer (under the lock)
+  const uint32_t head = kk_atomic_load_acquire((_Atomic(uint32_t)*)aio_ring.sq_head);
+  if (tail - head >= aio_ring.entries) {
+    pthread_mutex_unlock(&aio_submit_lock);
+    return false;
+  }
+  const uint32_t idx = tail & aio_ring.sq_mask;
+  struct io_uring_sqe* sqe = &aio_ring.sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode    = (op->is_read ? IORING_OP_READV : IORING_OP_WRITEV);
+  sqe->fd        = op->fd;
+  sqe->addr      = (uint64_t)(uintptr_t)&op->iov;
+  sqe->len       = 1;
+  sqe->user_data = (uint64_t)(uintptr_t)op;
+  kk_atomic_store_release(&op->published, 1);  // publish the op to the completion thread
+  aio_ring.sq_array[idx] = idx;
+  kk_atomic_store_release((_Atomic(uint32_t)*)aio_ring.sq_tail, tail + 1);
+  long submitted;
+  do {
+    submitted = syscall(SYS_io_uring_enter, aio_ring.fd, 1, 0, 0, NULL, 0);
+  } while (submitted < 0 && errno == EINTR);
+  pthread_mutex_unlock(&aio_submit_lock);
+  return true;
+}
+
+// A promise resolved on the spot (when the error is already known at submit time).
+static kk_promise_t kk_aio_resolved(int err, kk_box_t result, kk_context_t* ctx) {
+  kk_promise_t pr = kk_promise_alloc(ctx);
+  kk_box_dup(pr);  // `kk_promise_set` consumes a promise reference
+  kk_promise_set(pr, kk_aio_result_box(err, result, ctx), ctx);
+  return pr;
+}
+#endif  // KK_HAS_IO_URING
+
+kk_decl_export kk_promise_t kk_os_read_text_file_async(kk_string_t path, kk_context_t* ctx) {
+#ifdef KK_HAS_IO_URING
+  pthread_once(&aio_once, &kk_aio_ring_init);
+  if (aio_ring_ok) {
+    kk_string_t path2 = kk_string_dup(path);  // in case we must fall back to the task group
+    kk_file_t f;
+    kk_ssize_t len = 0;
+    int err = kk_posix_open(path, O_RDONLY, 0, &f, ctx);  // metadata is fast; only the transfer goes async
+    if (err == 0) {
+      err = kk_posix_fsize(f, &len);
+      if (err != 0) { kk_posix_close(f); }
+    }
+    if (err != 0) {
+      kk_string_drop(path2, ctx);
+      return kk_aio_resolved(err, kk_string_box(kk_string_empty()), ctx);
+    }
+    kk_aio_op_t* op = (kk_aio_op_t*)kk_zalloc(kk_ssizeof(kk_aio_op_t), ctx);
+    op->is_read = true;
+    op->fd      = f;
+    op->len     = len;
+    op->buf     = kk_bytes_alloc_buf(len, &op->cbuf, ctx);
+    op->promise = kk_promise_alloc(ctx);
+    kk_promise_t pr = kk_box_dup(op->promise);
+    if (kk_aio_submit(op)) {
+      kk_string_drop(path2, ctx);
+      return pr;
+    }
+    // ring full: undo and fall back
+    kk_posix_close(f);
+    kk_bytes_drop(op->buf, ctx);
+    kk_box_drop(op->promise, ctx);
+    kk_box_drop(pr, ctx);
+    kk_free(op, ctx);
+    return kk_aio_schedule_read(path2, ctx);
+  }
+#endif
+  return kk_aio_schedule_read(path, ctx);
+}
+
+kk_decl_export kk_promise_t kk_os_write_text_file_async(kk_string_t path, kk_string_t content, kk_context_t* ctx) {
+#ifdef KK_HAS_IO_URING
+  pthread_once(&aio_once, &kk_aio_ring_init);
+  if (aio_ring_ok) {
+    kk_string_t path2 = kk_string_dup(path);  // in case we must fall back to the task group
+    kk_file_t f;
+    const int err = kk_posix_open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644, &f, ctx);
+    if (err != 0) {
+      kk_string_drop(path2, ctx);
+      kk_string_drop(content, ctx);
+      return kk_aio_resolved(err, kk_unit_box(kk_Unit), ctx);
+    }
+    kk_aio_op_t* op = (kk_aio_op_t*)kk_zalloc(kk_ssizeof(kk_aio_op_t), ctx);
+    op->is_read = false;
+    op->fd      = f;
+    op->content = content;
+    op->cbuf    = (uint8_t*)kk_string_buf_borrow(content, &op->len);
+    op->promise = kk_promise_alloc(ctx);
+    kk_promise_t pr = kk_box_dup(op->promise);
+    if (kk_aio_submit(op)) {
+      kk_string_drop(path2, ctx);
+      return pr;
+    }
+    // ring full: undo and fall back
+    kk_posix_close(f);
+    kk_box_drop(op->promise, ctx);
+    kk_box_drop(pr, ctx);
+    kk_string_t content2 = op->content;
+    kk_free(op, ctx);
+    return kk_aio_schedule_write(path2, content2, ctx);
+  }
+#endif
+  return kk_aio_schedule_write(path, content, ctx);
+}
+
+
+/*--------------------------------------------------------------------------------------------------
+  Streaming file reader
+  Read a file incrementally in bounded chunks so arbitrarily large files can be folded over
+  without materializing them. Chunks are split on utf-8 boundaries: a trailing partial
+  sequence is held back and prefixed to the next chunk so each chunk is valid on its own.
+--------------------------------------------------------------------------------------------------*/
+
+#define KK_FREADER_DEFAULT_CHUNK  (64*1024)
+#define KK_FREADER_MIN_CHUNK      (256)
+
+typedef struct kk_freader_s {
+  kk_file_t  fd;
+  kk_ssize_t chunk_size;
+  uint8_t    pending[4];      // held back partial utf-8 sequence (at most a lead + 3 continuation bytes)
+  kk_ssize_t pending_count;
+  bool       eof;
+} kk_freader_t;
+
+// free function for the raw pointer box; closes the file if the reader is dropped without an explicit close
+static void kk_freader_free(void* vp, kk_block_t* b, kk_context_t* ctx) {
+  kk_unused(b);
+  kk_freader_t* rd = (kk_freader_t*)vp;
+  if (rd->fd >= 0) { kk_posix_close(rd->fd); }
+  kk_free(rd, ctx);
+}
+
+// expected length of a utf-8 sequence from its lead byte; 1 for invalid bytes so they pass through as-is
+static kk_ssize_t kk_utf8_lead_len(uint8_t c) {
+  if (c < 0x80)         return 1;
+  if ((c >> 5) == 0x06) return 2;
+  if ((c >> 4) == 0x0E) return 3;
+  if ((c >> 3) == 0x1E) return 4;
+  return 1;
+}
+
+kk_decl_export int kk_os_freader_open(kk_string_t path, kk_ssize_t chunk_size, kk_box_t* reader, kk_context_t* ctx) {
+  kk_file_t f;
+  const int err = kk_posix_open(path, O_RDONLY, 0, &f, ctx);
+  if (err != 0) return err;
+  if (chunk_size <= 0) { chunk_size = KK_FREADER_DEFAULT_CHUNK; }
+  else if (chunk_size < KK_FREADER_MIN_CHUNK) { chunk_size = KK_FREADER_MIN_CHUNK; }
+  kk_freader_t* rd = (kk_freader_t*)kk_zalloc(kk_ssizeof(kk_freader_t), ctx);
+  rd->fd = f;
+  rd->chunk_size = chunk_size;
+  *reader = kk_cptr_raw_box(&kk_freader_free, rd, ctx);
+  return 0;
+}
+
+// Read the next chunk; a chunk of length 0 signals the end of the file.
+kk_decl_export int kk_os_freader_next(kk_box_t reader, kk_bytes_t* chunk, kk_context_t* ctx) {
+  kk_freader_t* rd = (kk_freader_t*)kk_cptr_raw_unbox(reader);
+  if (rd->fd < 0 || (rd->eof && rd->pending_count == 0)) {
+    *chunk = kk_bytes_empty();
+    kk_box_drop(reader, ctx);
+    return 0;
+  }
+  uint8_t* cbuf;
+  kk_bytes_t buf = kk_bytes_alloc_buf(rd->chunk_size, &cbuf, ctx);
+  kk_ssize_t have = rd->pending_count;
+  if (have > 0) {
+    kk_memcpy(cbuf, rd->pending, have);
+    rd->pending_count = 0;
+  }
+  if (!rd->eof) {
+    kk_ssize_t nread = 0;
+    const int err = kk_posix_read_retry(rd->fd, cbuf + have, rd->chunk_size - have, &nread);
+    if (err != 0) {
+      kk_bytes_drop(buf, ctx);
+      kk_box_drop(reader, ctx);
+      return err;
+    }
+    if (nread < rd->chunk_size - have) { rd->eof = true; }
+    have += nread;
+  }
+  if (!rd->eof && have > 0) {
+    // hold back a trailing partial utf-8 sequence (at the end of the file we flush it as-is)
+    kk_ssize_t k = 0;  // number of trailing continuation bytes
+    while (k < 3 && k < have && kk_utf8_is_cont(cbuf[have - 1 - k])) { k++; }
+    const kk_ssize_t lead = have - 1 - k;
+    if (lead >= 0 && lead + kk_utf8_lead_len(cbuf[lead]) > have) {
+      rd->pending_count = have - lead;
+      kk_memcpy(rd->pending, cbuf + lead, rd->pending_count);
+      have = lead;
+    }
+  }
+  if (have < rd->chunk_size) { buf = kk_bytes_adjust_length(buf, have, ctx); }
+  *chunk = buf;
+  kk_box_drop(reader, ctx);
+  return 0;
+}
+
+kk_decl_export void kk_os_freader_close(kk_box_t reader, kk_context_t* ctx) {
+  kk_freader_t* rd = (kk_freader_t*)kk_cptr_raw_unbox(reader);
+  if (rd->fd >= 0) {
+    kk_posix_close(rd->fd);
+    rd->fd = -1;
+  }
+  rd->eof = true;
+  rd->pending_count = 0;
+  kk_box_drop(reader, ctx);
+}
+
+
+/*--------------------------------------------------------------------------------------------------
+  Buffered line reader
+  Line-by-line consumption of stdin or a file used to pay a small read plus a string copy
+  per line which made filter programs over large piped inputs an order of magnitude slower
+  than necessary. The reader fills a large buffer per system call and scans it with
+  `memchr`; long (valid utf-8) lines are returned as zero-copy views into the buffer (the
+  newline byte is overwritten with a terminator so a view stays zero-terminated) while
+  short or invalid lines are copied. Each refill starts a fresh buffer block so views into
+  the previous block simply keep it alive until they are dropped.
+--------------------------------------------------------------------------------------------------*/
+
+#define KK_LREADER_DEFAULT_BUFSIZE  (KK_IZ(1024)*1024)
+#define KK_LREADER_MIN_BUFSIZE      (KK_IZ(4)*1024)
+#define KK_LREADER_VIEW_MIN         (64)       // copy lines shorter than this instead of pinning the buffer
+
+typedef struct kk_lreader_s {
+  kk_file_t  fd;
+  bool       owns_fd;      // false for the stdin reader
+  bool       eof;
+  kk_bytes_t buf;          // refcounted storage; long lines are views into it
+  kk_ssize_t pos;          // scan position
+  kk_ssize_t end;          // valid bytes; at most the buffer length - 1 (one byte is reserved for a terminator)
+  kk_ssize_t buf_size;
+} kk_lreader_t;
+
+// Read once up to `buflen` bytes. Unlike `kk_posix_read_retry` this does not wait for a
+// full buffer, so a line is returned as soon as a pipe (or terminal) delivers it.
+static int kk_posix_read_once(const kk_file_t inp, uint8_t* buf, const kk_ssize_t buflen, kk_ssize_t* read_count) {
+  kk_ssize_t n;
+  do {
+    #ifdef WIN32
+    n = _read(inp, buf, (unsigned)(buflen > INT32_MAX ? INT32_MAX : buflen));
+    #else
+    n = read(inp, buf, buflen);
+    #endif
+  } while (n < 0 && (errno == EAGAIN || errno == EINTR));
+  if (n < 0) { *read_count = 0; return errno; }
+  *read_count = n;
+  return 0;
+}
+
+static void kk_lreader_free(void* vp, kk_block_t* b, kk_context_t* ctx) {
+  kk_unused(b);
+  kk_lreader_t* rd = (kk_lreader_t*)vp;
+  if (rd->owns_fd && rd->fd >= 0) { kk_posix_close(rd->fd); }
+  kk_bytes_drop(rd->buf, ctx);
+  kk_free(rd, ctx);
+}
+
+static kk_box_t kk_lreader_alloc(kk_file_t fd, bool owns_fd, kk_ssize_t buf_size, kk_context_t* ctx) {
+  if (buf_size <= 0) { buf_size = KK_LREADER_DEFAULT_BUFSIZE; }
+  else if (buf_size < KK_LREADER_MIN_BUFSIZE) { buf_size = KK_LREADER_MIN_BUFSIZE; }
+  kk_lreader_t* rd = (kk_lreader_t*)kk_zalloc(kk_ssizeof(kk_lreader_t), ctx);
+  rd->fd = fd;
+  rd->owns_fd = owns_fd;
+  rd->buf = kk_bytes_empty();
+  rd->buf_size = buf_size;
+  return kk_cptr_raw_box(&kk_lreader_free, rd, ctx);
+}
+
+// Refill with a fresh buffer block, carrying over an unterminated partial line.
+static int kk_lreader_refill(kk_lreader_t* rd, kk_context_t* ctx) {
+  const kk_ssize_t leftover = rd->end - rd->pos;
+  if (leftover >= rd->buf_size - 1) { rd->buf_size *= 2; }  // a line longer than the buffer: grow
+  uint8_t* cbuf;
+  kk_bytes_t buf = kk_bytes_alloc_buf(rd->buf_size, &cbuf, ctx);
+  if (leftover > 0) {
+    kk_ssize_t len;
+    const uint8_t* old = kk_bytes_buf_borrow(rd->buf, &len);
+    kk_memcpy(cbuf, old + rd->pos, leftover);
+  }
+  kk_bytes_drop(rd->buf, ctx);
+  rd->buf = buf;
+  rd->pos = 0;
+  rd->end = leftover;
+  kk_ssize_t nread = 0;
+  const int err = kk_posix_read_once(rd->fd, cbuf + leftover, rd->buf_size - 1 - leftover, &nread);
+  if (err != 0) return err;
+  if (nread == 0) { rd->eof = true; }
+  rd->end += nread;
+  return 0;
+}
+
+// Emit the line from `pos` up to (exclusive) `lend`; `cbuf[lend]` is a newline,
+// carriage return, or the reserved byte past the end and is overwritten with the
+// terminator that keeps a view zero-terminated.
+static kk_string_t kk_lreader_emit(kk_lreader_t* rd, uint8_t* cbuf, kk_ssize_t lend, kk_context_t* ctx) {
+  const kk_ssize_t len = lend - rd->pos;
+  cbuf[lend] = 0;
+  if (len >= KK_LREADER_VIEW_MIN && kk_utf8_is_validn(len, cbuf + rd->pos)) {
+    return kk_unsafe_bytes_as_string_unchecked(kk_bytes_view(kk_bytes_dup(rd->buf), rd->pos, len, ctx));
+  }
+  return kk_string_alloc_from_qutf8n(len, (const char*)cbuf + rd->pos, ctx);
+}
+
+static int kk_lreader_line(kk_lreader_t* rd, kk_string_t* line, bool* has_line, kk_context_t* ctx) {
+  *line = kk_string_empty();
+  *has_line = false;
+  while (true) {
+    kk_ssize_t len;
+    uint8_t* cbuf = (uint8_t*)kk_bytes_buf_borrow(rd->buf, &len);  // we own the storage past the scanned views
+    if (rd->end > rd->pos) {
+      const uint8_t* p = (const uint8_t*)memchr(cbuf + rd->pos, '\n', rd->end - rd->pos);
+      if (p != NULL) {
+        kk_ssize_t lend = (kk_ssize_t)(p - cbuf);
+        const kk_ssize_t next = lend + 1;
+        if (lend > rd->pos && cbuf[lend-1] == '\r') { lend--; }   // crlf
+        *line = kk_lreader_emit(rd, cbuf, lend, ctx);
+        rd->pos = next;
+        *has_line = true;
+        return 0;
+      }
+    }
+    if (rd->eof) {
+      if (rd->end > rd->pos) {  // a final line without a newline
+        *line = kk_lreader_emit(rd, cbuf, rd->end, ctx);
+        rd->pos = rd->end;
+        *has_line = true;
+      }
+      return 0;
+    }
+    const int err = kk_lreader_refill(rd, ctx);
+    if (err != 0) return err;
+  }
+}
+
+kk_decl_export int kk_os_lreader_open(kk_string_t path, kk_ssize_t buf_size, kk_box_t* reader, kk_context_t* ctx) {
+  kk_file_t f;
+  const int err = kk_posix_open(path, O_RDONLY, 0, &f, ctx);
+  if (err != 0) return err;
+  *reader = kk_lreader_alloc(f, true, buf_size, ctx);
+  return 0;
+}
+
+kk_decl_export kk_box_t kk_os_lreader_stdin(kk_ssize_t buf_size, kk_context_t* ctx) {
+  #ifdef WIN32
+  const kk_file_t f = _fileno(stdin);
+  #else
+  const kk_file_t f = STDIN_FILENO;
+  #endif
+  return kk_lreader_alloc(f, false, buf_size, ctx);
+}
+
+kk_decl_export int kk_os_lreader_read_line(kk_box_t reader, kk_string_t* line, bool* has_line, kk_context_t* ctx) {
+  kk_lreader_t* rd = (kk_lreader_t*)kk_cptr_raw_unbox(reader);
+  const int err = kk_lreader_line(rd, line, has_line, ctx);
+  kk_box_drop(reader, ctx);
+  return err;
+}
+
+// Read up to `max_lines` lines in one call; an empty vector signals the end of the input.
+// Lines already scanned are returned even if a read error occurs; the error surfaces on
+// the next call.
+kk_decl_export int kk_os_lreader_read_lines(kk_box_t reader, kk_ssize_t max_lines, kk_vector_t* lines, kk_context_t* ctx) {
+  kk_lreader_t* rd = (kk_lreader_t*)kk_cptr_raw_unbox(reader);
+  if (max_lines <= 0) { max_lines = 1; }
+  else if (max_lines > KK_IZ(64)*1024) { max_lines = KK_IZ(64)*1024; }  // bound the batch allocation
+  kk_box_t* entries = (kk_box_t*)kk_malloc(max_lines * kk_ssizeof(kk_box_t), ctx);
+  kk_ssize_t n = 0;
+  int err = 0;
+  while (n < max_lines) {
+    kk_string_t line;
+    bool has_line;
+    err = kk_lreader_line(rd, &line, &has_line, ctx);
+    if (err != 0 || !has_line) break;
+    entries[n++] = kk_string_box(line);
+  }
+  if (err != 0 && n == 0) {
+    kk_free(entries, ctx);
+    kk_box_drop(reader, ctx);
+    return err;
+  }
+  kk_box_t* vbuf;
+  *lines = kk_vector_alloc_uninit(n, &vbuf, ctx);
+  for (kk_ssize_t i = 0; i < n; i++) { vbuf[i] = entries[i]; }
+  kk_free(entries, ctx);
+  kk_box_drop(reader, ctx);
+  return 0;
+}
+
+kk_decl_export void kk_os_lreader_close(kk_box_t reader, kk_context_t* ctx) {
+  kk_lreader_t* rd = (kk_lreader_t*)kk_cptr_raw_unbox(reader);
+  if (rd->owns_fd && rd->fd >= 0) {
+    kk_posix_close(rd->fd);
+    rd->fd = -1;
+  }
+  rd->eof = true;
+  rd->pos = rd->end;
+  kk_box_drop(reader, ctx);
+}
+
+
 /*--------------------------------------------------------------------------------------------------
   Read line
 --------------------------------------------------------------------------------------------------*/
 
+// lazily created buffered reader over stdin (reads ahead, unlike the old fgets loop)
+static kk_lreader_t* kk_stdin_reader;
+
 kk_decl_export int kk_os_read_line(kk_string_t* result, kk_context_t* ctx)
 {
-  char buf[1024];
-  if (fgets(buf, 1023, stdin) == NULL) return errno;
-  buf[1023] = 0;      // ensure zero termination
-  const size_t len = strlen(buf);
-  if (len > 0 && buf[len-1] == '\n') {
-    buf[len-1] = 0;   // remove possible ending newline character
-  }
-  *result = kk_string_alloc_from_qutf8(buf, ctx);
+  if (kk_stdin_reader == NULL) {
+    kk_stdin_reader = (kk_lreader_t*)kk_cptr_raw_unbox(kk_os_lreader_stdin(0, ctx));
+  }
+  bool has_line;
+  const int err = kk_lreader_line(kk_stdin_reader, result, &has_line, ctx);
+  if (err != 0) return err;
+  if (!has_line) return EIO;  // signal the end of the input as an error (as the fgets loop did)
   return 0;
 }
 
@@ -339,11 +1364,18 @@ kk_decl_export int kk_os_copy_file(kk_string_t from, kk_string_t to, bool preser
   int err = 0;
   kk_with_string_as_qutf16w_borrow(from, wfrom, ctx) {
     kk_with_string_as_qutf16w_borrow(to, wto, ctx) {
-      if (!CopyFileW(wfrom, wto, FALSE)) {
+      BOOL ok = CopyFileExW(wfrom, wto, NULL, NULL, NULL, 0);
+      if (!ok && GetLastError() == ERROR_ENCRYPTION_FAILED) {
+        // copying an efs encrypted file to a destination that cannot keep it encrypted
+        ok = CopyFileExW(wfrom, wto, NULL, NULL, NULL, COPY_FILE_ALLOW_DECRYPTED_DESTINATION);
+      }
+      if (!ok) {
         DWORD werr = GetLastError();
         if (werr == ERROR_FILE_NOT_FOUND) err = ENOENT;
         else if (werr == ERROR_ACCESS_DENIED) err = EPERM;
         else if (werr == ERROR_PATH_NOT_FOUND) err = ENOTDIR;
+        else if (werr == ERROR_SHARING_VIOLATION) err = EBUSY;
+        else if (werr == ERROR_DISK_FULL) err = ENOSPC;
         else err = EINVAL;
       }
     }
@@ -358,21 +1390,49 @@ kk_decl_export int kk_os_copy_file(kk_string_t from, kk_string_t to, bool preser
 #include <copyfile.h>
 
 #else
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#if defined(__has_include)
+#if __has_include(<linux/fs.h>)
+#include <linux/fs.h>       // FICLONE
+#endif
+#endif
+#endif
+
 static int kk_posix_copy_file(const int inp, const int out, const kk_ssize_t estimated_len, kk_context_t* ctx) {
   int err = 0;
 
-#if defined(COPY_FR_COPY)
-  // try copy_file_range first
-  if (estimated_len > 0 && estimated_len < KK_SSIZE_MAX) {  // non-regular files can report zero length but can be read anyways
-    loff_t off_in = 0;
-    loff_t off_out = 0;
-    if (copy_file_range(inp, &off_in, out, &off_out, KK_SSIZE_MAX, 0 /* flags */) < 0) {
-      err = errno;
-    };
-    if (err != EINVAL) return err;
-    // fall through if `copy_file_range` failed immediately with `EINVAL` (might be a non-seekable device?)
-    err = 0;
-  }  
+#if defined(__linux__) && defined(FICLONE)
+  // try a reflink clone first: instant, and CoW file systems (btrfs, xfs) share
+  // the extents instead of duplicating them
+  if (ioctl(out, FICLONE, inp) == 0) return 0;
+  // otherwise fall through (EOPNOTSUPP/EXDEV/EINVAL when cloning is not possible)
+#endif
+
+#if defined(__linux__) && defined(SYS_copy_file_range)
+  // in-kernel copy without bouncing the data through a user-space buffer.
+  // We use a syscall directly (as with `getrandom` in `random.c`) so we do not
+  // depend on the libc version; on ENOSYS we fall back to the loop below for good.
+  {
+    static volatile uintptr_t no_copy_file_range; // = 0
+    if (no_copy_file_range == 0) {
+      while (true) {
+        const kk_ssize_t n = (kk_ssize_t)syscall(SYS_copy_file_range, inp, NULL, out, NULL, (size_t)(KK_I32(1) << 30), 0);
+        if (n == 0) return 0;   // EOF: everything is copied
+        if (n < 0) {
+          err = errno;
+          if (err == ENOSYS) { no_copy_file_range = 1; }
+          if (err == ENOSYS || err == EINVAL || err == EXDEV || err == EOPNOTSUPP || err == EBADF) {
+            // not supported here; the read/write loop below continues from the current file offsets
+            err = 0;
+            break;
+          }
+          return err;
+        }
+      }
+    }
+  }
 #endif
 
   kk_ssize_t buflen = 1024 * 1024; // max 1MiB buffer
@@ -503,6 +1563,9 @@ static kk_string_t os_direntry_name(dir_entry* entry, kk_context_t* ctx) {
     return kk_string_alloc_from_qutf16w( entry->name, ctx);
   }
 }
+static int os_direntry_kind(dir_entry* entry) {
+  return ((entry->attrib & _A_SUBDIR) != 0 ? KK_DIRENT_DIR : KK_DIRENT_FILE);
+}
 
 #else
 #include <sys/types.h>
@@ -510,8 +1573,9 @@ static kk_string_t os_direntry_name(dir_entry* entry, kk_context_t* ctx) {
 #define dir_cursor DIR*
 #define dir_entry  struct dirent*
 static bool os_findnext(dir_cursor d, dir_entry* entry, int* err) {
+  errno = 0;  // `readdir` leaves `errno` untouched at the end of the directory
   *entry = readdir(d);
-  *err = (*entry != NULL || errno == ENOENT ? 0 : errno);
+  *err = (*entry != NULL || errno == 0 || errno == ENOENT ? 0 : errno);
   return (*entry != NULL);
 }
 static bool os_findfirst(kk_string_t path, dir_cursor* d, dir_entry* entry, int* err, kk_context_t* ctx) {
@@ -538,6 +1602,19 @@ static kk_string_t os_direntry_name(dir_entry* entry, kk_context_t* ctx) {
     return kk_string_alloc_from_qutf8(dname, ctx);
   }
 }
+static int os_direntry_kind(dir_entry* entry) {
+#if defined(DT_DIR)
+  switch ((*entry)->d_type) {
+    case DT_REG: return KK_DIRENT_FILE;
+    case DT_DIR: return KK_DIRENT_DIR;
+    case DT_LNK: return KK_DIRENT_SYMLINK;
+    default:     return KK_DIRENT_UNKNOWN;  // `DT_UNKNOWN`, or a special file; callers can `stat` if they need more
+  }
+#else
+  kk_unused(entry);
+  return KK_DIRENT_UNKNOWN;
+#endif
+}
 #endif
 
 kk_decl_export int kk_os_list_directory(kk_string_t dir, kk_vector_t* contents, kk_context_t* ctx) {
@@ -574,15 +1651,89 @@ kk_decl_export int kk_os_list_directory(kk_string_t dir, kk_vector_t* contents,
 
   if(count != len) {
     *contents = kk_vector_realloc(vec, count, kk_box_null, ctx);
-  } 
+  }
   return err;
 }
 
 
+/*--------------------------------------------------------------------------------------------------
+  Streaming directory traversal
+  Iterate over directory entries one at a time instead of materializing the full listing,
+  so recursive walks over large trees run in constant memory (one open cursor per nesting
+  level). Each entry carries the kind the directory stream itself reports so no extra
+  `stat` call per entry is needed when the file system provides it.
+--------------------------------------------------------------------------------------------------*/
+
+typedef struct kk_diriter_s {
+  dir_cursor d;
+  dir_entry  entry;      // one entry of look-ahead as `os_findfirst` already reads the first entry
+  bool       open;       // the cursor is valid (and needs a close)
+  bool       has_entry;  // the look-ahead entry is valid
+} kk_diriter_t;
+
+// free function for the raw pointer box; closes the cursor if the iterator is dropped without an explicit close
+static void kk_diriter_free(void* vp, kk_block_t* b, kk_context_t* ctx) {
+  kk_unused(b);
+  kk_diriter_t* it = (kk_diriter_t*)vp;
+  if (it->open) { os_findclose(it->d); }
+  kk_free(it, ctx);
+}
+
+kk_decl_export int kk_os_diriter_open(kk_string_t dir, kk_box_t* iter, kk_context_t* ctx) {
+  kk_diriter_t* it = (kk_diriter_t*)kk_zalloc(kk_ssizeof(kk_diriter_t), ctx);
+  int err = 0;
+  it->has_entry = os_findfirst(dir, &it->d, &it->entry, &err, ctx);
+  if (!it->has_entry && err != 0) {
+    kk_free(it, ctx);
+    return err;
+  }
+  it->open = true;
+  *iter = kk_cptr_raw_box(&kk_diriter_free, it, ctx);
+  return 0;
+}
+
+// Read the next entry (excluding `.` and `..`); an empty name signals the end of the
+// directory. The `kind` is one of the `KK_DIRENT_` constants (`KK_DIRENT_UNKNOWN`
+// if the directory stream does not report one).
+kk_decl_export int kk_os_diriter_next(kk_box_t iter, kk_string_t* name, int* kind, kk_context_t* ctx) {
+  kk_diriter_t* it = (kk_diriter_t*)kk_cptr_raw_unbox(iter);
+  *kind = KK_DIRENT_UNKNOWN;
+  int err = 0;
+  while (it->open && it->has_entry) {
+    kk_string_t nm = os_direntry_name(&it->entry, ctx);
+    const int knd = os_direntry_kind(&it->entry);
+    it->has_entry = os_findnext(it->d, &it->entry, &err);
+    if (!kk_string_is_empty_borrow(nm)) {  // `os_direntry_name` filters `.` and `..`
+      *name = nm;
+      *kind = knd;
+      kk_box_drop(iter, ctx);
+      return 0;
+    }
+    kk_string_drop(nm, ctx); // no-op as it is always empty
+    if (err != 0) break;
+  }
+  *name = kk_string_empty();
+  kk_box_drop(iter, ctx);
+  return err;
+}
+
+kk_decl_export void kk_os_diriter_close(kk_box_t iter, kk_context_t* ctx) {
+  kk_diriter_t* it = (kk_diriter_t*)kk_cptr_raw_unbox(iter);
+  if (it->open) {
+    os_findclose(it->d);
+    it->open = false;
+  }
+  it->has_entry = false;
+  kk_box_drop(iter, ctx);
+}
+
+
 /*--------------------------------------------------------------------------------------------------
   Run system command
 --------------------------------------------------------------------------------------------------*/
 
+#define KK_RUN_COMMAND_BUFSIZE  (64*1024)
+
 kk_decl_export int kk_os_run_command(kk_string_t cmd, kk_string_t* output, kk_context_t* ctx) {
   FILE* f = NULL;
 #if defined(WIN32)
@@ -596,20 +1747,30 @@ kk_decl_export int kk_os_run_command(kk_string_t cmd, kk_string_t* output, kk_co
 #endif
   kk_string_drop(cmd, ctx);
   if (f == NULL) return errno;
-  kk_string_t out = kk_string_empty();
-  char buf[1025];
-  while (fgets(buf, 1024, f) != NULL) {
-    buf[1024] = 0; // paranoia
-    out = kk_string_cat(out, kk_string_alloc_from_qutf8(buf,ctx), ctx);  // todo: avoid allocation
+  setvbuf(f, NULL, _IONBF, 0);  // we read in large chunks ourselves; skip the stdio copy
+  kk_bytes_builder_t bb;
+  kk_bytes_builder_init(&bb);
+  int err = 0;
+  for (;;) {
+    uint8_t* p = kk_bytes_builder_reserve(&bb, KK_RUN_COMMAND_BUFSIZE, ctx);
+    const size_t nread = fread(p, 1, KK_RUN_COMMAND_BUFSIZE, f);
+    kk_bytes_builder_commit(&bb, (kk_ssize_t)nread);
+    if (nread < KK_RUN_COMMAND_BUFSIZE) {
+      if (ferror(f)) { err = errno; }
+      break;
+    }
   }
-  if (feof(f)) errno = 0;
 #if defined(WIN32)
   _pclose(f);
 #else
   pclose(f);
 #endif
-  *output = out;
-  return errno;
+  if (err != 0) {
+    kk_bytes_builder_clear(&bb, ctx);
+    return err;
+  }
+  *output = kk_string_convert_from_qutf8(kk_bytes_builder_done(&bb, ctx), ctx);
+  return 0;
 }
 
 kk_decl_export int kk_os_run_system(kk_string_t cmd, kk_context_t* ctx) {
@@ -628,6 +1789,193 @@ kk_decl_export int kk_os_run_system(kk_string_t cmd, kk_context_t* ctx) {
 }
 
 
+/*--------------------------------------------------------------------------------------------------
+  Async system commands
+  Run many commands concurrently without dedicating a blocked thread to each: a single
+  supervisor thread polls the output pipes of all in-flight children and drains whatever
+  is readable into a per-child bytes builder; when a pipe reaches eof the child's promise
+  is resolved with its output (await with `kk_os_aio_await`). On Windows (or if the
+  supervisor cannot start) the blocking read runs on the i/o task group instead.
+--------------------------------------------------------------------------------------------------*/
+
+// fallback: run the blocking command on the i/o task group
+struct kk_aio_run_fun_s {
+  struct kk_function_s _base;
+  kk_box_t cmd;
+};
+
+static kk_box_t kk_aio_run_fun(kk_function_t fself, kk_context_t* ctx) {
+  struct kk_aio_run_fun_s* self = kk_function_as(struct kk_aio_run_fun_s*, fself);
+  kk_string_t cmd = kk_string_unbox(kk_box_dup(self->cmd));
+  kk_function_drop(fself, ctx);
+  kk_string_t output = kk_string_empty();
+  const int err = kk_os_run_command(cmd, &output, ctx);
+  return kk_aio_result_box(err, kk_string_box(output), ctx);
+}
+
+static kk_promise_t kk_aio_schedule_run(kk_string_t cmd, kk_context_t* ctx) {
+  struct kk_aio_run_fun_s* f = kk_function_alloc_as(struct kk_aio_run_fun_s, 2, ctx);
+  f->_base.fun = kk_cfun_ptr_box(&kk_aio_run_fun, ctx);
+  f->cmd = kk_string_box(cmd);
+  return kk_io_task_schedule(&f->_base, ctx);
+}
+
+#if !defined(WIN32)
+#include <poll.h>
+#include <pthread.h>
+
+// One in-flight child; owned by the supervisor thread once registered.
+typedef struct kk_proc_s {
+  struct kk_proc_s*  next;
+  FILE*              f;        // from `popen`; `pclose` reaps the child
+  int                fd;       // `fileno(f)`, set non-blocking
+  kk_bytes_builder_t output;
+  kk_promise_t       promise;  // resolved with an (errno,output) pair at eof
+} kk_proc_t;
+
+static pthread_mutex_t proc_lock = PTHREAD_MUTEX_INITIALIZER;
+static kk_proc_t*      proc_pending = NULL;  // newly registered; picked up on the next wake
+static int             proc_wake[2] = { -1, -1 };  // self-pipe to interrupt the poll
+static pthread_once_t  proc_once = PTHREAD_ONCE_INIT;
+static bool            proc_supervisor_ok = false;
+
+// Drain a readable pipe; returns `true` (with `*err` set, 0 at eof) when the child is done.
+static bool kk_proc_drain(kk_proc_t* p, int* err, kk_context_t* ctx) {
+  for (;;) {
+    uint8_t* buf = kk_bytes_builder_reserve(&p->output, KK_RUN_COMMAND_BUFSIZE, ctx);
+    const kk_ssize_t n = read(p->fd, buf, KK_RUN_COMMAND_BUFSIZE);
+    if (n > 0) {
+      kk_bytes_builder_commit(&p->output, n);
+    }
+    else if (n == 0) {
+      *err = 0; return true;   // eof: the child closed its output
+    }
+    else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return false;            // drained for now; poll again
+    }
+    else if (errno != EINTR) {
+      *err = errno; return true;
+    }
+  }
+}
+
+static void kk_proc_complete(kk_proc_t* p, int err, kk_context_t* ctx) {
+  pclose(p->f);  // reap the child; normally immediate once its output end is closed
+  kk_box_t output;
+  if (err != 0) {
+    kk_bytes_builder_clear(&p->output, ctx);
+    output = kk_string_box(kk_string_empty());
+  }
+  else {
+    output = kk_string_box(kk_string_convert_from_qutf8(kk_bytes_builder_done(&p->output, ctx), ctx));
+  }
+  kk_promise_set(p->promise, kk_aio_result_box(err, output, ctx), ctx);
+  kk_free(p, ctx);
+}
+
+static void* kk_proc_supervisor_thread(void* arg) {
+  kk_unused(arg);
+  kk_context_t* ctx = kk_get_context();
+  kk_proc_t* procs = NULL;
+  kk_ssize_t count = 0;
+  kk_ssize_t fds_len = 0;
+  struct pollfd* fds = NULL;
+  while (true) {
+    // pick up newly registered children
+    pthread_mutex_lock(&proc_lock);
+    while (proc_pending != NULL) {
+      kk_proc_t* p = proc_pending;
+      proc_pending = p->next;
+      p->next = procs;
+      procs = p;
+      count++;
+    }
+    pthread_mutex_unlock(&proc_lock);
+    if (count + 1 > fds_len) {
+      fds_len = 2*(count + 1);
+      fds = (struct pollfd*)kk_realloc(fds, fds_len * kk_ssizeof(struct pollfd), ctx);
+    }
+    fds[0].fd = proc_wake[0];
+    fds[0].events = POLLIN;
+    kk_ssize_t i = 1;
+    for (kk_proc_t* p = procs; p != NULL; p = p->next, i++) {
+      fds[i].fd = p->fd;
+      fds[i].events = POLLIN;
+    }
+    if (poll(fds, (nfds_t)(count + 1), -1) < 0) {
+      if (errno == EINTR) continue;
+      break;  // should not happen; give up rather than spin
+    }
+    if ((fds[0].revents & POLLIN) != 0) {  // drain wake tokens
+      uint8_t tmp[64];
+      while (read(proc_wake[0], tmp, sizeof(tmp)) > 0) { }
+    }
+    i = 1;
+    kk_proc_t** prev = &procs;
+    for (kk_proc_t* p = *prev; p != NULL; p = *prev, i++) {
+      int err = 0;
+      if (fds[i].revents != 0 && kk_proc_drain(p, &err, ctx)) {
+        *prev = p->next;
+        count--;
+        kk_proc_complete(p, err, ctx);
+      }
+      else {
+        prev = &p->next;
+      }
+    }
+  }
+  kk_free(fds, ctx);
+  kk_free_context();
+  return NULL;
+}
+
+static void kk_proc_supervisor_init(void) {
+  if (pipe(proc_wake) != 0) return;
+  fcntl(proc_wake[0], F_SETFL, fcntl(proc_wake[0], F_GETFL, 0) | O_NONBLOCK);
+  pthread_t tid;
+  if (pthread_create(&tid, NULL, &kk_proc_supervisor_thread, NULL) == 0) {
+    pthread_detach(tid);
+    proc_supervisor_ok = true;
+  }
+}
+#endif  // !WIN32
+
+// Start a command without blocking; the returned promise resolves with its output.
+kk_decl_export kk_promise_t kk_os_run_command_async(kk_string_t cmd, kk_context_t* ctx) {
+#if defined(WIN32)
+  return kk_aio_schedule_run(cmd, ctx);
+#else
+  pthread_once(&proc_once, &kk_proc_supervisor_init);
+  if (!proc_supervisor_ok) return kk_aio_schedule_run(cmd, ctx);
+  FILE* f = NULL;
+  kk_with_string_as_qutf8_borrow(cmd, ccmd, ctx) {
+    f = popen(ccmd, "r");
+  }
+  kk_string_drop(cmd, ctx);
+  if (f == NULL) {
+    kk_promise_t pr = kk_promise_alloc(ctx);
+    kk_promise_set(kk_box_dup(pr), kk_aio_result_box(errno, kk_string_box(kk_string_empty()), ctx), ctx);
+    return pr;
+  }
+  const int fd = fileno(f);
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  kk_proc_t* p = (kk_proc_t*)kk_zalloc(kk_ssizeof(kk_proc_t), ctx);
+  p->f = f;
+  p->fd = fd;
+  kk_bytes_builder_init(&p->output);
+  kk_promise_t pr = kk_promise_alloc(ctx);
+  p->promise = kk_box_dup(pr);
+  pthread_mutex_lock(&proc_lock);
+  p->next = proc_pending;
+  proc_pending = p;
+  pthread_mutex_unlock(&proc_lock);
+  const uint8_t token = 1;
+  if (write(proc_wake[1], &token, 1) < 0) { } // the supervisor wakes on the next event anyway
+  return pr;
+#endif
+}
+
+
 
 /*--------------------------------------------------------------------------------------------------
   Args
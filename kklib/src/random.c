@@ -14,12 +14,6 @@
   Deterministic pseudo random number generation. Fast but not secure.
 ----------------------------------------------------------- */
 
-// pseudo random number context (using pcg)
-typedef struct kk_pcg_ctx_s {
-  uint64_t state;
-  uint64_t stream; // must be odd
-} kk_pcg_ctx_t;
-
 // Pseudo random number using PCG by Melissa E. O'Neill.
 // It combines a linear congruential generator (CG) with an output permutation
 // function (P) and has good statictical properties (and passes PractRand and Big-crush[2]).
@@ -28,7 +22,7 @@ typedef struct kk_pcg_ctx_s {
 // of a full 64x64-bit multiply.
 // [1]: https://www.pcg-random.org/posts/critiquing-pcg-streams.html#changing-the-multiplier
 // [2]: https://www.pcg-random.org/pdf/hmc-cs-2014-0905.pdf
-static inline uint32_t pcg_uint32(kk_pcg_ctx_t* rnd) {
+static inline uint32_t pcg_uint32(kk_prandom_t* rnd) {
   const uint64_t state0 = rnd->state;
   rnd->state = (state0 * KK_U64(0x5851F42D4C957F2D)) + rnd->stream;
   const uint32_t x = (uint32_t)(((state0 >> 18) ^ state0) >> 27);
@@ -36,7 +30,7 @@ static inline uint32_t pcg_uint32(kk_pcg_ctx_t* rnd) {
   return kk_bits_rotr32(x, rot);
 }
 
-static void pcg_init(uint64_t init, uint64_t stream, kk_pcg_ctx_t* rnd) {
+static void pcg_init(uint64_t init, uint64_t stream, kk_prandom_t* rnd) {
   rnd->state = 0;
   rnd->stream = (2*stream) | 1; // ensure it is odd
   pcg_uint32(rnd);
@@ -44,6 +38,40 @@ static void pcg_init(uint64_t init, uint64_t stream, kk_pcg_ctx_t* rnd) {
   for (int i = 0; i < 8; i++) { pcg_uint32(rnd); }
 }
 
+/* -----------------------------------------------------------
+  Splittable deterministic prng built on the pcg streams.
+  Splitting derives the child's seed and stream from the parent
+  state only, so a tree of tasks gets reproducible independent
+  streams without any cross-thread state or locking.
+----------------------------------------------------------- */
+
+void kk_prandom_init(kk_prandom_t* rnd, uint64_t seed, uint64_t stream) {
+  pcg_init(seed, stream, rnd);
+}
+
+uint32_t kk_prandom_uint32(kk_prandom_t* rnd) {
+  return pcg_uint32(rnd);
+}
+
+uint64_t kk_prandom_uint64(kk_prandom_t* rnd) {
+  const uint64_t hi = pcg_uint32(rnd);
+  return ((hi << 32) | pcg_uint32(rnd));
+}
+
+// Use 52 random bits to generate a double in the range [0,1)
+double kk_prandom_double(kk_prandom_t* rnd) {
+  const uint64_t x = KK_U64(0x3FF0000000000000) | kk_shr64(kk_prandom_uint64(rnd), 12);
+  return (kk_bits_to_double(x) - 1.0);
+}
+
+void kk_prandom_split(kk_prandom_t* rnd, kk_prandom_t* child) {
+  uint64_t seed = ((uint64_t)pcg_uint32(rnd) << 32);
+  seed |= pcg_uint32(rnd);
+  uint64_t stream = ((uint64_t)pcg_uint32(rnd) << 32);
+  stream |= pcg_uint32(rnd);
+  pcg_init(seed, stream, child);
+}
+
 
 /*
 // pseudo random number context (using sfc32)
@@ -155,6 +183,163 @@ static kk_decl_noinline void kk_chacha20(kk_random_ctx_t* rnd) {
   kk_chacha_block(20, rnd->input, rnd->output);
   rnd->used = 0;
 }
+
+/* ----------------------------------------------------------------------------
+Bulk generation. Counter-mode blocks are independent so we can generate many
+of them per call -- straight into the caller's buffer -- and on x64 with AVX2
+(or on arm64 with NEON) run several blocks in parallel, one block per vector
+lane. Sampling loops that ask for kilobytes at a time then amortize the
+per-call setup over the whole buffer.
+-----------------------------------------------------------------------------*/
+
+static void kk_chacha_blocks_generic(const size_t rounds, uint32_t* input, uint8_t* buf, size_t nblocks) {
+  for (size_t i = 0; i < nblocks; i++) {
+    uint32_t out[16];
+    kk_chacha_block(rounds, input, out);
+    memcpy(buf, out, 64);  // native word order, just as the word-at-a-time api
+    buf += 64;
+  }
+}
+
+#if defined(__AVX2__)
+#define KK_CHACHA_AVX2  (1)
+#define kk_target_avx2
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define KK_CHACHA_AVX2  (1)
+#define kk_target_avx2
+#include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define KK_CHACHA_AVX2  (1)
+#define kk_target_avx2  __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define KK_CHACHA_NEON  (1)
+#include <arm_neon.h>
+#endif
+
+#if defined(KK_CHACHA_AVX2)
+// Eight blocks at a time: each 32-bit lane of a vector holds the same state
+// word of eight consecutive blocks, so the round function vectorizes directly.
+#define KK_VROTL32(v,n)     _mm256_or_si256(_mm256_slli_epi32(v,n), _mm256_srli_epi32(v,32-(n)))
+#define KK_VQROUND(a,b,c,d) \
+  x[a] = _mm256_add_epi32(x[a],x[b]); x[d] = _mm256_shuffle_epi8(_mm256_xor_si256(x[d],x[a]), rot16); \
+  x[c] = _mm256_add_epi32(x[c],x[d]); x[b] = KK_VROTL32(_mm256_xor_si256(x[b],x[c]), 12); \
+  x[a] = _mm256_add_epi32(x[a],x[b]); x[d] = _mm256_shuffle_epi8(_mm256_xor_si256(x[d],x[a]), rot8); \
+  x[c] = _mm256_add_epi32(x[c],x[d]); x[b] = KK_VROTL32(_mm256_xor_si256(x[b],x[c]), 7)
+
+static kk_target_avx2 void kk_chacha_blocks_avx2(const size_t rounds, uint32_t* input, uint8_t* buf, size_t nblocks) {
+  const __m256i rot16 = _mm256_set_epi8(13,12,15,14, 9,8,11,10, 5,4,7,6, 1,0,3,2,
+                                        13,12,15,14, 9,8,11,10, 5,4,7,6, 1,0,3,2);
+  const __m256i rot8  = _mm256_set_epi8(14,13,12,15, 10,9,8,11, 6,5,4,7, 2,1,0,3,
+                                        14,13,12,15, 10,9,8,11, 6,5,4,7, 2,1,0,3);
+  while (nblocks >= 8) {
+    if (kk_unlikely(input[12] > UINT32_MAX - 8)) {
+      // the low counter word wraps within these blocks; let the generic path carry
+      kk_chacha_blocks_generic(rounds, input, buf, 8);
+    }
+    else {
+      __m256i s[16];
+      __m256i x[16];
+      for (size_t i = 0; i < 16; i++) {
+        s[i] = _mm256_set1_epi32((int32_t)input[i]);
+      }
+      s[12] = _mm256_add_epi32(s[12], _mm256_setr_epi32(0,1,2,3,4,5,6,7));  // per-lane counter
+      for (size_t i = 0; i < 16; i++) {
+        x[i] = s[i];
+      }
+      for (size_t r = 0; r < rounds; r += 2) {
+        KK_VQROUND(0, 4,  8, 12); KK_VQROUND(1, 5,  9, 13);
+        KK_VQROUND(2, 6, 10, 14); KK_VQROUND(3, 7, 11, 15);
+        KK_VQROUND(0, 5, 10, 15); KK_VQROUND(1, 6, 11, 12);
+        KK_VQROUND(2, 7,  8, 13); KK_VQROUND(3, 4,  9, 14);
+      }
+      uint32_t lanes[16][8];
+      for (size_t i = 0; i < 16; i++) {
+        _mm256_storeu_si256((__m256i*)lanes[i], _mm256_add_epi32(x[i], s[i]));
+      }
+      // de-interleave: block `b` is lane `b` of every state word
+      for (size_t b = 0; b < 8; b++) {
+        uint32_t* out = (uint32_t*)(buf + 64*b);
+        for (size_t i = 0; i < 16; i++) {
+          out[i] = lanes[i][b];
+        }
+      }
+      input[12] += 8;
+    }
+    buf += 8*64;
+    nblocks -= 8;
+  }
+  kk_chacha_blocks_generic(rounds, input, buf, nblocks);
+}
+#undef KK_VROTL32
+#undef KK_VQROUND
+
+#elif defined(KK_CHACHA_NEON)
+// Four blocks at a time, one block per 32-bit lane.
+#define KK_VROTL32(v,n)     vorrq_u32(vshlq_n_u32(v,n), vshrq_n_u32(v,32-(n)))
+#define KK_VQROUND(a,b,c,d) \
+  x[a] = vaddq_u32(x[a],x[b]); x[d] = KK_VROTL32(veorq_u32(x[d],x[a]), 16); \
+  x[c] = vaddq_u32(x[c],x[d]); x[b] = KK_VROTL32(veorq_u32(x[b],x[c]), 12); \
+  x[a] = vaddq_u32(x[a],x[b]); x[d] = KK_VROTL32(veorq_u32(x[d],x[a]), 8); \
+  x[c] = vaddq_u32(x[c],x[d]); x[b] = KK_VROTL32(veorq_u32(x[b],x[c]), 7)
+
+static void kk_chacha_blocks_neon(const size_t rounds, uint32_t* input, uint8_t* buf, size_t nblocks) {
+  while (nblocks >= 4) {
+    if (kk_unlikely(input[12] > UINT32_MAX - 4)) {
+      kk_chacha_blocks_generic(rounds, input, buf, 4);
+    }
+    else {
+      uint32x4_t s[16];
+      uint32x4_t x[16];
+      const uint32_t lane[4] = { 0, 1, 2, 3 };
+      for (size_t i = 0; i < 16; i++) {
+        s[i] = vdupq_n_u32(input[i]);
+      }
+      s[12] = vaddq_u32(s[12], vld1q_u32(lane));  // per-lane counter
+      for (size_t i = 0; i < 16; i++) {
+        x[i] = s[i];
+      }
+      for (size_t r = 0; r < rounds; r += 2) {
+        KK_VQROUND(0, 4,  8, 12); KK_VQROUND(1, 5,  9, 13);
+        KK_VQROUND(2, 6, 10, 14); KK_VQROUND(3, 7, 11, 15);
+        KK_VQROUND(0, 5, 10, 15); KK_VQROUND(1, 6, 11, 12);
+        KK_VQROUND(2, 7,  8, 13); KK_VQROUND(3, 4,  9, 14);
+      }
+      uint32_t lanes[16][4];
+      for (size_t i = 0; i < 16; i++) {
+        vst1q_u32(lanes[i], vaddq_u32(x[i], s[i]));
+      }
+      for (size_t b = 0; b < 4; b++) {
+        uint32_t* out = (uint32_t*)(buf + 64*b);
+        for (size_t i = 0; i < 16; i++) {
+          out[i] = lanes[i][b];
+        }
+      }
+      input[12] += 4;
+    }
+    buf += 4*64;
+    nblocks -= 4;
+  }
+  kk_chacha_blocks_generic(rounds, input, buf, nblocks);
+}
+#undef KK_VROTL32
+#undef KK_VQROUND
+#endif
+
+typedef void (*kk_chacha_blocks_fun_t)(const size_t rounds, uint32_t* input, uint8_t* buf, size_t nblocks);
+
+static void kk_chacha_blocks(const size_t rounds, uint32_t* input, uint8_t* buf, size_t nblocks) {
+#if defined(KK_CHACHA_AVX2)
+  static kk_chacha_blocks_fun_t fun = NULL;
+  kk_cpu_dispatch(fun, KK_CPU_X64_AVX2, &kk_chacha_blocks_avx2, &kk_chacha_blocks_generic);
+  fun(rounds, input, buf, nblocks);
+#elif defined(KK_CHACHA_NEON)
+  kk_chacha_blocks_neon(rounds, input, buf, nblocks);
+#else
+  kk_chacha_blocks_generic(rounds, input, buf, nblocks);
+#endif
+}
 /*
 static kk_decl_noinline void chacha8(kk_random_ctx_t* rnd) {
   chacha_block(8, rnd->input, rnd->output);
@@ -391,7 +576,7 @@ static kk_random_ctx_t* random_init(kk_context_t* ctx) {
     // if we fail to get random data from the OS, we fall back to a
     // weak random source based on the C library `rand()`, the current (high precision) time, and ASLR.
     kk_warning_message("unable to use strong randomness\n");
-    kk_pcg_ctx_t pcg;
+    kk_prandom_t pcg;
     pcg_init(kk_os_random_weak(), (uint64_t)(rand()), &pcg);
     for (size_t i = 0; i < 8; i++) {  // key is eight 32-bit words.
       uint32_t x = pcg_uint32(&pcg);
@@ -413,6 +598,42 @@ kk_random_ctx_t* kk_srandom_round(kk_context_t* ctx) {
   return rnd;
 }
 
+// Fill `buf` with `len` random bytes; whole blocks are generated straight
+// into the buffer (vectorized when the cpu supports it) so only the head and
+// tail go through the context output block.
+void kk_srandom_bytes(uint8_t* buf, kk_ssize_t len, kk_context_t* ctx) {
+  if (buf == NULL || len <= 0) return;
+  kk_random_ctx_t* rnd = ctx->srandom_ctx;
+  if (rnd == NULL) {
+    ctx->srandom_ctx = rnd = random_init(ctx);
+  }
+  uint8_t* p = buf;
+  kk_ssize_t todo = len;
+  // drain the words left over in the current output block first
+  while (todo > 0 && rnd->used >= 0 && rnd->used < 16) {
+    const kk_ssize_t n = (todo < 4 ? todo : 4);
+    memcpy(p, &rnd->output[rnd->used], (size_t)n);
+    rnd->output[rnd->used++] = 0;  // clear after use
+    p += n; todo -= n;
+  }
+  // generate whole blocks straight into the buffer
+  const kk_ssize_t nblocks = todo / 64;
+  if (nblocks > 0) {
+    kk_chacha_blocks(20, rnd->input, p, (size_t)nblocks);
+    p += nblocks*64; todo -= nblocks*64;
+  }
+  // and serve any remaining tail from a fresh output block
+  if (todo > 0) {
+    kk_chacha20(rnd);
+    memcpy(p, rnd->output, (size_t)todo);
+    const kk_ssize_t used = (todo + 3) / 4;  // partially copied words are discarded
+    for (kk_ssize_t i = 0; i < used; i++) {
+      rnd->output[i] = 0;
+    }
+    rnd->used = (int32_t)used;
+  }
+}
+
 bool kk_srandom_is_strong(kk_context_t* ctx) {
   kk_random_ctx_t* rnd = ctx->srandom_ctx;
   if (rnd == NULL) {
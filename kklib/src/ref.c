@@ -7,26 +7,106 @@
 ---------------------------------------------------------------------------*/
 #include "kklib.h"
 
+/*--------------------------------------------------------------------------------------
+  Hazard slots for read-optimized thread-shared refs.
+
+  Shared refs tend to be read-mostly (configuration and state read by every
+  worker) and the old guarded path made every reader CAS the ref itself, so
+  all readers contended on one cache line. Instead, a reader now publishes
+  the value it is about to dup in its _own_ slot and re-validates the ref
+  afterwards; a writer waits until the old value is absent from every slot
+  before handing it to the caller (who may drop it). Readers never write to
+  the shared ref cache line and scale with the number of cores, while a
+  (rare) writer pays a scan over the slots.
+--------------------------------------------------------------------------------------*/
+
+#define KK_HAZARD_SLOTS  (64)
+
+typedef struct kk_hazard_slot_s {
+  _Atomic(uintptr_t) ptr;     // box value currently being dup'd by the owner (0 when none)
+  _Atomic(uintptr_t) owner;   // context that owns this slot (0 when free)
+  uint8_t _padding[64 - 2*sizeof(uintptr_t)];  // keep slots on separate cache lines
+} kk_hazard_slot_t;
+
+static kk_hazard_slot_t kk_hazard_slots[KK_HAZARD_SLOTS];
+
+static kk_hazard_slot_t* kk_hazard_slot_acquire(kk_context_t* ctx) {
+  if (kk_likely(ctx->hazard_slot != NULL)) return ctx->hazard_slot;
+  for (kk_ssize_t i = 0; i < KK_HAZARD_SLOTS; i++) {
+    if (kk_atomic_load_relaxed(&kk_hazard_slots[i].owner) == 0) {
+      uintptr_t expected = 0;
+      if (kk_atomic_cas_strong_acq_rel(&kk_hazard_slots[i].owner, &expected, (uintptr_t)ctx)) {
+        ctx->hazard_slot = &kk_hazard_slots[i];
+        return ctx->hazard_slot;
+      }
+    }
+  }
+  return NULL;  // all slots taken; the caller falls back to the guarded path
+}
+
+kk_decl_export void kk_hazard_slot_release(kk_context_t* ctx) {
+  kk_hazard_slot_t* slot = ctx->hazard_slot;
+  if (slot == NULL) return;
+  ctx->hazard_slot = NULL;
+  kk_assert_internal(kk_atomic_load_relaxed(&slot->ptr) == 0);
+  kk_atomic_store_relaxed(&slot->ptr, 0);
+  kk_atomic_store_release(&slot->owner, 0);
+}
+
+// Wait until no reader still holds `p` in a hazard slot: such a reader
+// validated before our swap and is just about to dup (a few instructions).
+static void kk_hazard_wait(uintptr_t p) {
+  kk_atomic_fence_seq_cst();
+  for (kk_ssize_t i = 0; i < KK_HAZARD_SLOTS; i++) {
+    while (kk_unlikely(kk_atomic_load_acquire(&kk_hazard_slots[i].ptr) == p)) { /* spin */ }
+  }
+}
+
 
 // Atomic path for mutable references
 kk_decl_export kk_box_t kk_ref_get_thread_shared(kk_ref_t r, kk_context_t* ctx) {
-  // careful: we cannot first read and then dup the read value as it may be 
+  // read-optimized path: publish the value in our hazard slot and re-validate;
+  // a concurrent swap waits on the slot before its old value can be dropped,
+  // so the dup below never races with a free.
+  kk_hazard_slot_t* slot = kk_hazard_slot_acquire(ctx);
+  if (kk_likely(slot != NULL)) {
+    for (int retry = 0; retry < 4; retry++) {
+      kk_box_t b;
+      b.box = kk_atomic_load_relaxed(&r->value);
+      if (kk_box_is_value(b)) {   // raw values are not heap allocated and need no dup
+        kk_ref_drop(r, ctx);
+        return b;
+      }
+      if (b.box == 0) break;      // guarded by a fallback reader; join the guarded path
+      kk_atomic_store_relaxed(&slot->ptr, b.box);
+      kk_atomic_fence_seq_cst();
+      if (kk_likely(kk_atomic_load_relaxed(&r->value) == b.box)) {  // still current?
+        kk_box_dup(b);
+        kk_atomic_store_release(&slot->ptr, 0);  // release: order the dup before a writer can drop
+        kk_ref_drop(r, ctx);
+        return b;
+      }
+      kk_atomic_store_relaxed(&slot->ptr, 0);    // raced with a swap; try again
+    }
+  }
+  // fallback (no slot, or contending with a guarded reader):
+  // careful: we cannot first read and then dup the read value as it may be
   // overwritten and _dropped_ by another thread in between. To avoid this
-  // situation we first atomically swap with a guard value 0, then dup, and 
+  // situation we first atomically swap with a guard value 0, then dup, and
   // write back the old value again.
 again: ;
-  kk_box_t b; 
+  kk_box_t b;
   b.box = kk_atomic_load_relaxed(&r->value);
   do {
-    if (kk_box_is_value(b)) return b;  // optimize: if it is a raw value (that is not heap allocated), we can immediately return
+    if (kk_box_is_value(b)) { kk_ref_drop(r,ctx); return b; }  // optimize: if it is a raw value (that is not heap allocated), we can immediately return
     if (b.box == 0) { b.box = 1; }     // expect any value but 0
   } while (!kk_atomic_cas_weak_relaxed(&r->value, &b.box, 0));
   // we got it, and hold the "locked" reference (`r->value == 0`)
   kk_box_dup(b);
-  // and release our lock by writing back `b`    
+  // and release our lock by writing back `b`
   uintptr_t guard = 0;
-  while (!kk_atomic_cas_strong_relaxed(&r->value, &guard, b.box)) { 
-    assert(false); 
+  while (!kk_atomic_cas_strong_relaxed(&r->value, &guard, b.box)) {
+    assert(false);
     // should never happen! as a last resort, restart the operation
     kk_box_drop(b,ctx);
     goto again;
@@ -37,12 +117,15 @@ again: ;
 
 kk_decl_export kk_box_t kk_ref_swap_thread_shared_borrow(kk_ref_t r, kk_box_t value) {
   // atomically swap, but not if guarded with 0 (to not interfere with a `ref_get`)
-  kk_box_t b; 
+  kk_box_t b;
   b.box = kk_atomic_load_relaxed(&r->value);
   //uintptr_t exp = kk_atomic_load_relaxed(&r->value);
   do {
     if (b.box==0) { b.box = 1; }  // any value but 0
   } while (!kk_atomic_cas_weak_relaxed(&r->value, &b.box, value.box));
+  // before handing the old value to the caller (who may drop it), wait for
+  // readers that already validated it (see `kk_ref_get_thread_shared`)
+  if (!kk_box_is_value(b)) { kk_hazard_wait(b.box); }
   return b;
 }
 
@@ -10,6 +10,7 @@
 // static void kk_block_drop_free_delayed(kk_context_t* ctx);
 // static kk_decl_noinline void kk_block_drop_free_rec(kk_block_t* b, kk_ssize_t scan_fsize, const kk_ssize_t depth, kk_context_t* ctx);
 static kk_decl_noinline void kk_block_drop_free_recx(kk_block_t* b, kk_context_t* ctx);
+static void kk_block_drop_defer(kk_block_t* b, kk_context_t* ctx);
 
 static void kk_block_free_raw(kk_block_t* b, kk_context_t* ctx) {
   kk_assert_internal(kk_tag_is_raw(kk_block_tag(b)));
@@ -28,10 +29,13 @@ static void kk_block_drop_free(kk_block_t* b, kk_context_t* ctx) {
     if (kk_unlikely(kk_tag_is_raw(kk_block_tag(b)))) { kk_block_free_raw(b,ctx); }
     kk_block_free(b,ctx); // deallocate directly if nothing to scan
   }
+  else if (kk_unlikely(ctx->deferred_reclaim)) {
+    kk_block_drop_defer(b, ctx);     // queue for later reclamation (see `kk_deferred_reclaim`)
+  }
   else {
     kk_block_drop_free_recx(b, ctx); // free recursively
-    // TODO: for performance unroll one iteration for scan_fsize == 1 
-    // and scan_fsize == 2 with the first field an non-ptr ?    
+    // TODO: for performance unroll one iteration for scan_fsize == 1
+    // and scan_fsize == 2 with the first field an non-ptr ?
   }
 }
 
@@ -104,12 +108,69 @@ static inline kk_refcount_t kk_atomic_acquire(kk_block_t* b) {
   return kk_atomic_load_acquire(&b->header.refcount);
 }
 
-static void kk_block_make_shared(kk_block_t* b) {
+// Try to make a block thread shared. This is done with a compare-and-swap so
+// markers running in parallel can race on the same block: only the caller
+// that succeeds returns `true` and is responsible for marking the children.
+static bool kk_block_try_make_shared(kk_block_t* b) {
   kk_refcount_t rc = kk_block_refcount(b);
-  kk_assert_internal(rc <= RC_STUCK);        // not thread shared already
-  rc = RC_SHARED_UNIQUE - rc;                // signed: -1 - rc
-  if (rc <= RC_STICKY_DROP) rc = RC_STICKY;  // for high reference counts
-  kk_block_refcount_set(b, rc);
+  while (!kk_refcount_is_thread_shared(rc)) {
+    kk_refcount_t rcshared = RC_SHARED_UNIQUE - rc;            // signed: -1 - rc
+    if (rcshared <= RC_STICKY_DROP) { rcshared = RC_STICKY; }  // for high reference counts
+    if (kk_atomic_cas_strong_acq_rel(&b->header.refcount, &rc, rcshared)) return true;
+  }
+  return false;  // already thread shared (or another marker beat us to it)
+}
+
+static void kk_block_make_shared(kk_block_t* b) {
+  kk_block_try_make_shared(b);
+}
+
+/*--------------------------------------------------------------------------------------
+  Biased reference counts for thread-shared blocks.
+  Instead of one atomic operation per dup, a dup banks a whole batch of
+  references with a single atomic subtraction (shared counts decrement on dup)
+  and hands them out from the per-context bank from then on; drops return
+  references to the bank. A thread that repeatedly dups/drops a read-mostly
+  shared structure thus stays off the contended cache line entirely. Banked
+  references are real references so a block can never be freed from under a
+  bank; they are returned on eviction and when the context is freed.
+--------------------------------------------------------------------------------------*/
+
+#define RC_BIAS_BATCH   (32)                 // references banked per atomic operation
+#define RC_BIAS_MAX     (4*RC_BIAS_BATCH)    // return a batch once this many credits accumulate
+#define RC_BIAS_MARGIN  KK_U32(0x10000)      // don't bank near the sticky range (crossing it under
+                                             // concurrent banking would only make the block sticky)
+
+static inline kk_rc_bias_t* kk_rc_bias_at(kk_block_t* b, kk_context_t* ctx) {
+  return &ctx->rc_bias[(((uintptr_t)b) >> 4) & (KK_RC_BIAS_SIZE-1)];
+}
+
+// Return `credits` banked references to the shared count; frees the block when
+// those turn out to be the last references.
+static void kk_rc_bias_return(kk_block_t* b, kk_refcount_t credits, kk_context_t* ctx) {
+  if (credits == 0) return;
+  // return all but one credit at once, and the last one as a regular drop so
+  // the standard last-reference check applies
+  if (credits > 1) { kk_atomic_add_release(&b->header.refcount, credits - 1); }
+  const kk_refcount_t rc = kk_atomic_drop(b);
+  if (rc == RC_SHARED_UNIQUE) {    // the bank held the last reference?
+    kk_atomic_acquire(b);          // prevent reordering of reads/writes before this point
+    kk_block_refcount_set(b,0);    // no longer shared
+    kk_block_drop_free(b, ctx);    // no more references, free it.
+  }
+}
+
+void kk_rc_bias_flush(kk_context_t* ctx) {
+  for (kk_ssize_t i = 0; i < KK_RC_BIAS_SIZE; i++) {
+    kk_rc_bias_t* e = &ctx->rc_bias[i];
+    if (e->block != NULL) {
+      kk_block_t* b = e->block;
+      const kk_refcount_t credits = e->credits;
+      e->block = NULL;
+      e->credits = 0;
+      kk_rc_bias_return(b, credits, ctx);
+    }
+  }
 }
 
 // Check if a reference dup needs an atomic operation
@@ -117,7 +178,26 @@ kk_decl_noinline kk_block_t* kk_block_check_dup(kk_block_t* b, kk_refcount_t rc0
   kk_assert_internal(b!=NULL);
   kk_assert_internal(kk_refcount_is_thread_shared(rc0)); // includes KK_STUCK
   if (kk_likely(rc0 > RC_STICKY)) {
-    kk_atomic_dup(b);
+    kk_context_t* ctx = kk_get_context();
+    ctx->heap_escaped = true;  // holds references to thread-shared blocks now
+    kk_rc_bias_t* e = kk_rc_bias_at(b, ctx);
+    if (e->block == b && e->credits > 0) {
+      e->credits--;                        // take a banked reference; no atomics
+      kk_stat_inc(ctx, dups);
+    }
+    else if (rc0 > RC_STICKY_DROP + RC_BIAS_MARGIN) {
+      if (e->block != b) {
+        if (e->block != NULL) { kk_rc_bias_return(e->block, e->credits, ctx); }  // evict
+        e->block = b;
+      }
+      kk_atomic_sub_relaxed(&b->header.refcount, RC_BIAS_BATCH);  // bank a batch (shared counts decrement on dup)
+      e->credits = RC_BIAS_BATCH - 1;      // minus the reference for this dup
+      kk_stat_inc(ctx, dups_atomic);
+    }
+    else {
+      kk_stat_inc(ctx, dups_atomic);
+      kk_atomic_dup(b);
+    }
   }
   // else sticky: no longer increment (or decrement)
   return b;
@@ -131,12 +211,25 @@ kk_decl_noinline void kk_block_check_drop(kk_block_t* b, kk_refcount_t rc0, kk_c
   kk_assert_internal(kk_block_refcount(b) == rc0);
   kk_assert_internal(rc0 == 0 || kk_refcount_is_thread_shared(rc0));
   if (kk_likely(rc0==0)) {
+    kk_stat_inc(ctx, drops);
     kk_block_drop_free(b, ctx);  // no more references, free it.
   }
   else if (kk_unlikely(rc0 <= RC_STICKY_DROP)) {
     // sticky: do not drop further
   }
   else {
+    ctx->heap_escaped = true;    // holds references to thread-shared blocks
+    kk_rc_bias_t* e = kk_rc_bias_at(b, ctx);
+    if (e->block == b) {
+      kk_stat_inc(ctx, drops);
+      e->credits++;                  // return the reference to the bank; no atomics
+      if (e->credits >= RC_BIAS_MAX) {
+        e->credits -= RC_BIAS_BATCH; // cannot free: the bank still holds references
+        kk_rc_bias_return(b, RC_BIAS_BATCH, ctx);
+      }
+      return;
+    }
+    kk_stat_inc(ctx, drops_atomic);
     const kk_refcount_t rc = kk_atomic_drop(b);
     if (rc == RC_SHARED_UNIQUE) {    // this was the last reference?
       kk_atomic_acquire(b);          // prevent reordering of reads/writes before this point
@@ -158,6 +251,7 @@ kk_decl_noinline kk_reuse_t kk_block_check_drop_reuse(kk_block_t* b, kk_refcount
     for (kk_ssize_t i = 0; i < scan_fsize; i++) {
       kk_box_drop(kk_block_field(b, i), ctx);
     }
+    kk_census_free(b, ctx);  // a reuse token counts as dead until re-allocated
     memset(&b->header, 0, sizeof(kk_header_t)); // not really necessary
     return b;
   }
@@ -175,15 +269,20 @@ kk_decl_noinline void kk_block_check_decref(kk_block_t* b, kk_refcount_t rc0, kk
   kk_assert_internal(kk_block_refcount(b) == rc0);
   kk_assert_internal(rc0 == 0 || kk_refcount_is_thread_shared(rc0));
   if (kk_likely(rc0==0)) {
-    kk_free(b,ctx);  // no more references, free it (without dropping children!)
+    if (kk_likely(!kk_arena_resident(b,ctx))) {
+      kk_census_free(b, ctx);
+      kk_free(b,ctx);  // no more references, free it (without dropping children!)
+    }
   }
   else if (kk_unlikely(rc0 <= RC_STICKY_DROP)) {
     // sticky: do not decrement further
   }
   else {
+    ctx->heap_escaped = true;        // holds references to thread-shared blocks
     const kk_refcount_t rc = kk_atomic_drop(b);
     if (rc == RC_SHARED_UNIQUE) {    // last referenc?
       kk_block_refcount_set(b,0);    // no longer shared
+      kk_census_free(b, ctx);
       kk_free(b,ctx);                // no more references, free it.
     }
   }
@@ -225,22 +324,17 @@ static bool kk_block_decref_no_free(kk_block_t* b) {
 }
 
 //-----------------------------------------------------------------------------------------
-// Drop a block and its children without using further stack space.
-// 
-// The stack-less algorithm without delay list was initially created by Anton Lorenzen.
-// It maintains a parent stack in the first field of visited objects, with the 
-// next field to process as an 8-bit value in the `_field_idx` (also used by marking)
-// (and it is faster than a recursive version so we only have a stackless free)
+// Drop a block and its children without using further (C) stack space.
+//
+// We maintain an explicit worklist of blocks that still need to be freed in
+// segments of pending blocks: the first segment lives on the stack and deep
+// cascades grow into further heap allocated segments. Children are prefetched
+// as they are pushed (and the next entry is prefetched on every pop) so a large
+// drop cascade streams through cold memory instead of chasing one pointer at
+// a time. Chains of blocks with a single child (lists) are followed directly
+// and never touch the worklist.
 //-----------------------------------------------------------------------------------------
 
-static inline uint8_t kk_decl_pure kk_block_field_idx(const kk_block_t* b) {
-  return b->header._field_idx;
-}
-
-static inline void kk_block_field_idx_set(kk_block_t* b, uint8_t idx ) {
-  b->header._field_idx = idx;
-}
-
 // Check if a field `i` in a block `b` should be freed, i.e. it is heap allocated with a refcount of 0.
 // Optimizes by already freeing leaf blocks that are heap allocated but have no scan fields.
 static inline kk_block_t* kk_block_field_should_free(kk_block_t* b, kk_ssize_t field, kk_context_t* ctx)
@@ -264,123 +358,158 @@ static inline kk_block_t* kk_block_field_should_free(kk_block_t* b, kk_ssize_t f
 }
 
 
-// Drop a large block (e.g. kk_vector_t) recursively. This is only used 
-// for vectors with > 255 (KK_SCAN_FSIZE_MAX) elements.
-// We just iterate through the elements which is efficient but we use the stack
-// for each recursion over these vectors; the idea is that vectors will not be 
-// deeply nested. (We could improve this by only recursing for vectors with more than 2^32 elements 
-// (which fits in a refcount)).
-static kk_decl_noinline void kk_block_drop_free_large_rec(kk_block_t* b, kk_context_t* ctx) 
-{
-  kk_assert_internal(b->header.scan_fsize == KK_SCAN_FSIZE_MAX);
-  kk_ssize_t scan_fsize = kk_block_scan_fsize(b);
-  for (kk_ssize_t i = 1; i < scan_fsize; i++) {   // start at 1 to skip the initial large scan_fsize field
-    kk_block_t* child = kk_block_field_should_free(b, i, ctx);
-    if (child != NULL) {
-      // free field recursively
-      kk_block_drop_free_recx(child, ctx);        
-    }
+// Pending blocks are kept in segments that form a stack; only deep cascades
+// allocate further segments on the heap.
+#define KK_DROP_SEGMENT_SIZE  (250)
+
+typedef struct kk_drop_segment_s {
+  struct kk_drop_segment_s* next;    // previous (lower) segment on the stack
+  kk_ssize_t  count;                 // number of pending blocks in `blocks`
+  kk_block_t* blocks[KK_DROP_SEGMENT_SIZE];
+} kk_drop_segment_t;
+
+static kk_drop_segment_t* kk_drop_segment_push(kk_drop_segment_t* seg, kk_block_t* b, kk_context_t* ctx) {
+  if (kk_unlikely(seg->count >= KK_DROP_SEGMENT_SIZE)) {
+    kk_drop_segment_t* s = (kk_drop_segment_t*)kk_malloc(kk_ssizeof(kk_drop_segment_t), ctx);
+    s->next = seg;
+    s->count = 0;
+    seg = s;
   }
-  // and free the vector itself
-  kk_block_free(b,ctx);
+  seg->blocks[seg->count++] = b;
+  return seg;
 }
 
-// Recursively free a block and drop its children without using stack space
-static kk_decl_noinline void kk_block_drop_free_recx(kk_block_t* b, kk_context_t* ctx) 
-{
-  kk_assert_internal(b->header.scan_fsize > 0);
-  kk_block_t* parent = NULL;
-  uint8_t scan_fsize;
+// Pop the next pending block; `base` is the bottom segment which is not owned
+// by us (it lives on the stack of our caller), or `NULL` when popping from a
+// fully heap allocated queue (as used by deferred reclamation).
+static kk_block_t* kk_drop_segment_pop(kk_drop_segment_t** seg, const kk_drop_segment_t* base, kk_context_t* ctx) {
+  kk_drop_segment_t* s = *seg;
+  while (s != base && s->count == 0) {
+    kk_drop_segment_t* next = s->next;
+    kk_free(s, ctx);
+    *seg = s = next;
+  }
+  if (s == NULL || s->count == 0) return NULL;  // all done
+  kk_block_t* b = s->blocks[--s->count];
+  if (s->count > 0) { kk_cpu_prefetch(s->blocks[s->count - 1]); }  // warm the next block to pop
+  return b;
+}
 
-  // ------- move down ------------
-  movedown:
-    scan_fsize = b->header.scan_fsize;
+// Free `b` and pending blocks on the worklist until done, or until `budget`
+// blocks have been freed (`budget < 0` is unbounded); a spent budget leaves the
+// remaining work on the worklist. Returns the remaining budget.
+static kk_ssize_t kk_block_drop_free_loop(kk_block_t* b, kk_drop_segment_t** segp, const kk_drop_segment_t* base, kk_ssize_t budget, kk_context_t* ctx)
+{
+  kk_drop_segment_t* seg = *segp;
+  while (true) {
+    if (kk_unlikely(budget == 0)) {
+      // budget spent: leave the current block on the worklist
+      seg = kk_drop_segment_push(seg, b, ctx);
+      break;
+    }
+    if (budget > 0) budget--;
     kk_assert_internal(kk_block_refcount(b) == 0);
-    kk_assert_internal(scan_fsize > 0);           // due to kk_block_should_free
-    if (scan_fsize == 1) {
+    const uint8_t sfsize = b->header.scan_fsize;
+    kk_assert_internal(sfsize > 0);           // due to kk_block_drop_free
+    if (sfsize == 1) {
       // if just one field, we can free directly and continue with the child
       kk_block_t* next = kk_block_field_should_free(b, 0, ctx);
       kk_block_free(b,ctx);
-      if (next != NULL) {
-        b = next;
-        goto movedown;
-      }
-      // goto moveup; // fallthrough
+      if (next != NULL) { b = next; continue; }
     }
-    else if (scan_fsize == 2 && !kk_box_is_non_null_ptr(kk_block_field(b,0))) {
+    else if (sfsize == 2 && !kk_box_is_non_null_ptr(kk_block_field(b,0))) {
       // optimized code for lists/nodes with boxed first element
       kk_block_t* next = kk_block_field_should_free(b, 1, ctx);
       kk_block_free(b,ctx);
-      if (next != NULL) {
-        b = next;
-        goto movedown;
-      }
-      // goto moveup; // fallthrough
+      if (next != NULL) { b = next; continue; }
     }
-    else if (scan_fsize < KK_SCAN_FSIZE_MAX) {
-      // small block more than 1 field (but less then KK_SCAN_FSIZE_MAX)
-      uint8_t i = 0;
-      kk_assert_internal(i < scan_fsize);
-      // drop each field
-      do {
+    else {
+      // more than 1 (potential) pointer field: continue with the first child
+      // and push the other children on the worklist
+      kk_ssize_t i = 0;
+      kk_ssize_t scan_fsize = sfsize;
+      if (kk_unlikely(sfsize == KK_SCAN_FSIZE_MAX)) {
+        // large block (e.g. kk_vector_t with > KK_SCAN_FSIZE_MAX elements)
+        scan_fsize = kk_block_scan_fsize(b);
+        i++;  // skip the initial large scan_fsize field
+      }
+      kk_block_t* next = NULL;
+      for (; i < scan_fsize; i++) {
         kk_block_t* child = kk_block_field_should_free(b, i, ctx);
-        i++;
         if (child != NULL) {
-          // go down into the child
-          if (i < scan_fsize) {
-            // save our progress to continue here later (when moving up)
-            kk_block_field_set(b, 0, _kk_box_new_ptr(parent)); // set parent (use low-level box as parent could be NULL)
-            kk_block_field_idx_set(b,i);
-            parent = b;
-          }
+          if (next == NULL) { next = child; }
           else {
-            // the last field: free the block and continue with the child leaving the parent unchanged
-            kk_block_free(b,ctx);
+            kk_cpu_prefetch(child);  // warm the child ahead of its pop
+            seg = kk_drop_segment_push(seg, child, ctx);
           }
-          // and continue with the child
-          b = child;
-          goto movedown;
         }
-      } while (i < scan_fsize);
-      // goto moveup; // fallthrough
-    }
-    else {
-      kk_assert_internal(scan_fsize == KK_SCAN_FSIZE_MAX);
-      kk_block_drop_free_large_rec(b, ctx);
+      }
+      kk_block_free(b,ctx);  // note: cannot be a raw block as those have no scan fields
+      if (next != NULL) { b = next; continue; }
     }
+    // no children to continue with: pop the next pending block
+    b = kk_drop_segment_pop(&seg, base, ctx);
+    if (b == NULL) break;  // all done
+  }
+  *segp = seg;
+  return budget;
+}
 
-  // ------- move up along the parent chain ------------
-  while (kk_likely(parent != NULL)) {
-    // go up to parent
-    uint8_t i = kk_block_field_idx(parent);
-    scan_fsize = parent->header.scan_fsize;
-    kk_assert_internal(i < scan_fsize);
-    // go through children of the parent
-    do {
-      kk_block_t* child = kk_block_field_should_free(parent, i, ctx);
-      i++;
-      if (child != NULL) {
-        if (i < scan_fsize) {
-          // save our progress to continue here later
-          kk_block_field_idx_set(parent,i);
-        }
-        else {
-          // the last field; free the block and move the parent one up
-          b = parent;
-          parent = _kk_box_ptr(kk_block_field(parent, 0)); // use low-level box as it can be NULL
-          kk_block_free(b,ctx);  // note: cannot be a raw block as those have no scanfield
-        }
-        // and continue with the child
-        b = child;
-        goto movedown;        
-      }
-    } while (i < scan_fsize);
-    // done: free the block and move up further
-    b = parent;
-    parent = _kk_box_ptr( kk_block_field(parent, 0) );  // low-level box as it can be NULL
-    kk_block_free(b,ctx);  // note: cannot be a raw block as those have no scanfield
+// Free a block and drop its children without using further (C) stack space
+static kk_decl_noinline void kk_block_drop_free_recx(kk_block_t* b, kk_context_t* ctx)
+{
+  kk_drop_segment_t base;   // initial segment on the stack
+  base.next = NULL;
+  base.count = 0;
+  kk_drop_segment_t* seg = &base;
+  kk_block_drop_free_loop(b, &seg, &base, -1 /* unbounded */, ctx);
+  kk_assert_internal(seg == &base && base.count == 0);
+}
+
+
+/*--------------------------------------------------------------------------------------
+  Deferred reclamation.
+  When enabled on a context, drop cascades are queued on `ctx->delayed_free`
+  instead of freed eagerly, and the queue is drained in bounded increments
+  through `kk_deferred_reclaim` (e.g. between requests in a latency sensitive
+  service). Leaf blocks are still freed directly as they can never cascade.
+--------------------------------------------------------------------------------------*/
+
+static void kk_block_drop_defer(kk_block_t* b, kk_context_t* ctx) {
+  kk_assert_internal(kk_block_refcount(b) == 0 && b->header.scan_fsize > 0);
+  kk_drop_segment_t* seg = ctx->delayed_free;
+  if (seg == NULL) {
+    seg = (kk_drop_segment_t*)kk_malloc(kk_ssizeof(kk_drop_segment_t), ctx);
+    seg->next = NULL;
+    seg->count = 0;
   }
-  // done
+  ctx->delayed_free = kk_drop_segment_push(seg, b, ctx);
+}
+
+kk_decl_export void kk_deferred_reclaim_enable(bool enable, kk_context_t* ctx) {
+  ctx->deferred_reclaim = enable;
+  if (!enable) { kk_deferred_reclaim(-1, ctx); }  // reclaim everything still pending
+}
+
+kk_decl_export bool kk_deferred_reclaim(kk_ssize_t budget, kk_context_t* ctx) {
+  kk_drop_segment_t* seg = ctx->delayed_free;
+  if (seg == NULL) return false;
+  ctx->delayed_free = NULL;  // take ownership: custom free functions may defer new drops while we reclaim
+  kk_block_t* b = kk_drop_segment_pop(&seg, NULL, ctx);
+  if (b != NULL) {
+    kk_block_drop_free_loop(b, &seg, NULL, budget, ctx);
+  }
+  kk_drop_segment_t* pending = ctx->delayed_free;  // deferred during reclamation?
+  if (pending == NULL) {
+    ctx->delayed_free = seg;
+  }
+  else if (seg != NULL) {
+    // append our remaining segments below the newly deferred ones
+    kk_drop_segment_t* s = pending;
+    while (s->next != NULL) { s = s->next; }
+    s->next = seg;
+  }
+  return (ctx->delayed_free != NULL);
 }
 
 
@@ -429,7 +558,7 @@ static kk_decl_noinline void kk_block_mark_shared_rec(kk_block_t* b, const kk_ss
     kk_assert_internal(scan_fsize > 0);
     if (scan_fsize == 1) {
       // if just one field, we can recursively scan without using stack space
-      kk_block_make_shared(b);
+      if (!kk_block_try_make_shared(b)) return;  // a parallel marker owns this subtree
       kk_block_t* child = kk_block_field_should_mark(b, 0, ctx);
       if (child != NULL) {
         // try to mark the child now
@@ -440,7 +569,7 @@ static kk_decl_noinline void kk_block_mark_shared_rec(kk_block_t* b, const kk_ss
     }
     else if (scan_fsize == 2 && !kk_box_is_non_null_ptr(kk_block_field(b, 0))) {
       // optimized code for lists/nodes with boxed first element
-      kk_block_make_shared(b);
+      if (!kk_block_try_make_shared(b)) return;
       kk_block_t* child = kk_block_field_should_mark(b, 1, ctx);
       if (child != NULL) {
         b = child;
@@ -451,7 +580,7 @@ static kk_decl_noinline void kk_block_mark_shared_rec(kk_block_t* b, const kk_ss
     else {
       // more than 1 field
       if (depth < MAX_RECURSE_DEPTH) {
-        kk_block_make_shared(b);
+        if (!kk_block_try_make_shared(b)) return;
         kk_ssize_t i = 0;
         if (kk_unlikely(scan_fsize >= KK_SCAN_FSIZE_MAX)) { 
           scan_fsize = (kk_ssize_t)kk_intf_unbox(kk_block_field(b, 0)); 
@@ -484,78 +613,85 @@ static kk_decl_noinline void kk_block_mark_shared_rec(kk_block_t* b, const kk_ss
 
 
 
-// mark a large vector
-static kk_decl_noinline void kk_block_mark_shared_recx_large(kk_block_t* b, kk_context_t* ctx) {
-  kk_assert_internal(b->header.scan_fsize == KK_SCAN_FSIZE_MAX);
-  kk_ssize_t scan_fsize = kk_block_scan_fsize(b);
-  for (kk_ssize_t i = 1; i < scan_fsize; i++) {  // start at 1 to skip the large scan field itself
-    if (kk_block_field_should_mark(b, i, ctx)) {
-      kk_block_mark_shared_recx(b, ctx);
+// Stackless marking using a segmented worklist (as for drop cascades); this
+// reads the fields only so (unlike pointer reversal) markers can safely run
+// in parallel over overlapping structures.
+static kk_decl_noinline void kk_block_mark_shared_recx(kk_block_t* b, kk_context_t* ctx)
+{
+  kk_drop_segment_t base;   // initial segment on the stack
+  base.next = NULL;
+  base.count = 0;
+  kk_drop_segment_t* seg = &base;
+  while (true) {
+    if (kk_block_try_make_shared(b)) {
+      kk_ssize_t scan_fsize = b->header.scan_fsize;
+      kk_ssize_t i = 0;
+      if (kk_unlikely(scan_fsize == KK_SCAN_FSIZE_MAX)) {
+        // large object (e.g. kk_vector_t)
+        scan_fsize = kk_block_scan_fsize(b);
+        i++;  // skip the initial large scan_fsize field
+      }
+      kk_block_t* next = NULL;
+      for (; i < scan_fsize; i++) {
+        kk_block_t* child = kk_block_field_should_mark(b, i, ctx);
+        if (child != NULL) {
+          if (next == NULL) { next = child; }
+          else {
+            kk_cpu_prefetch(child);
+            seg = kk_drop_segment_push(seg, child, ctx);
+          }
+        }
+      }
+      if (next != NULL) { b = next; continue; }
     }
+    b = kk_drop_segment_pop(&seg, &base, ctx);
+    if (b == NULL) break;  // all done
   }
-  kk_block_make_shared(b);
 }
 
-// Stackless marking by using pointer reversal
-static kk_decl_noinline void kk_block_mark_shared_recx(kk_block_t* b, kk_context_t* ctx) 
+
+// Mark blocks reachable from `b` up to `depth` levels deep while collecting at
+// most `max` unmarked subtree roots in `roots` (overflowing subtrees are marked
+// in place). The roots can then be marked concurrently -- marking is CAS based
+// so markers may safely race on subtrees that share structure. Used by
+// `kk_task_schedule` (see `thread.c`) to fan large structures out over the
+// task group workers. Returns the number of roots collected.
+static void kk_block_mark_shared_collect_rec(kk_block_t* b, kk_ssize_t depth, kk_block_t** roots, kk_ssize_t max, kk_ssize_t* count, kk_context_t* ctx)
 {
-  kk_block_t* parent = NULL;
-  if (kk_block_is_thread_shared(b)) return;
-  if (b->header.scan_fsize == 0) return;
-  uint8_t i = 0;
-  uint8_t scan_fsize = b->header.scan_fsize;
-
-  // ---- marking fields -----
-markfields:
-  kk_assert_internal(scan_fsize > 0);
-  if (scan_fsize == KK_SCAN_FSIZE_MAX) {
-    // recurse over the stack for large objects (vectors)
-    kk_block_mark_shared_recx_large(b, ctx);
+  if (depth <= 0) {
+    if (*count < max) { roots[(*count)++] = b; }           // collect as a parallel subtree root
+                 else { kk_block_mark_shared_rec(b, 0, ctx); }  // no more space: mark in place
+    return;
   }
-  else {
-    do {
-      kk_block_t* child = kk_block_field_should_mark(b, i, ctx);
-      i++;
-      if (child != NULL) {
-        // move down 
-        // remember our state and link back to the parent
-        kk_block_field_set(b, i-1, _kk_box_new_ptr(parent));  // low-level box as parent can be NULL
-        parent = b;
-        kk_block_field_idx_set(parent,i);
-        b = child;
-        i = 0;
-        scan_fsize = b->header.scan_fsize;
-        goto markfields;
-      }
-    } while (i < scan_fsize);
-    kk_block_make_shared(b);
-  }
-
-  //--- moving back up ------------------
-  while (parent != NULL) {
-    // move up
-    i = kk_block_field_idx(parent);
-    kk_block_t* pparent = _kk_box_ptr( kk_block_field(parent, i-1) );  // low-level unbox on parent
-    kk_block_field_set(parent, i-1, kk_ptr_box(b));  // restore original pointer
-    b = parent;
-    parent = pparent;
-    // and continue visiting the fields
-    scan_fsize = b->header.scan_fsize;
-    if (i >= scan_fsize) {
-      kk_assert_internal(i == scan_fsize);
-      // done, keep moving up
-      kk_block_make_shared(b);
-    }
-    else {
-      // mark the rest of the fields starting at `i` upto `scan_fsize`
-      goto markfields;
+  if (!kk_block_try_make_shared(b)) return;
+  kk_ssize_t scan_fsize = b->header.scan_fsize;
+  kk_ssize_t i = 0;
+  if (kk_unlikely(scan_fsize >= KK_SCAN_FSIZE_MAX)) {
+    scan_fsize = (kk_ssize_t)kk_intf_unbox(kk_block_field(b, 0));
+    i++;  // skip scan field
+  }
+  for (; i < scan_fsize; i++) {
+    kk_block_t* child = kk_block_field_should_mark(b, i, ctx);
+    if (child != NULL) {
+      kk_block_mark_shared_collect_rec(child, depth - 1, roots, max, count, ctx);
     }
   }
-  // done
 }
 
+kk_decl_export kk_ssize_t kk_block_mark_shared_collect(kk_block_t* b, kk_ssize_t depth, kk_block_t** roots, kk_ssize_t max, kk_context_t* ctx) {
+  ctx->heap_escaped = true;  // blocks from this context escape to other threads
+  if (kk_block_is_thread_shared(b)) return 0;
+  if (b->header.scan_fsize == 0) {
+    kk_block_make_shared(b);  // no scan fields
+    return 0;
+  }
+  kk_ssize_t count = 0;
+  kk_block_mark_shared_collect_rec(b, depth, roots, max, &count, ctx);
+  return count;
+}
 
 kk_decl_export void kk_block_mark_shared( kk_block_t* b, kk_context_t* ctx ) {
+  ctx->heap_escaped = true;  // blocks from this context escape to other threads
   if (!kk_block_is_thread_shared(b)) {
     if (b->header.scan_fsize == 0) {
       kk_block_make_shared(b); // no scan fields
@@ -575,6 +711,7 @@ kk_decl_export void kk_box_mark_shared( kk_box_t b, kk_context_t* ctx ) {
 
 kk_decl_export void kk_box_mark_shared_recx(kk_box_t b, kk_context_t* ctx) {
   if (kk_box_is_non_null_ptr(b)) {
+    ctx->heap_escaped = true;  // blocks from this context escape to other threads
     kk_block_mark_shared_recx(kk_ptr_unbox(b), ctx);
   }
 }
@@ -71,7 +71,13 @@ int kk_string_icmp(kk_string_t str1, kk_string_t str2, kk_context_t* ctx) {
 
 
 // Count code points in a valid utf-8 string.
+// The count is cached on large string blocks so repeated counts are O(1).
 kk_ssize_t kk_decl_pure kk_string_count_borrow(kk_string_t str) {
+  _Atomic(kk_ssize_t)* cached = kk_bytes_cached_count_ref(str.bytes);
+  if (cached != NULL) {
+    const kk_ssize_t c = kk_atomic_load_relaxed(cached);
+    if (c > 0) return c;
+  }
   kk_ssize_t len;
   const uint8_t* s = kk_string_buf_borrow(str, &len);
   kk_ssize_t cont = 0;      // continuation character counts
@@ -106,6 +112,9 @@ kk_ssize_t kk_decl_pure kk_string_count_borrow(kk_string_t str) {
   kk_assert_internal(t == end);
   kk_assert_internal(len == (t - s));
   kk_assert_internal(len == 0 || len > cont);
+  if (cached != NULL && len > 0) {
+    kk_atomic_store_relaxed(cached, len - cont);  // benign race: all writers store the same value
+  }
   return (len - cont);
 }
 
@@ -115,6 +124,151 @@ kk_ssize_t kk_decl_pure kk_string_count(kk_string_t str, kk_context_t* ctx) {
   return count;
 }
 
+// A string is ascii iff its character count equals its byte length; character
+// indexing is then direct byte indexing. O(1) after the first count of a string.
+bool kk_decl_pure kk_string_is_ascii_borrow(kk_string_t str) {
+  return (kk_string_count_borrow(str) == kk_string_len_borrow(str));
+}
+
+
+/*--------------------------------------------------------------------------------------------------
+  String interning
+  Symbol-heavy workloads (compilers, parsers) compare the same identifier strings millions of
+  times. The intern table maps bytes to one canonical string so equal interned strings are
+  pointer equal: equality is O(1) in both directions (pointer equality proves equal, and two
+  distinct interned pointers prove unequal) and each symbol is kept in memory once. Canonical
+  strings are marked in the `_field_idx` header byte and marked thread-shared as the table is
+  process wide. The table owns one reference per entry; `kk_string_intern_clear` releases them
+  (un-marking the survivors) so symbols no longer referenced elsewhere are reclaimed -- a fully
+  automatic weak table would need a hook in the Perceus drop fast path.
+--------------------------------------------------------------------------------------------------*/
+
+typedef struct kk_intern_entry_s {
+  kk_string_t str;      // canonical string; an empty slot has `str.bytes.dbox == 0`
+  uint64_t    hash;
+} kk_intern_entry_t;
+
+static kk_intern_entry_t* kk_intern_table = NULL;  // open addressing, power-of-two capacity
+static kk_ssize_t         kk_intern_capacity = 0;
+static kk_ssize_t         kk_intern_count = 0;
+static _Atomic(int32_t)   kk_intern_lock;          // 0 = free (tiny spinlock; probes are O(1))
+
+#define KK_INTERN_INITIAL_CAPACITY  (1024)
+
+static void kk_intern_acquire(void) {
+  int32_t expected = 0;
+  while (!kk_atomic_cas_weak_acq_rel(&kk_intern_lock, &expected, 1)) { expected = 0; }
+}
+
+static void kk_intern_release(void) {
+  kk_atomic_store_release(&kk_intern_lock, 0);
+}
+
+// FNV-1a over the utf-8 bytes
+static uint64_t kk_intern_hash(const uint8_t* s, kk_ssize_t len) {
+  uint64_t h = KK_U64(14695981039346656037);
+  for (kk_ssize_t i = 0; i < len; i++) {
+    h = (h ^ s[i]) * KK_U64(1099511628211);
+  }
+  return h;
+}
+
+// Return the index of the matching entry, or of the empty slot where it should go.
+static kk_ssize_t kk_intern_lookup(const uint8_t* s, kk_ssize_t len, uint64_t hash) {
+  kk_ssize_t i = (kk_ssize_t)(hash & (uint64_t)(kk_intern_capacity - 1));
+  while (kk_intern_table[i].str.bytes.dbox != 0) {
+    if (kk_intern_table[i].hash == hash) {
+      kk_ssize_t elen;
+      const uint8_t* ebuf = kk_string_buf_borrow(kk_intern_table[i].str, &elen);
+      if (elen == len && kk_memcmp(ebuf, s, len) == 0) return i;
+    }
+    i = ((i + 1) & (kk_intern_capacity - 1));
+  }
+  return i;
+}
+
+static void kk_intern_grow(kk_ssize_t capacity, kk_context_t* ctx) {
+  kk_intern_entry_t* old = kk_intern_table;
+  const kk_ssize_t oldcap = kk_intern_capacity;
+  kk_intern_table = (kk_intern_entry_t*)kk_zalloc(capacity * kk_ssizeof(kk_intern_entry_t), ctx);
+  kk_intern_capacity = capacity;
+  for (kk_ssize_t j = 0; j < oldcap; j++) {
+    if (old[j].str.bytes.dbox != 0) {
+      kk_ssize_t i = (kk_ssize_t)(old[j].hash & (uint64_t)(capacity - 1));
+      while (kk_intern_table[i].str.bytes.dbox != 0) { i = ((i + 1) & (capacity - 1)); }
+      kk_intern_table[i] = old[j];
+    }
+  }
+  if (old != NULL) kk_free(old, ctx);
+}
+
+kk_string_t kk_string_intern(kk_string_t s, kk_context_t* ctx) {
+  if (!kk_datatype_is_ptr(s.bytes)) return s;      // the empty singleton is canonical already
+  if (kk_string_is_interned_borrow(s)) return s;
+  kk_ssize_t len;
+  const uint8_t* buf = kk_string_buf_borrow(s, &len);
+  const uint64_t hash = kk_intern_hash(buf, len);
+  kk_intern_acquire();
+  if (kk_intern_table != NULL) {
+    const kk_ssize_t i = kk_intern_lookup(buf, len, hash);
+    if (kk_intern_table[i].str.bytes.dbox != 0) {
+      kk_string_t canon = kk_string_dup(kk_intern_table[i].str);
+      kk_intern_release();
+      kk_string_drop(s, ctx);
+      return canon;
+    }
+  }
+  kk_intern_release();
+  // prepare the canonical string outside the lock (allocation and sharing can be slow)
+  kk_string_t canon;
+  const kk_tag_t tag = kk_datatype_tag(s.bytes);
+  if (tag == KK_TAG_BYTES || tag == KK_TAG_BYTES_SMALL) {
+    canon = s;   // adopt `s` itself
+  }
+  else {
+    canon = kk_string_alloc_dupn_valid_utf8(len, buf, ctx);  // copy out of a view or raw buffer
+    kk_string_drop(s, ctx);
+    if (!kk_datatype_is_ptr(canon.bytes)) return canon;      // a non-canonical empty string
+  }
+  buf = kk_string_buf_borrow(canon, &len);
+  kk_block_mark_shared(kk_datatype_as_ptr(canon.bytes), ctx);  // the table is process wide
+  kk_intern_acquire();
+  if (kk_intern_table == NULL) {
+    kk_intern_grow(KK_INTERN_INITIAL_CAPACITY, ctx);
+  }
+  else if (4*(kk_intern_count + 1) > 3*kk_intern_capacity) {
+    kk_intern_grow(2*kk_intern_capacity, ctx);
+  }
+  const kk_ssize_t i = kk_intern_lookup(buf, len, hash);
+  if (kk_intern_table[i].str.bytes.dbox != 0) {
+    // another thread interned the same bytes in the meantime
+    kk_string_t other = kk_string_dup(kk_intern_table[i].str);
+    kk_intern_release();
+    kk_string_drop(canon, ctx);
+    return other;
+  }
+  kk_intern_table[i].str = kk_string_dup(canon);   // the table owns one reference
+  kk_intern_table[i].hash = hash;
+  kk_intern_count++;
+  kk_datatype_as_ptr(canon.bytes)->header._field_idx = KK_STRING_INTERNED;  // benign race: readers see 0 or the mark
+  kk_intern_release();
+  return canon;
+}
+
+void kk_string_intern_clear(kk_context_t* ctx) {
+  kk_intern_acquire();
+  for (kk_ssize_t i = 0; i < kk_intern_capacity; i++) {
+    kk_string_t s = kk_intern_table[i].str;
+    if (s.bytes.dbox != 0) {
+      kk_datatype_as_ptr(s.bytes)->header._field_idx = 0;  // survivors compare byte-wise again
+      kk_string_drop(s, ctx);
+      kk_intern_table[i].str.bytes.dbox = 0;
+    }
+  }
+  kk_intern_count = 0;
+  kk_intern_release();
+}
+
 
 /*--------------------------------------------------------------------------------------------------
  Utf-8 read/write
@@ -278,30 +432,220 @@ kk_char_t kk_utf8_read_validate(const uint8_t* s, kk_ssize_t* count, kk_ssize_t*
   return (KK_RAW_UTF8_OFS + b);
 }
 
+/*--------------------------------------------------------------------------------------------------
+  Vectorized qutf-8 validation
+  The hot path skips runs of ascii 16 bytes at a time and validates multi-byte
+  chunks with the table-lookup algorithm of Keiser and Lemire ("Validating
+  UTF-8 in less than one instruction per byte", Softw. Pract. Exper. 2021).
+  Sequences that may encode the raw plane (lead byte 0xF3 and up) and invalid
+  suffixes always fall back to the scalar `kk_utf8_read_validate`.
+--------------------------------------------------------------------------------------------------*/
+
+#if defined(__SSE2__) || (defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define KK_QUTF8_SSE2   (1)
+#include <emmintrin.h>
+#if defined(__SSSE3__)
+// compiled with ssse3 enabled
+#define KK_QUTF8_SSSE3  (1)
+#define kk_target_ssse3
+#define kk_qutf8_simd_available()  (true)
+#elif defined(_MSC_VER)
+// msvc compiles the intrinsics regardless of the target; select on the cpu at runtime
+#define KK_QUTF8_SSSE3  (1)
+#define kk_target_ssse3
+#define kk_qutf8_simd_available()  kk_cpu_has(KK_CPU_X64_SSSE3)
+#elif defined(__GNUC__)
+// compile the kernel for ssse3 and select on the cpu at runtime (see `bits.h`)
+#define KK_QUTF8_SSSE3  (1)
+#define kk_target_ssse3 __attribute__((target("ssse3")))
+#define kk_qutf8_simd_available()  kk_cpu_has(KK_CPU_X64_SSSE3)
+#endif
+#if defined(KK_QUTF8_SSSE3)
+#include <tmmintrin.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define KK_QUTF8_NEON   (1)
+#define kk_target_ssse3
+#define kk_qutf8_simd_available()  (true)
+#include <arm_neon.h>
+#endif
+
+// skip over the longest run of ascii bytes
+static const uint8_t* kk_qutf8_ascii_run(const uint8_t* p, const uint8_t* end) {
+#if defined(KK_QUTF8_SSE2)
+  while (end - p >= 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)p);
+    const uint32_t mask = (uint32_t)_mm_movemask_epi8(v);
+    if (mask != 0) return (p + kk_bits_ctz32(mask));
+    p += 16;
+  }
+#elif defined(KK_QUTF8_NEON)
+  while (end - p >= 16) {
+    if (vmaxvq_u8(vld1q_u8(p)) >= 0x80) break;
+    p += 16;
+  }
+#endif
+  // word-at-a-time tail (and portable fallback)
+  while (end - p >= kk_ssizeof(kk_uintx_t)) {
+    kk_uintx_t w;
+    kk_memcpy(&w, p, sizeof(w));
+    if ((w & (KK_UX(0x80808080) | ((kk_uintx_t)KK_UX(0x80808080) << (KK_INTX_BITS/2)))) != 0) break;
+    p += sizeof(w);
+  }
+  while (p < end && *p < 0x80) { p++; }
+  return p;
+}
+
+#if defined(KK_QUTF8_SSSE3) || defined(KK_QUTF8_NEON)
+#define KK_QUTF8_SIMD   (1)
+
+// error bits for the byte-pair classification tables
+#define KK_QUTF8_TOO_SHORT       (1<<0)   // lead byte followed by another lead or ascii
+#define KK_QUTF8_TOO_LONG        (1<<1)   // ascii followed by a continuation byte
+#define KK_QUTF8_OVERLONG_3      (1<<2)   // 0xE0 with a continuation below 0xA0
+#define KK_QUTF8_TOO_LARGE       (1<<3)   // above 0x10FFFF
+#define KK_QUTF8_SURROGATE       (1<<4)   // 0xED with a continuation above 0x9F
+#define KK_QUTF8_OVERLONG_2      (1<<5)   // 0xC0 or 0xC1 lead
+#define KK_QUTF8_TOO_LARGE_1000  (1<<6)
+#define KK_QUTF8_OVERLONG_4      (1<<6)   // 0xF0 with a continuation below 0x90
+#define KK_QUTF8_TWO_CONTS       (1<<7)   // two continuation bytes in a row
+#define KK_QUTF8_CARRY           (KK_QUTF8_TOO_SHORT | KK_QUTF8_TOO_LONG | KK_QUTF8_TWO_CONTS)
+
+// given a chunk that starts at a sequence boundary, return the number of bytes up
+// to the last complete sequence; the trailing partial sequence is validated next round.
+static kk_ssize_t kk_qutf8_chunk_boundary(const uint8_t* p, kk_ssize_t n) {
+  for (kk_ssize_t k = 1; k <= 3 && k <= n; k++) {
+    const uint8_t b = p[n-k];
+    if (b < 0x80) break;       // ascii ends a sequence
+    if (b >= 0xC0) {           // lead byte: is its sequence complete within the chunk?
+      const kk_ssize_t need = (b >= 0xF0 ? 4 : (b >= 0xE0 ? 3 : 2));
+      return (need > k ? n - k : n);
+    }
+  }
+  return n;
+}
+
+// Validate a 16 byte chunk that starts at a sequence boundary; return the number of
+// bytes validated (up to the last complete sequence), or 0 to defer to the scalar path
+// (on invalid input, or bytes >= 0xF3 that may encode the raw plane).
+static kk_target_ssse3 kk_ssize_t kk_qutf8_validate_chunk16(const uint8_t* p) {
+  // classification tables indexed by the high nibble of the previous byte, the
+  // low nibble of the previous byte, and the high nibble of the current byte
+  static const uint8_t tbl_1_high[16] = {
+    KK_QUTF8_TOO_LONG, KK_QUTF8_TOO_LONG, KK_QUTF8_TOO_LONG, KK_QUTF8_TOO_LONG,
+    KK_QUTF8_TOO_LONG, KK_QUTF8_TOO_LONG, KK_QUTF8_TOO_LONG, KK_QUTF8_TOO_LONG,
+    KK_QUTF8_TWO_CONTS, KK_QUTF8_TWO_CONTS, KK_QUTF8_TWO_CONTS, KK_QUTF8_TWO_CONTS,
+    KK_QUTF8_TOO_SHORT | KK_QUTF8_OVERLONG_2,
+    KK_QUTF8_TOO_SHORT,
+    KK_QUTF8_TOO_SHORT | KK_QUTF8_OVERLONG_3 | KK_QUTF8_SURROGATE,
+    KK_QUTF8_TOO_SHORT | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000 | KK_QUTF8_OVERLONG_4
+  };
+  static const uint8_t tbl_1_low[16] = {
+    KK_QUTF8_CARRY | KK_QUTF8_OVERLONG_2 | KK_QUTF8_OVERLONG_3 | KK_QUTF8_OVERLONG_4,
+    KK_QUTF8_CARRY | KK_QUTF8_OVERLONG_2,
+    KK_QUTF8_CARRY, KK_QUTF8_CARRY,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000 | KK_QUTF8_SURROGATE,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000,
+    KK_QUTF8_CARRY | KK_QUTF8_TOO_LARGE | KK_QUTF8_TOO_LARGE_1000
+  };
+  static const uint8_t tbl_2_high[16] = {
+    KK_QUTF8_TOO_SHORT, KK_QUTF8_TOO_SHORT, KK_QUTF8_TOO_SHORT, KK_QUTF8_TOO_SHORT,
+    KK_QUTF8_TOO_SHORT, KK_QUTF8_TOO_SHORT, KK_QUTF8_TOO_SHORT, KK_QUTF8_TOO_SHORT,
+    KK_QUTF8_TOO_LONG | KK_QUTF8_OVERLONG_2 | KK_QUTF8_TWO_CONTS | KK_QUTF8_OVERLONG_3 | KK_QUTF8_TOO_LARGE_1000,
+    KK_QUTF8_TOO_LONG | KK_QUTF8_OVERLONG_2 | KK_QUTF8_TWO_CONTS | KK_QUTF8_OVERLONG_3 | KK_QUTF8_TOO_LARGE,
+    KK_QUTF8_TOO_LONG | KK_QUTF8_OVERLONG_2 | KK_QUTF8_TWO_CONTS | KK_QUTF8_SURROGATE | KK_QUTF8_TOO_LARGE,
+    KK_QUTF8_TOO_LONG | KK_QUTF8_OVERLONG_2 | KK_QUTF8_TWO_CONTS | KK_QUTF8_SURROGATE | KK_QUTF8_TOO_LARGE,
+    KK_QUTF8_TOO_SHORT, KK_QUTF8_TOO_SHORT, KK_QUTF8_TOO_SHORT, KK_QUTF8_TOO_SHORT
+  };
+#if defined(KK_QUTF8_SSSE3)
+  const __m128i v    = _mm_loadu_si128((const __m128i*)p);
+  const __m128i zero = _mm_setzero_si128();
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(v, _mm_set1_epi8((char)0xF2)), zero)) != 0xFFFF) {
+    return 0;  // a byte >= 0xF3: may encode the raw plane
+  }
+  const __m128i lonib = _mm_set1_epi8(0x0F);
+  const __m128i prev1 = _mm_slli_si128(v, 1);
+  const __m128i byte_1_high = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)tbl_1_high),
+                                               _mm_and_si128(_mm_srli_epi16(prev1, 4), lonib));
+  const __m128i byte_1_low  = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)tbl_1_low),
+                                               _mm_and_si128(prev1, lonib));
+  const __m128i byte_2_high = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)tbl_2_high),
+                                               _mm_and_si128(_mm_srli_epi16(v, 4), lonib));
+  const __m128i sc = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+  // the 3rd and 4th bytes of a long sequence must be continuations (cancel their TWO_CONTS bit)
+  const __m128i third  = _mm_subs_epu8(_mm_slli_si128(v, 2), _mm_set1_epi8((char)0xDF));
+  const __m128i fourth = _mm_subs_epu8(_mm_slli_si128(v, 3), _mm_set1_epi8((char)0xEF));
+  const __m128i must23 = _mm_cmpgt_epi8(_mm_or_si128(third, fourth), zero);
+  const __m128i err    = _mm_xor_si128(sc, _mm_and_si128(must23, _mm_set1_epi8((char)0x80)));
+  const uint32_t errmask = 0xFFFFU ^ (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(err, zero));
+  const kk_ssize_t bound = kk_qutf8_chunk_boundary(p, 16);
+  if ((errmask & ((1U << bound) - 1)) != 0) return 0;
+  return bound;
+#else  // KK_QUTF8_NEON
+  const uint8x16_t v = vld1q_u8(p);
+  if (vmaxvq_u8(v) >= 0xF3) return 0;  // a byte that may encode the raw plane
+  const uint8x16_t zero  = vdupq_n_u8(0);
+  const uint8x16_t prev1 = vextq_u8(zero, v, 15);
+  const uint8x16_t byte_1_high = vqtbl1q_u8(vld1q_u8(tbl_1_high), vshrq_n_u8(prev1, 4));
+  const uint8x16_t byte_1_low  = vqtbl1q_u8(vld1q_u8(tbl_1_low), vandq_u8(prev1, vdupq_n_u8(0x0F)));
+  const uint8x16_t byte_2_high = vqtbl1q_u8(vld1q_u8(tbl_2_high), vshrq_n_u8(v, 4));
+  const uint8x16_t sc = vandq_u8(vandq_u8(byte_1_high, byte_1_low), byte_2_high);
+  const uint8x16_t third  = vcgeq_u8(vextq_u8(zero, v, 14), vdupq_n_u8(0xE0));
+  const uint8x16_t fourth = vcgeq_u8(vextq_u8(zero, v, 13), vdupq_n_u8(0xF0));
+  const uint8x16_t must23 = vorrq_u8(third, fourth);
+  const uint8x16_t err = veorq_u8(sc, vandq_u8(must23, vdupq_n_u8(0x80)));
+  uint8_t errbytes[16];
+  vst1q_u8(errbytes, err);
+  const kk_ssize_t bound = kk_qutf8_chunk_boundary(p, 16);
+  for (kk_ssize_t i = 0; i < bound; i++) {
+    if (errbytes[i] != 0) return 0;
+  }
+  return bound;
+#endif
+}
+#endif  // KK_QUTF8_SIMD
+
 // validate a qutf8 sequence; return in `pvlen` the bytes needed to convert to a valid utf8 sequence.
 static bool kk_qutf8_validate(kk_ssize_t len, const uint8_t* s, bool qutf8_identity, kk_ssize_t* pvlen) {
   const uint8_t* const end = s + len;
   kk_ssize_t vlen = 0;
   const uint8_t* p = s;
   while (p < end) {
-    // optimize for ascii
-    // todo: optimize further with word reads?
-    if (kk_likely(*p < 0x80)) {
-      p++;
-      vlen++;
+    // skip over runs of ascii
+    const uint8_t* q = kk_qutf8_ascii_run(p, end);
+    vlen += (q - p);
+    p = q;
+    if (p >= end) break;
+    // at the start of a multi-byte (or invalid) sequence
+#if defined(KK_QUTF8_SIMD)
+    if (kk_qutf8_simd_available() && end - p >= 16) {
+      const kk_ssize_t n = kk_qutf8_validate_chunk16(p);
+      if (n > 0) {
+        p += n;
+        vlen += n;
+        continue;
+      }
+    }
+#endif
+    kk_ssize_t count;
+    kk_ssize_t vcount = 0;
+    kk_utf8_read_validate(p, &count, &vcount, qutf8_identity);
+    p += count;
+    if (vcount == 0) {
+      vlen += count;
     }
     else {
-      kk_ssize_t count;
-      kk_ssize_t vcount = 0;
-      kk_utf8_read_validate(p, &count, &vcount, qutf8_identity);
-      p += count;
-      if (vcount == 0) {
-        vlen += count;
-      }
-      else {
-        kk_assert_internal(count != vcount);
-        vlen += vcount;
-      }
+      kk_assert_internal(count != vcount);
+      vlen += vcount;
     }
   }
   kk_assert_internal(p == end);
@@ -330,12 +674,16 @@ static kk_string_t kk_qutf8_convert_from_invalid(kk_ssize_t len, const uint8_t*
   const uint8_t* p = s;
   const uint8_t* end = s + len;
   while (p < end) {
-    if (kk_likely(*p < 0x80)) {
-      *t++ = *p++;
+    // copy runs of ascii at once
+    const uint8_t* q = kk_qutf8_ascii_run(p, end);
+    if (q > p) {
+      kk_memcpy(t, p, q - p);
+      t += (q - p);
+      p = q;
     }
-    else {
-      // copy sequence    
-      // todo: this can be optimized a lot more..
+    if (p >= end) break;
+    {
+      // copy sequence
       kk_ssize_t count;
       kk_char_t c = kk_utf8_read_validate(p, &count, NULL, qutf8_identity);
       p += count;
@@ -463,8 +811,189 @@ const char* kk_string_to_qutf8_borrow(kk_string_t str, bool* should_free, kk_con
 
 /*--------------------------------------------------------------------------------------------------
   qutf-16 encoding/decoding
+  The windows path layer round-trips every file name through these conversions, so runs
+  of ascii code units are narrowed (or widened) 16 or 32 at a time; only multi-byte
+  sequences and surrogates take the scalar path. As for `kk_bytes_find`, the avx2
+  kernels are selected at runtime through the cpu feature detection in `bits.h`.
 --------------------------------------------------------------------------------------------------*/
 
+#if defined(KK_QUTF8_SSE2)
+#define KK_QUTF16_SSE2  (1)
+#if defined(__AVX2__)
+// compiled with avx2 enabled
+#define KK_QUTF16_AVX2  (1)
+#define kk_target_avx2
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+// msvc compiles the intrinsics regardless of the target; select on the cpu at runtime
+#define KK_QUTF16_AVX2  (1)
+#define kk_target_avx2
+#include <immintrin.h>
+#elif defined(__GNUC__)
+// compile the kernels for avx2 and select on the cpu at runtime (see `bits.h`)
+#define KK_QUTF16_AVX2  (1)
+#define kk_target_avx2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+#elif defined(KK_QUTF8_NEON)
+#define KK_QUTF16_NEON  (1)
+#endif
+
+#if defined(KK_QUTF16_SSE2)
+// narrow a block-aligned run of ascii code units to utf-8 (or just measure it when `q` is NULL)
+static const uint16_t* kk_qutf16_narrow_sse2(const uint16_t* p, const uint16_t* end, uint8_t* q) {
+  const __m128i mask = _mm_set1_epi16((int16_t)0xFF80);
+  const __m128i zero = _mm_setzero_si128();
+  while (end - p >= 16) {
+    const __m128i lo = _mm_loadu_si128((const __m128i*)p);
+    const __m128i hi = _mm_loadu_si128((const __m128i*)(p + 8));
+    const __m128i m  = _mm_and_si128(_mm_or_si128(lo, hi), mask);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(m, zero)) != 0xFFFF) break;
+    if (q != NULL) {
+      _mm_storeu_si128((__m128i*)q, _mm_packus_epi16(lo, hi));
+      q += 16;
+    }
+    p += 16;
+  }
+  return p;
+}
+
+// widen a block-aligned run of ascii bytes to utf-16
+static const uint8_t* kk_qutf16_widen_sse2(const uint8_t* p, const uint8_t* end, uint16_t* q) {
+  const __m128i zero = _mm_setzero_si128();
+  while (end - p >= 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)p);
+    if (_mm_movemask_epi8(v) != 0) break;
+    _mm_storeu_si128((__m128i*)q, _mm_unpacklo_epi8(v, zero));
+    _mm_storeu_si128((__m128i*)(q + 8), _mm_unpackhi_epi8(v, zero));
+    q += 16;
+    p += 16;
+  }
+  return p;
+}
+#endif
+
+#if defined(KK_QUTF16_AVX2)
+static kk_target_avx2 const uint16_t* kk_qutf16_narrow_avx2(const uint16_t* p, const uint16_t* end, uint8_t* q) {
+  const __m256i mask = _mm256_set1_epi16((int16_t)0xFF80);
+  while (end - p >= 32) {
+    const __m256i lo = _mm256_loadu_si256((const __m256i*)p);
+    const __m256i hi = _mm256_loadu_si256((const __m256i*)(p + 16));
+    if (!_mm256_testz_si256(_mm256_or_si256(lo, hi), mask)) break;
+    if (q != NULL) {
+      // `packus` interleaves the 128-bit lanes; permute them back into order
+      _mm256_storeu_si256((__m256i*)q, _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8));
+      q += 32;
+    }
+    p += 32;
+  }
+  return kk_qutf16_narrow_sse2(p, end, q);
+}
+
+static kk_target_avx2 const uint8_t* kk_qutf16_widen_avx2(const uint8_t* p, const uint8_t* end, uint16_t* q) {
+  while (end - p >= 32) {
+    const __m256i v = _mm256_loadu_si256((const __m256i*)p);
+    if (_mm256_movemask_epi8(v) != 0) break;
+    _mm256_storeu_si256((__m256i*)q, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+    _mm256_storeu_si256((__m256i*)(q + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+    q += 32;
+    p += 32;
+  }
+  return kk_qutf16_widen_sse2(p, end, q);
+}
+
+#if !defined(__AVX2__)
+typedef const uint16_t* (*kk_qutf16_narrow_fun_t)(const uint16_t* p, const uint16_t* end, uint8_t* q);
+typedef const uint8_t*  (*kk_qutf16_widen_fun_t)(const uint8_t* p, const uint8_t* end, uint16_t* q);
+static kk_qutf16_narrow_fun_t kk_qutf16_narrow_fun;
+static kk_qutf16_widen_fun_t  kk_qutf16_widen_fun;
+#endif
+#endif
+
+#if defined(KK_QUTF16_NEON)
+static const uint16_t* kk_qutf16_narrow_neon(const uint16_t* p, const uint16_t* end, uint8_t* q) {
+  while (end - p >= 16) {
+    const uint16x8_t lo = vld1q_u16(p);
+    const uint16x8_t hi = vld1q_u16(p + 8);
+    if (vmaxvq_u16(vorrq_u16(lo, hi)) > 0x7F) break;
+    if (q != NULL) {
+      vst1q_u8(q, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+      q += 16;
+    }
+    p += 16;
+  }
+  return p;
+}
+
+static const uint8_t* kk_qutf16_widen_neon(const uint8_t* p, const uint8_t* end, uint16_t* q) {
+  while (end - p >= 16) {
+    const uint8x16_t v = vld1q_u8(p);
+    if (vmaxvq_u8(v) >= 0x80) break;
+    vst1q_u16(q, vmovl_u8(vget_low_u8(v)));
+    vst1q_u16(q + 8, vmovl_u8(vget_high_u8(v)));
+    q += 16;
+    p += 16;
+  }
+  return p;
+}
+#endif
+
+// narrow the longest leading run of ascii code units into `q` (or just count it when `q` is NULL);
+// returns the end of the run (the caller advances `q` by the same amount).
+static const uint16_t* kk_qutf16_ascii_narrow(const uint16_t* p, const uint16_t* end, uint8_t* q) {
+#if defined(KK_QUTF16_SSE2) || defined(KK_QUTF16_NEON)
+  const uint16_t* const p0 = p;
+  #if defined(KK_QUTF16_AVX2) && defined(__AVX2__)
+  p = kk_qutf16_narrow_avx2(p, end, q);
+  #elif defined(KK_QUTF16_AVX2)
+  kk_cpu_dispatch(kk_qutf16_narrow_fun, KK_CPU_X64_AVX2, &kk_qutf16_narrow_avx2, &kk_qutf16_narrow_sse2);
+  p = kk_qutf16_narrow_fun(p, end, q);
+  #elif defined(KK_QUTF16_SSE2)
+  p = kk_qutf16_narrow_sse2(p, end, q);
+  #else
+  p = kk_qutf16_narrow_neon(p, end, q);
+  #endif
+  if (q != NULL) { q += (p - p0); }
+#endif
+  // word-at-a-time tail (and portable fallback)
+  while (end - p >= 4) {
+    uint64_t w;
+    kk_memcpy(&w, p, sizeof(w));
+    if ((w & KK_U64(0xFF80FF80FF80FF80)) != 0) break;
+    if (q != NULL) {
+      q[0] = (uint8_t)p[0]; q[1] = (uint8_t)p[1]; q[2] = (uint8_t)p[2]; q[3] = (uint8_t)p[3];
+      q += 4;
+    }
+    p += 4;
+  }
+  while (p < end && *p <= 0x7F) {
+    if (q != NULL) { *q++ = (uint8_t)*p; }
+    p++;
+  }
+  return p;
+}
+
+// widen the longest leading run of ascii bytes into `q`;
+// returns the end of the run (the caller advances `q` by the same amount).
+static const uint8_t* kk_qutf16_ascii_widen(const uint8_t* p, const uint8_t* end, uint16_t* q) {
+#if defined(KK_QUTF16_SSE2) || defined(KK_QUTF16_NEON)
+  const uint8_t* const p0 = p;
+  #if defined(KK_QUTF16_AVX2) && defined(__AVX2__)
+  p = kk_qutf16_widen_avx2(p, end, q);
+  #elif defined(KK_QUTF16_AVX2)
+  kk_cpu_dispatch(kk_qutf16_widen_fun, KK_CPU_X64_AVX2, &kk_qutf16_widen_avx2, &kk_qutf16_widen_sse2);
+  p = kk_qutf16_widen_fun(p, end, q);
+  #elif defined(KK_QUTF16_SSE2)
+  p = kk_qutf16_widen_sse2(p, end, q);
+  #else
+  p = kk_qutf16_widen_neon(p, end, q);
+  #endif
+  q += (p - p0);
+#endif
+  while (p < end && *p < 0x80) { *q++ = *p++; }
+  return p;
+}
+
 uint16_t* kk_string_to_qutf16_borrow(kk_string_t str, kk_context_t* ctx) {
   kk_ssize_t len;
   const uint8_t* const s = kk_string_buf_borrow(str, &len);
@@ -473,6 +1002,11 @@ uint16_t* kk_string_to_qutf16_borrow(kk_string_t str, kk_context_t* ctx) {
   // count utf-16 length (in 16-bit units)
   kk_ssize_t wlen = 0;
   for (const uint8_t* p = s; p < end; ) {
+    // runs of ascii are one unit per byte
+    const uint8_t* r = kk_qutf8_ascii_run(p, end);
+    wlen += (r - p);
+    p = r;
+    if (p >= end) break;
     kk_ssize_t count;
     kk_char_t c = kk_utf8_read(p, &count);
     p += count;
@@ -487,6 +1021,11 @@ uint16_t* kk_string_to_qutf16_borrow(kk_string_t str, kk_context_t* ctx) {
   uint16_t* wstr = (uint16_t*)kk_malloc((wlen + 1) * kk_ssizeof(uint16_t), ctx);
   uint16_t* q = wstr;
   for (const uint8_t* p = s; p < end; ) {
+    // widen runs of ascii at once
+    const uint8_t* r = kk_qutf16_ascii_widen(p, end, q);
+    q += (r - p);
+    p = r;
+    if (p >= end) break;
     kk_ssize_t count;
     kk_char_t c = kk_utf8_read(p, &count);
     p += count;
@@ -515,15 +1054,19 @@ static kk_string_t kk_string_alloc_from_qutf16n_prim(kk_ssize_t wlen, const uint
   // count utf-8 length
   kk_ssize_t len = 0;
   const uint16_t* const end = wstr + wlen;
-  for (const uint16_t* p = wstr; p < end; p++) {
-    if (*p <= 0x7F) {
-      len++;
-    }
-    else if (*p <= 0x7FF) {
+  for (const uint16_t* p = wstr; p < end; ) {
+    // runs of ascii are one byte per unit
+    const uint16_t* r = kk_qutf16_ascii_narrow(p, end, NULL);
+    len += (r - p);
+    p = r;
+    if (p >= end) break;
+    if (*p <= 0x7FF) {
       len += 2;
+      p++;
     }
-    else if (*p <= 0xD800 || *p > 0xDFFF) {
+    else if (*p < 0xD800 || *p > 0xDFFF) {
       len += 3;
+      p++;
     }
     else if (*p <= 0xDBFF && p+1 < end && (p[1] >= 0xDC00 && p[1] <= 0xDFFF)) {
       if (qutf16_identity) {
@@ -531,17 +1074,19 @@ static kk_string_t kk_string_alloc_from_qutf16n_prim(kk_ssize_t wlen, const uint
         if (kk_char_is_raw(c)) {
           // invalid codepoint in raw range; decode as two lone surrogates
           len += 4;
+          p++;
           continue;
         }
         // fallthrough
       }
       // valid surrogate
       len += 4;
-      p++;  // skip the other half of the surrogate
+      p += 2;  // skip the other half of the surrogate
     }
     else {
       // lone half of a surrogate: encoded in the raw range
       len += 4;
+      p++;
     }
   }
 
@@ -549,34 +1094,36 @@ static kk_string_t kk_string_alloc_from_qutf16n_prim(kk_ssize_t wlen, const uint
   uint8_t* s;
   kk_string_t str = kk_unsafe_string_alloc_buf(len, &s, ctx);
   uint8_t* q = s;
-  for (const uint16_t* p = wstr; p < end; p++) {
-    // optimize for ascii
-    if (*p <= 0x7F) {
-      *q++ = (uint8_t)*p;
+  for (const uint16_t* p = wstr; p < end; ) {
+    // narrow runs of ascii at once
+    const uint16_t* r = kk_qutf16_ascii_narrow(p, end, q);
+    q += (r - p);
+    p = r;
+    if (p >= end) break;
+    kk_char_t c;
+    if (*p < 0xD800 || *p > 0xDFFF) {
+      c = *p;
+      p++;
     }
-    else {
-      kk_char_t c;
-      if (*p <= 0xD800) {
-        c = *p;
-      }
-      else if (*p <= 0xDBFF && p+1 < end && (p[1] >= 0xDC00 && p[1] <= 0xDFFF)) {
-        c = 0x10000 + (((kk_char_t)(p[0]) - 0xD800) << 10) + ((kk_char_t)(p[1]) - 0xDC00);
-        if (qutf16_identity && kk_char_is_raw(c)) {
-          // codepoint in raw range: encode as two lone surrogate halves
-          c = KK_RAW_UTF16_OFS + (kk_char_t)(*p);
-        }
-        else {
-          p++; // skip the second surrogate half
-        }
+    else if (*p <= 0xDBFF && p+1 < end && (p[1] >= 0xDC00 && p[1] <= 0xDFFF)) {
+      c = 0x10000 + (((kk_char_t)(p[0]) - 0xD800) << 10) + ((kk_char_t)(p[1]) - 0xDC00);
+      if (qutf16_identity && kk_char_is_raw(c)) {
+        // codepoint in raw range: encode as two lone surrogate halves
+        c = KK_RAW_UTF16_OFS + (kk_char_t)(*p);
+        p++;
       }
       else {
-        // lone half of a surrogate: encoded in the raw range
-        c = KK_RAW_UTF16_OFS + (kk_char_t)(*p);
+        p += 2; // skip the second surrogate half
       }
-      kk_ssize_t count;
-      kk_utf8_write(c, q, &count);
-      q += count;
     }
+    else {
+      // lone half of a surrogate: encoded in the raw range
+      c = KK_RAW_UTF16_OFS + (kk_char_t)(*p);
+      p++;
+    }
+    kk_ssize_t count;
+    kk_utf8_write(c, q, &count);
+    q += count;
   }
   *q = 0;
   kk_assert_internal(q == s + len && *q == 0);
@@ -780,12 +1327,99 @@ kk_vector_t kk_string_splitv_atmost(kk_string_t str, kk_string_t sepstr, kk_ssiz
 
 
 /*--------------------------------------------------------------------------------------------------
-
+  Ascii case conversion and trimming
+  The batch kernels below process 16 bytes per iteration with a scalar tail,
+  reusing the simd detection of the qutf-8 section above; the per-char helpers
+  at the top of the file remain for the byte-at-a-time paths (like `kk_memicmp`).
 --------------------------------------------------------------------------------------------------*/
 
+// Flip the case bit 0x20 of every byte in `[lo,lo+25]`; maps a-z to A-Z for
+// `lo='a'` and A-Z to a-z for `lo='A'`. Non-ascii utf-8 bytes (>= 0x80) pass
+// through untouched. `t` may alias `s` (for the in-place paths).
+static void kk_ascii_convert_case(uint8_t* t, const uint8_t* s, kk_ssize_t len, uint8_t lo) {
+  kk_ssize_t i = 0;
+#if defined(KK_QUTF8_SSE2)
+  const __m128i vlo = _mm_set1_epi8((char)lo);
+  const __m128i vhi = _mm_set1_epi8((char)(lo + 25));
+  const __m128i bit = _mm_set1_epi8(0x20);
+  for (; i + 16 <= len; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+    // unsigned in-range test: clamping to [lo,hi] is the identity exactly in range
+    const __m128i inrange = _mm_cmpeq_epi8(_mm_min_epu8(_mm_max_epu8(v, vlo), vhi), v);
+    _mm_storeu_si128((__m128i*)(t + i), _mm_xor_si128(v, _mm_and_si128(inrange, bit)));
+  }
+#elif defined(KK_QUTF8_NEON)
+  const uint8x16_t vlo = vdupq_n_u8(lo);
+  const uint8x16_t vhi = vdupq_n_u8(lo + 25);
+  const uint8x16_t bit = vdupq_n_u8(0x20);
+  for (; i + 16 <= len; i += 16) {
+    const uint8x16_t v = vld1q_u8(s + i);
+    const uint8x16_t inrange = vandq_u8(vcgeq_u8(v, vlo), vcleq_u8(v, vhi));
+    vst1q_u8(t + i, veorq_u8(v, vandq_u8(inrange, bit)));
+  }
+#endif
+  for (; i < len; i++) {
+    t[i] = (lo == 'a' ? kk_ascii_toupper(s[i]) : kk_ascii_tolower(s[i]));
+  }
+}
+
+// Length of the longest prefix of ascii whitespace (as in `kk_ascii_iswhite`).
+static kk_ssize_t kk_ascii_white_run_left(const uint8_t* s, kk_ssize_t len) {
+  kk_ssize_t i = 0;
+#if defined(KK_QUTF8_SSE2)
+  for (; i + 16 <= len; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+    const __m128i white = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),  _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+    const uint32_t nonwhite = (~(uint32_t)_mm_movemask_epi8(white)) & 0xFFFF;
+    if (nonwhite != 0) return (i + kk_bits_ctz32(nonwhite));
+  }
+#elif defined(KK_QUTF8_NEON)
+  for (; i + 16 <= len; i += 16) {
+    const uint8x16_t v = vld1q_u8(s + i);
+    const uint8x16_t white = vorrq_u8(
+      vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')),  vceqq_u8(v, vdupq_n_u8('\t'))),
+      vorrq_u8(vceqq_u8(v, vdupq_n_u8('\n')), vceqq_u8(v, vdupq_n_u8('\r'))));
+    // narrow to a nibble mask: 4 bits per byte
+    const uint64_t nonwhite = ~vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(white), 4)), 0);
+    if (nonwhite != 0) return (i + kk_bits_ctz64(nonwhite)/4);
+  }
+#endif
+  for (; i < len && kk_ascii_iswhite(s[i]); i++) {}
+  return i;
+}
+
+// Length of the longest suffix of ascii whitespace.
+static kk_ssize_t kk_ascii_white_run_right(const uint8_t* s, kk_ssize_t len) {
+  kk_ssize_t i = 0;
+#if defined(KK_QUTF8_SSE2)
+  for (; i + 16 <= len; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(s + len - i - 16));
+    const __m128i white = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),  _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+    const uint32_t nonwhite = (~(uint32_t)_mm_movemask_epi8(white)) & 0xFFFF;
+    if (nonwhite != 0) return (i + 16 - 1 - (31 - kk_bits_clz32(nonwhite)));
+  }
+#elif defined(KK_QUTF8_NEON)
+  for (; i + 16 <= len; i += 16) {
+    const uint8x16_t v = vld1q_u8(s + len - i - 16);
+    const uint8x16_t white = vorrq_u8(
+      vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')),  vceqq_u8(v, vdupq_n_u8('\t'))),
+      vorrq_u8(vceqq_u8(v, vdupq_n_u8('\n')), vceqq_u8(v, vdupq_n_u8('\r'))));
+    const uint64_t nonwhite = ~vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(white), 4)), 0);
+    if (nonwhite != 0) return (i + 16 - 1 - (63 - kk_bits_clz64(nonwhite))/4);
+  }
+#endif
+  for (; i < len && kk_ascii_iswhite(s[len - 1 - i]); i++) {}
+  return i;
+}
+
 kk_string_t kk_string_to_upper(kk_string_t str, kk_context_t* ctx) {
   kk_ssize_t len;
   const uint8_t* s = kk_string_buf_borrow(str, &len);
+  if (len <= 0) return str;  // empty string singleton is a value, not a block
   kk_string_t tstr;
   if (kk_datatype_is_unique(str.bytes)) {
     tstr = str;  // update in-place
@@ -796,9 +1430,7 @@ kk_string_t kk_string_to_upper(kk_string_t str, kk_context_t* ctx) {
     kk_assert_internal(!kk_datatype_eq(str.bytes, tstr.bytes));
   }
   uint8_t* t = (uint8_t*)kk_string_buf_borrow(tstr, NULL);   // t & s may alias!
-  for (kk_ssize_t i = 0; i < len; i++) {
-    t[i] = kk_ascii_toupper(s[i]);
-  }
+  kk_ascii_convert_case(t, s, len, 'a');
   if (!kk_datatype_eq(str.bytes, tstr.bytes)) kk_string_drop(str, ctx);  // drop if not reused in-place
   return tstr;
 }
@@ -806,6 +1438,7 @@ kk_string_t kk_string_to_upper(kk_string_t str, kk_context_t* ctx) {
 kk_string_t  kk_string_to_lower(kk_string_t str, kk_context_t* ctx) {
   kk_ssize_t len;
   const uint8_t* s = kk_string_buf_borrow(str, &len);
+  if (len <= 0) return str;  // empty string singleton is a value, not a block
   kk_string_t tstr;
   if (kk_datatype_is_unique(str.bytes)) {
     tstr = str;  // update in-place
@@ -816,9 +1449,7 @@ kk_string_t  kk_string_to_lower(kk_string_t str, kk_context_t* ctx) {
     kk_assert_internal(!kk_datatype_eq(str.bytes, tstr.bytes));
   }
   uint8_t* t = (uint8_t*)kk_string_buf_borrow(tstr, NULL);   // t & s may alias!
-  for (kk_ssize_t i = 0; i < len; i++) {
-    t[i] = kk_ascii_tolower(s[i]);
-  }
+  kk_ascii_convert_case(t, s, len, 'A');
   if (!kk_datatype_eq(str.bytes, tstr.bytes)) kk_string_drop(str, ctx);  // drop if not reused in-place
   return tstr;
 }
@@ -826,10 +1457,10 @@ kk_string_t  kk_string_to_lower(kk_string_t str, kk_context_t* ctx) {
 kk_string_t  kk_string_trim_left(kk_string_t str, kk_context_t* ctx) {
   kk_ssize_t len;
   const uint8_t* s = kk_string_buf_borrow(str, &len);
-  const uint8_t* p = s;
-  for (; *p != 0 && kk_ascii_iswhite(*p); p++) {}
-  if (p == s) return str;           // no trim needed
-  const kk_ssize_t tlen = len - (p - s);      // todo: if s is unique and tlen close to slen, move inplace?
+  const kk_ssize_t n = kk_ascii_white_run_left(s, len);
+  if (n == 0) return str;           // no trim needed
+  const uint8_t* p = s + n;
+  const kk_ssize_t tlen = len - n;  // todo: if s is unique and tlen close to slen, move inplace?
   kk_string_t tstr = kk_string_alloc_dupn_valid_utf8(tlen, p, ctx);
   kk_string_drop(str, ctx);
   return tstr;
@@ -838,10 +1469,9 @@ kk_string_t  kk_string_trim_left(kk_string_t str, kk_context_t* ctx) {
 kk_string_t  kk_string_trim_right(kk_string_t str, kk_context_t* ctx) {
   kk_ssize_t len;
   const uint8_t* s = kk_string_buf_borrow(str, &len);
-  const uint8_t* p = s + len - 1;
-  for (; p >= s && kk_ascii_iswhite(*p); p--) {}
-  const kk_ssize_t tlen = (p - s) + 1;
-  if (len == tlen) return str;  // no trim needed
+  const kk_ssize_t n = kk_ascii_white_run_right(s, len);
+  if (n == 0) return str;  // no trim needed
+  const kk_ssize_t tlen = len - n;
   kk_string_t tstr = kk_string_alloc_dupn_valid_utf8(tlen, s, ctx);
   kk_string_drop(str, ctx);
   return tstr;
@@ -895,6 +1525,10 @@ static kk_string_t kk_double_show_special(double d, kk_context_t* ctx) {
 
 static kk_string_t kk_double_show_spec(double d, int32_t prec, char spec, kk_context_t* ctx) {
   if (!isfinite(d)) return kk_double_show_special(d, ctx);
+  if (spec == 'g' && prec <= -17) {
+    // "at most 17 digits": the shortest round-trip digits (see `double.c`)
+    return kk_double_show_shortest(d, ctx);
+  }
   char buf[64];
   char fmt[16];
   if (prec < 0)  prec = -prec;
@@ -971,3 +1605,90 @@ kk_string_t kk_show_any(kk_box_t b, kk_context_t* ctx) {
       }
     }
 }
+
+
+/*--------------------------------------------------------------------------------------------------
+  String builder
+  The appended bytes go into a list of chunks (with doubling capacity) so
+  appending is amortized O(1); the final string is materialized with a
+  single copy in `kk_string_builder_done`.
+--------------------------------------------------------------------------------------------------*/
+
+#define KK_STRING_BUILDER_CHUNK_MIN   (128)            // capacity of the first chunk
+#define KK_STRING_BUILDER_CHUNK_MAX   (8*1024*1024L)   // chunk capacities double up to this
+
+typedef struct kk_string_builder_chunk_s {
+  struct kk_string_builder_chunk_s* next;
+  kk_ssize_t count;       // used bytes
+  kk_ssize_t capacity;
+  uint8_t    buf[1];      // buf[capacity]
+} kk_string_builder_chunk_t;
+
+void kk_string_builder_init(kk_string_builder_t* sb) {
+  sb->head = NULL;
+  sb->tail = NULL;
+  sb->total = 0;
+}
+
+static kk_string_builder_chunk_t* kk_string_builder_grow(kk_string_builder_t* sb, kk_ssize_t needed, kk_context_t* ctx) {
+  kk_ssize_t capacity = (sb->tail == NULL ? KK_STRING_BUILDER_CHUNK_MIN : 2*sb->tail->capacity);
+  if (capacity > KK_STRING_BUILDER_CHUNK_MAX) { capacity = KK_STRING_BUILDER_CHUNK_MAX; }
+  if (capacity < needed) { capacity = needed; }  // a huge append gets a chunk of its own
+  kk_string_builder_chunk_t* c = (kk_string_builder_chunk_t*)kk_malloc(kk_ssizeof(kk_string_builder_chunk_t) - 1 /* buf[1] */ + capacity, ctx);
+  c->next = NULL;
+  c->count = 0;
+  c->capacity = capacity;
+  if (sb->tail != NULL) { sb->tail->next = c; }
+                   else { sb->head = c; }
+  sb->tail = c;
+  return c;
+}
+
+void kk_string_builder_append_buf(kk_string_builder_t* sb, const uint8_t* p, kk_ssize_t len, kk_context_t* ctx) {
+  if (len <= 0) return;
+  kk_string_builder_chunk_t* c = sb->tail;
+  if (c != NULL && c->count < c->capacity) {
+    // fill the remaining room in the tail chunk first
+    kk_ssize_t room = c->capacity - c->count;
+    if (room > len) { room = len; }
+    kk_memcpy(&c->buf[c->count], p, room);
+    c->count += room;
+    sb->total += room;
+    p += room;
+    len -= room;
+  }
+  if (len > 0) {
+    c = kk_string_builder_grow(sb, len, ctx);
+    kk_memcpy(&c->buf[0], p, len);
+    c->count = len;
+    sb->total += len;
+  }
+}
+
+void kk_string_builder_clear(kk_string_builder_t* sb, kk_context_t* ctx) {
+  kk_string_builder_chunk_t* c = sb->head;
+  while (c != NULL) {
+    kk_string_builder_chunk_t* next = c->next;
+    kk_free(c, ctx);
+    c = next;
+  }
+  kk_string_builder_init(sb);
+}
+
+kk_string_t kk_string_builder_done(kk_string_builder_t* sb, kk_context_t* ctx) {
+  uint8_t* buf;
+  kk_bytes_t b = kk_bytes_alloc_buf(sb->total, &buf, ctx);
+  kk_ssize_t ofs = 0;
+  kk_string_builder_chunk_t* c = sb->head;
+  while (c != NULL) {
+    kk_memcpy(buf + ofs, &c->buf[0], c->count);
+    ofs += c->count;
+    kk_string_builder_chunk_t* next = c->next;
+    kk_free(c, ctx);
+    c = next;
+  }
+  kk_assert_internal(ofs == sb->total);
+  kk_assert_internal(kk_utf8_is_validn(sb->total, buf));  // all append entries guarantee valid utf-8
+  kk_string_builder_init(sb);
+  return kk_unsafe_bytes_as_string(b);
+}
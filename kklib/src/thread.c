@@ -138,19 +138,85 @@ static void pthread_join_void(pthread_t thread) {
 #endif
 
 
+/*---------------------------------------------------------------------------
+  Futex-style wait/notify on a 32-bit word.
+  On Linux this maps directly onto the futex syscall; elsewhere we emulate it
+  with a small hashed table of mutex/condition pairs. Waiting on the word
+  itself lets a producer complete with one atomic store and at most one wake
+  call (and none at all when nobody parked).
+---------------------------------------------------------------------------*/
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <limits.h>
+
+static void kk_futex_wait(_Atomic(uint32_t)* addr, uint32_t expected) {
+  syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+}
+
+static void kk_futex_wake_all(_Atomic(uint32_t)* addr) {
+  syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+#else
+#define KK_FUTEX_SLOTS  (64)   // must be a power of 2
+
+typedef struct kk_futex_slot_s {
+  pthread_mutex_t lock;
+  pthread_cond_t  wakeup;
+} kk_futex_slot_t;
+
+static kk_futex_slot_t futex_slots[KK_FUTEX_SLOTS];
+static pthread_once_t  futex_once = PTHREAD_ONCE_INIT;
+
+static void kk_futex_slots_init(void) {
+  for (kk_ssize_t i = 0; i < KK_FUTEX_SLOTS; i++) {
+    pthread_mutex_init(&futex_slots[i].lock, NULL);
+    pthread_cond_init(&futex_slots[i].wakeup, NULL);
+  }
+}
+
+static kk_futex_slot_t* kk_futex_slot(_Atomic(uint32_t)* addr) {
+  pthread_once(&futex_once, &kk_futex_slots_init);
+  return &futex_slots[(((uintptr_t)addr) >> 4) & (KK_FUTEX_SLOTS-1)];
+}
+
+static void kk_futex_wait(_Atomic(uint32_t)* addr, uint32_t expected) {
+  kk_futex_slot_t* slot = kk_futex_slot(addr);
+  pthread_mutex_lock(&slot->lock);
+  if (kk_atomic_load_acquire(addr) == expected) {
+    pthread_cond_wait(&slot->wakeup, &slot->lock);
+  }
+  pthread_mutex_unlock(&slot->lock);
+}
+
+static void kk_futex_wake_all(_Atomic(uint32_t)* addr) {
+  kk_futex_slot_t* slot = kk_futex_slot(addr);
+  pthread_mutex_lock(&slot->lock);  // wait until late waiters are parked (the word is already updated)
+  pthread_mutex_unlock(&slot->lock);
+  pthread_cond_broadcast(&slot->wakeup);
+}
+#endif
+
+
 /*---------------------------------------------------------------------------
   Promise
 ---------------------------------------------------------------------------*/
 
+// promise states
+#define KK_PROMISE_PENDING    (0)   // not yet resolved
+#define KK_PROMISE_WAITING    (1)   // not yet resolved with parked waiters
+#define KK_PROMISE_AVAILABLE  (2)   // the result is set
+
 typedef struct promise_s {
-  kk_box_t        result;
-  pthread_mutex_t lock;
-  pthread_cond_t  available;
+  kk_box_t          result;
+  _Atomic(uint32_t) state;    // only ever moves towards KK_PROMISE_AVAILABLE
 } promise_t;
 
 
-static kk_promise_t kk_promise_alloc( kk_context_t* ctx );
-static void         kk_promise_set( kk_promise_t pr, kk_box_t r, kk_context_t* ctx );
+// `kk_promise_alloc` and `kk_promise_set` are exported in `thread.h`
 // static bool         kk_promise_available( kk_promise_t pr, kk_context_t* ctx );
 
 
@@ -163,11 +229,12 @@ typedef struct kk_task_s {
   struct kk_task_s* next;
   kk_function_t     fun;
   kk_promise_t      promise;
+  kk_prandom_t      prandom;   // deterministic child stream split off at schedule time (stream 0 when not set)
 } kk_task_t;
 
 static void kk_task_free( kk_task_t* task, kk_context_t* ctx ) {
   kk_function_drop(task->fun,ctx);
-  kk_box_drop(task->promise,ctx);
+  if (!kk_box_is_null(task->promise)) { kk_box_drop(task->promise,ctx); }
   kk_free(task,ctx);
 }
 
@@ -175,7 +242,7 @@ static kk_task_t* kk_task_alloc( kk_function_t fun, kk_promise_t p, kk_context_t
   kk_task_t* task = (kk_task_t*)kk_zalloc(kk_ssizeof(kk_task_t), ctx);
   if (task == NULL) {
     kk_function_drop(fun,ctx);
-    kk_box_drop(p,ctx);
+    if (!kk_box_is_null(p)) { kk_box_drop(p,ctx); }
     return NULL;
   }
   task->promise = p;
@@ -186,38 +253,209 @@ static kk_task_t* kk_task_alloc( kk_function_t fun, kk_promise_t p, kk_context_t
 
 static void kk_task_exec( kk_task_t* task, kk_context_t* ctx ) {
   if (task->fun != NULL) {
-    kk_function_dup(task->fun);      
+    if (task->prandom.stream != 0) {  // install the task's deterministic stream (internal tasks have none)
+      ctx->prandom = task->prandom;
+    }
+    kk_function_dup(task->fun);
     kk_box_t res = kk_function_call(kk_box_t,(kk_function_t,kk_context_t*),task->fun,(task->fun,ctx));
-    kk_box_dup(task->promise);
-    kk_promise_set( task->promise, res, ctx );
+    if (!kk_box_is_null(task->promise)) {   // internal tasks (e.g. parallel marking) have no promise
+      kk_box_dup(task->promise);
+      kk_promise_set( task->promise, res, ctx );
+    }
+    else {
+      kk_box_drop(res,ctx);
+    }
+  }
+  kk_task_free(task,ctx);
+}
+
+
+/*---------------------------------------------------------------------------
+  fork frames (see the fork-join section below) travel through the same
+  deques as heap tasks but live on the forking worker's stack; they are
+  distinguished by a tag in the low pointer bit.
+---------------------------------------------------------------------------*/
+
+static bool kk_task_is_fork( const kk_task_t* task ) {
+  return (((uintptr_t)task & 1) != 0);
+}
+
+static kk_task_t* kk_fork_as_task( kk_fork_t* fork ) {
+  return (kk_task_t*)((uintptr_t)fork | 1);
+}
+
+static kk_fork_t* kk_task_as_fork( kk_task_t* task ) {
+  return (kk_fork_t*)((uintptr_t)task & ~(uintptr_t)1);
+}
+
+static void kk_fork_run( kk_fork_t* fork, kk_context_t* ctx );
+
+// run a dequeued entry: either a heap task or a stolen fork frame
+static void kk_task_run( kk_task_t* task, kk_context_t* ctx ) {
+  if (kk_task_is_fork(task)) {
+    kk_fork_run(kk_task_as_fork(task), ctx);
+  }
+  else {
+    kk_task_exec(task, ctx);
   }
-  kk_task_free(task,ctx);  
 }
 
 
 /*---------------------------------------------------------------------------
-  task group (thread pool with task queue)
+  work-stealing deque (Chase-Lev)
+  Each worker owns a deque; the owner pushes and pops tasks at the bottom
+  without locking while other workers steal from the top with a CAS.
+  (D. Chase and Y. Lev, "Dynamic circular work-stealing deque", SPAA'05,
+   with the C11 orderings of Lê et al., PPoPP'13)
+---------------------------------------------------------------------------*/
+
+typedef struct kk_task_array_s {
+  struct kk_task_array_s* next;      // older (smaller) arrays; freed with the deque
+  kk_ssize_t              capacity;  // always a power of two
+  _Atomic(kk_task_t*)     tasks[1];  // allocated to `capacity` entries
+} kk_task_array_t;
+
+typedef struct kk_task_deque_s {
+  _Atomic(kk_ssize_t)       top;     // stealers advance the top
+  _Atomic(kk_ssize_t)       bottom;  // the owner pushes and pops at the bottom
+  _Atomic(kk_task_array_t*) array;
+} kk_task_deque_t;
+
+#define KK_TASK_DEQUE_INITIAL_CAPACITY  (64)
+
+static kk_task_array_t* kk_task_array_alloc( kk_ssize_t capacity, kk_context_t* ctx ) {
+  kk_task_array_t* a = (kk_task_array_t*)kk_zalloc( kk_ssizeof(kk_task_array_t) + (capacity - 1)*kk_ssizeof(_Atomic(kk_task_t*)), ctx );
+  if (a == NULL) return NULL;
+  a->next = NULL;
+  a->capacity = capacity;
+  return a;
+}
+
+static kk_task_t* kk_task_array_at( kk_task_array_t* a, kk_ssize_t i ) {
+  return kk_atomic_load_relaxed( &a->tasks[i & (a->capacity - 1)] );
+}
+
+static void kk_task_array_put( kk_task_array_t* a, kk_ssize_t i, kk_task_t* task ) {
+  kk_atomic_store_relaxed( &a->tasks[i & (a->capacity - 1)], task );
+}
+
+static bool kk_task_deque_init( kk_task_deque_t* dq, kk_context_t* ctx ) {
+  kk_task_array_t* a = kk_task_array_alloc(KK_TASK_DEQUE_INITIAL_CAPACITY, ctx);
+  if (a == NULL) return false;
+  kk_atomic_store_relaxed(&dq->top, (kk_ssize_t)0);
+  kk_atomic_store_relaxed(&dq->bottom, (kk_ssize_t)0);
+  kk_atomic_store_relaxed(&dq->array, a);
+  return true;
+}
+
+static void kk_task_deque_done( kk_task_deque_t* dq, kk_context_t* ctx ) {
+  kk_task_array_t* a = kk_atomic_load_relaxed(&dq->array);
+  while (a != NULL) {
+    kk_task_array_t* next = a->next;
+    kk_free(a, ctx);
+    a = next;
+  }
+}
+
+// owner only: grow the circular array; the old array stays linked (and readable)
+// so concurrent stealers racing on the old array pointer stay valid.
+static kk_task_array_t* kk_task_deque_grow( kk_task_deque_t* dq, kk_task_array_t* a, kk_ssize_t top, kk_ssize_t bottom, kk_context_t* ctx ) {
+  kk_task_array_t* anew = kk_task_array_alloc(2*a->capacity, ctx);
+  if (anew == NULL) return NULL;
+  for (kk_ssize_t i = top; i < bottom; i++) {
+    kk_task_array_put(anew, i, kk_task_array_at(a, i));
+  }
+  anew->next = a;
+  kk_atomic_store_release(&dq->array, anew);
+  return anew;
+}
+
+// owner only
+static bool kk_task_deque_push( kk_task_deque_t* dq, kk_task_t* task, kk_context_t* ctx ) {
+  const kk_ssize_t b = kk_atomic_load_relaxed(&dq->bottom);
+  const kk_ssize_t t = kk_atomic_load_acquire(&dq->top);
+  kk_task_array_t* a = kk_atomic_load_relaxed(&dq->array);
+  if (b - t >= a->capacity) {
+    a = kk_task_deque_grow(dq, a, t, b, ctx);
+    if (a == NULL) return false;
+  }
+  kk_task_array_put(a, b, task);
+  kk_atomic_fence_release();
+  kk_atomic_store_relaxed(&dq->bottom, b + 1);
+  return true;
+}
+
+// owner only
+static kk_task_t* kk_task_deque_pop( kk_task_deque_t* dq ) {
+  const kk_ssize_t b = kk_atomic_load_relaxed(&dq->bottom) - 1;
+  kk_task_array_t* a = kk_atomic_load_relaxed(&dq->array);
+  kk_atomic_store_relaxed(&dq->bottom, b);
+  kk_atomic_fence_seq_cst();
+  kk_ssize_t t = kk_atomic_load_relaxed(&dq->top);
+  if (t > b) {  // empty
+    kk_atomic_store_relaxed(&dq->bottom, b + 1);
+    return NULL;
+  }
+  kk_task_t* task = kk_task_array_at(a, b);
+  if (t == b) {
+    // last element: race against the stealers for it
+    if (!kk_atomic_cas_strong_seq_cst(&dq->top, &t, t + 1)) {
+      task = NULL;  // lost to a stealer
+    }
+    kk_atomic_store_relaxed(&dq->bottom, b + 1);
+  }
+  return task;
+}
+
+// any thread
+static kk_task_t* kk_task_deque_steal( kk_task_deque_t* dq ) {
+  kk_ssize_t t = kk_atomic_load_acquire(&dq->top);
+  kk_atomic_fence_seq_cst();
+  const kk_ssize_t b = kk_atomic_load_acquire(&dq->bottom);
+  if (t >= b) return NULL;  // empty (or a pop is in progress)
+  kk_task_array_t* a = kk_atomic_load_acquire(&dq->array);
+  kk_task_t* task = kk_task_array_at(a, t);
+  if (!kk_atomic_cas_strong_seq_cst(&dq->top, &t, t + 1)) {
+    return NULL;  // lost the race; the caller retries (the task count stays up to date)
+  }
+  return task;
+}
+
+
+/*---------------------------------------------------------------------------
+  task group (thread pool with per-worker work-stealing deques)
+  Tasks scheduled from a worker go lock-free onto its own deque; external
+  submissions (e.g. from the main thread) go through the mutex-protected
+  submission queue. Idle workers first pop locally, then drain the
+  submission queue, and finally steal from their peers.
 ---------------------------------------------------------------------------*/
 
 typedef struct kk_task_group_s {
   bool            done;
-  kk_task_t*      tasks;
+  _Atomic(kk_task_t*) tasks;        // external submission queue (modified under `tasks_lock`; atomic for the lock-free peek)
   kk_task_t*      tasks_tail;
   pthread_cond_t  tasks_available;
   pthread_mutex_t tasks_lock;
+  _Atomic(kk_ssize_t) tasks_pending;    // total tasks in the deques and the submission queue
+  _Atomic(kk_ssize_t) workers_waiting;  // workers blocked on `tasks_available`
+  _Atomic(kk_ssize_t) workers_started;  // used to hand each worker its deque
+  kk_task_deque_t* deques;          // one work-stealing deque per worker
   pthread_t*      threads;
   kk_ssize_t      thread_count;
 } kk_task_group_t;
 
+// the worker's own deque; NULL on threads that are not task group workers
+static kk_decl_thread kk_task_deque_t* worker_deque;
+
 static bool kk_tasks_is_empty( kk_task_group_t* tg ) {
-  return (tg->tasks == NULL);
+  return (kk_atomic_load_relaxed(&tg->tasks) == NULL);
 }
 
 static kk_task_t* kk_tasks_dequeue( kk_task_group_t* tg ) {
-  kk_task_t* task = tg->tasks;
+  kk_task_t* task = kk_atomic_load_relaxed(&tg->tasks);
   if (task != NULL) {
-    tg->tasks = task->next;
-    if (tg->tasks == NULL) { 
+    kk_atomic_store_relaxed(&tg->tasks, task->next);
+    if (task->next == NULL) {
       kk_assert(tg->tasks_tail == task);
       tg->tasks_tail = NULL; 
     }
@@ -233,7 +471,7 @@ static void kk_tasks_enqueue_n( kk_task_group_t* tg, kk_task_t* thead, kk_task_t
     tg->tasks_tail->next = thead;
   }
   else {
-    tg->tasks = thead;
+    kk_atomic_store_relaxed(&tg->tasks, thead);
   }
   tg->tasks_tail = ttail;
 }
@@ -242,13 +480,59 @@ static void kk_tasks_enqueue( kk_task_group_t* tg, kk_task_t* task, kk_context_t
   kk_tasks_enqueue_n( tg, task, task, ctx );
 }
 
+// wake one idle worker if there may be any; the empty lock/unlock pairs with
+// a worker that is between checking `tasks_pending` and blocking on the condition.
+static void kk_task_group_wake( kk_task_group_t* tg ) {
+  if (kk_atomic(load)(&tg->workers_waiting) > 0) {
+    pthread_mutex_lock(&tg->tasks_lock);
+    pthread_mutex_unlock(&tg->tasks_lock);
+    pthread_cond_signal(&tg->tasks_available);
+  }
+}
+
+static void kk_task_group_push( kk_task_group_t* tg, kk_task_t* task, kk_context_t* ctx ) {
+  kk_stat_inc(ctx, task_enqueues);
+  kk_atomic(fetch_add)(&tg->tasks_pending, 1);  // seq_cst: orders against the waiting check
+  if (worker_deque != NULL && ctx->task_group == tg && kk_task_deque_push(worker_deque, task, ctx)) {
+    // pushed lock-free on our own deque; an idle worker can steal it
+  }
+  else {
+    pthread_mutex_lock(&tg->tasks_lock);
+    kk_tasks_enqueue(tg, task, ctx);
+    pthread_mutex_unlock(&tg->tasks_lock);
+  }
+  kk_task_group_wake(tg);
+}
+
+// take a task without blocking: first the local deque, then the shared
+// submission queue, and finally steal from the other workers.
+static kk_task_t* kk_task_group_take( kk_task_group_t* tg ) {
+  kk_task_t* task = NULL;
+  if (worker_deque != NULL) {
+    task = kk_task_deque_pop(worker_deque);
+  }
+  if (task == NULL && kk_atomic_load_relaxed(&tg->tasks) != NULL) {  // relaxed peek; verified under the lock
+    pthread_mutex_lock(&tg->tasks_lock);
+    if (!kk_tasks_is_empty(tg)) { task = kk_tasks_dequeue(tg); }
+    pthread_mutex_unlock(&tg->tasks_lock);
+  }
+  if (task == NULL) {
+    for (kk_ssize_t i = 0; i < tg->thread_count && task == NULL; i++) {
+      kk_task_deque_t* dq = &tg->deques[i];
+      if (dq != worker_deque) { task = kk_task_deque_steal(dq); }
+    }
+  }
+  if (task != NULL) {
+    kk_atomic(fetch_sub)(&tg->tasks_pending, 1);
+  }
+  return task;
+}
+
 static kk_promise_t kk_task_group_schedule( kk_task_group_t* tg, kk_function_t fun, kk_context_t* ctx ) {
   kk_promise_t p = kk_promise_alloc(ctx);
   kk_task_t* task = kk_task_alloc(fun, kk_box_dup(p), ctx);
-  pthread_mutex_lock(&tg->tasks_lock);
-  kk_tasks_enqueue(tg,task,ctx);
-  pthread_mutex_unlock(&tg->tasks_lock);
-  pthread_cond_signal(&tg->tasks_available);  
+  kk_prandom_split(&ctx->prandom, &task->prandom);  // reproducible per-task stream, independent of which worker runs it
+  kk_task_group_push(tg, task, ctx);
   return p;
 }
 
@@ -256,21 +540,28 @@ static void* kk_task_group_worker( void* vtg ) {
   kk_task_group_t* tg = (kk_task_group_t*)vtg;
   kk_context_t*    ctx = kk_get_context();
   ctx->task_group = tg;
+  const kk_ssize_t worker_id = kk_atomic(fetch_add)(&tg->workers_started, 1);
+  kk_assert(worker_id < tg->thread_count);
+  worker_deque = &tg->deques[worker_id];
   while(true) {
-     // deqeue task
-     kk_task_t* task = NULL;
-     pthread_mutex_lock(&tg->tasks_lock);
-     while (kk_tasks_is_empty(tg) && !tg->done) {
-       pthread_cond_wait(&tg->tasks_available, &tg->tasks_lock);
+     kk_task_t* task = kk_task_group_take(tg);
+     if (task == NULL) {
+       // nothing to pop or steal: block until new tasks arrive (or we are done)
+       pthread_mutex_lock(&tg->tasks_lock);
+       kk_atomic(fetch_add)(&tg->workers_waiting, 1);  // seq_cst: orders against the pending check
+       while (kk_atomic(load)(&tg->tasks_pending) == 0 && !tg->done) {
+         pthread_cond_wait(&tg->tasks_available, &tg->tasks_lock);
+       }
+       kk_atomic(fetch_sub)(&tg->workers_waiting, 1);
+       const bool done = tg->done;
+       pthread_mutex_unlock(&tg->tasks_lock);
+       if (done) break;
+       continue;
      }
-     task = kk_tasks_dequeue(tg);
-     pthread_mutex_unlock(&tg->tasks_lock);
-     if (task == NULL) {  // due to tg->done
-       break;
-     }
-     kk_task_exec(task,ctx);
+     kk_task_run(task,ctx);
      // todo: ensure context is cleared again?
   }
+  worker_deque = NULL;
   ctx->task_group = NULL;
   kk_free_context();
   return NULL;
@@ -283,8 +574,8 @@ void kk_task_group_free( kk_task_group_t* tg, kk_context_t* ctx ) {
   kk_task_t* task = NULL;
   tg->done = true;
   pthread_mutex_lock(&tg->tasks_lock);
-  task = tg->tasks;
-  tg->tasks = NULL;
+  task = kk_atomic_load_relaxed(&tg->tasks);
+  kk_atomic_store_relaxed(&tg->tasks, NULL);
   tg->tasks_tail = NULL;
   tg->done = true;
   pthread_mutex_unlock(&tg->tasks_lock);
@@ -301,6 +592,21 @@ void kk_task_group_free( kk_task_group_t* tg, kk_context_t* ctx ) {
       pthread_join_void(tg->threads[i]);
     }
   }
+  // free tasks left in the worker deques (the workers are joined now)
+  if (tg->deques != NULL) {
+    for (kk_ssize_t i = 0; i < tg->thread_count; i++) {
+      kk_task_deque_t* dq = &tg->deques[i];
+      kk_task_array_t* a = kk_atomic_load_relaxed(&dq->array);
+      if (a != NULL) {
+        for (kk_ssize_t j = kk_atomic_load_relaxed(&dq->top); j < kk_atomic_load_relaxed(&dq->bottom); j++) {
+          kk_task_t* t = kk_task_array_at(a, j);
+          if (!kk_task_is_fork(t)) { kk_task_free(t, ctx); }  // fork frames live on their joiner's stack
+        }
+      }
+      kk_task_deque_done(dq, ctx);
+    }
+    kk_free(tg->deques, ctx);
+  }
   pthread_cond_destroy(&tg->tasks_available);
   pthread_mutex_destroy(&tg->tasks_lock);
   kk_free(tg->threads,ctx);
@@ -328,8 +634,13 @@ static kk_task_group_t* kk_task_group_alloc( kk_ssize_t thread_cnt, kk_context_t
   tg->threads = (pthread_t*)kk_zalloc( (thread_cnt+1) * sizeof(pthread_t), ctx );
   if (tg->threads == NULL) goto err;
   tg->thread_count = thread_cnt;
-  tg->tasks = NULL;
+  kk_atomic_store_relaxed(&tg->tasks, NULL);
   tg->tasks_tail = NULL;
+  tg->deques = (kk_task_deque_t*)kk_zalloc( thread_cnt * kk_ssizeof(kk_task_deque_t), ctx );
+  if (tg->deques == NULL) goto err;
+  for (kk_ssize_t i = 0; i < thread_cnt; i++) {
+    if (!kk_task_deque_init(&tg->deques[i], ctx)) goto err;
+  }
   if (pthread_cond_init(&tg->tasks_available, NULL) != 0) goto err;
   if (pthread_mutex_init(&tg->tasks_lock, NULL) != 0) goto err;
   for (kk_ssize_t i = 0; i < tg->thread_count; i++) {
@@ -345,12 +656,122 @@ err_threads:
   
 err:
   if (tg != NULL) {
+    if (tg->deques != NULL) {
+      for (kk_ssize_t i = 0; i < thread_cnt; i++) { kk_task_deque_done(&tg->deques[i],ctx); }
+      kk_free(tg->deques,ctx);
+    }
     if (tg->threads != NULL) { kk_free(tg->threads,ctx); }
-    kk_free(tg,ctx); 
+    kk_free(tg,ctx);
   }
   return NULL;
 }
 
+/*---------------------------------------------------------------------------
+  parallel shared marking
+  Marking a large structure as thread shared before it can cross threads can
+  take long on one core; we fan subtree marking out over the task group
+  workers instead. `kk_block_mark_shared_collect` (see `refcount.c`) marks
+  the top levels while collecting subtree roots which are then marked by
+  regular tasks -- marking is CAS based so the tasks may safely race on
+  shared substructure. A countdown with a condition signals completion;
+  the scheduling thread marks one subtree itself and runs other tasks
+  while it waits.
+---------------------------------------------------------------------------*/
+
+#define KK_MARK_COLLECT_DEPTH  (10)   // descend at most this deep when collecting subtree roots
+
+typedef struct kk_mark_sync_s {
+  _Atomic(kk_ssize_t) pending;        // outstanding mark tasks
+  pthread_mutex_t     lock;
+  pthread_cond_t      done;
+} kk_mark_sync_t;
+
+struct kk_mark_fun_s {
+  struct kk_function_s _base;
+  kk_box_t sync;   // kk_mark_sync_t* (borrowed; lives on the scheduling thread's stack)
+  kk_box_t root;   // kk_block_t* subtree root to mark
+};
+
+static kk_box_t kk_mark_fun( kk_function_t fself, kk_context_t* ctx ) {
+  struct kk_mark_fun_s* self = kk_function_as(struct kk_mark_fun_s*, fself);
+  kk_mark_sync_t* sync = (kk_mark_sync_t*)kk_cptr_unbox(self->sync);
+  kk_block_t*     root = (kk_block_t*)kk_cptr_unbox(self->root);
+  kk_function_drop(fself,ctx);
+  kk_block_mark_shared(root, ctx);
+  pthread_mutex_lock(&sync->lock);
+  if (kk_atomic(fetch_sub)(&sync->pending, 1) == 1) {  // last one?
+    pthread_cond_signal(&sync->done);
+  }
+  pthread_mutex_unlock(&sync->lock);
+  return kk_unit_box(kk_Unit);
+}
+
+static bool kk_task_group_push_mark( kk_task_group_t* tg, kk_mark_sync_t* sync, kk_block_t* root, kk_context_t* ctx ) {
+  struct kk_mark_fun_s* f = kk_function_alloc_as(struct kk_mark_fun_s, 3, ctx);
+  if (f == NULL) return false;
+  f->_base.fun = kk_cfun_ptr_box(&kk_mark_fun, ctx);
+  f->sync = kk_cptr_box(sync, ctx);
+  f->root = kk_cptr_box(root, ctx);
+  kk_function_t fun = &f->_base;
+  kk_block_mark_shared(&fun->_block, ctx);  // the (small) closure itself crosses threads
+  kk_task_t* task = kk_task_alloc(fun, kk_box_null, ctx);
+  if (task == NULL) return false;
+  kk_task_group_push(tg, task, ctx);
+  return true;
+}
+
+static void kk_task_group_mark_shared( kk_task_group_t* tg, kk_block_t* b, kk_context_t* ctx ) {
+  const kk_ssize_t max = (tg != NULL && !tg->done ? 2*tg->thread_count : 0);
+  if (max <= 1) {
+    kk_block_mark_shared(b, ctx);
+    return;
+  }
+  kk_block_t** roots = (kk_block_t**)kk_malloc(max * kk_ssizeof(kk_block_t*), ctx);
+  if (roots == NULL) {
+    kk_block_mark_shared(b, ctx);
+    return;
+  }
+  kk_ssize_t n = kk_block_mark_shared_collect(b, KK_MARK_COLLECT_DEPTH, roots, max, ctx);
+  kk_mark_sync_t sync;
+  bool fanout = false;
+  if (n > 1 && pthread_mutex_init(&sync.lock, NULL) == 0) {
+    if (pthread_cond_init(&sync.done, NULL) == 0) {
+      kk_atomic(store)(&sync.pending, (kk_ssize_t)0);
+      fanout = true;
+      // mark all but one root through worker tasks
+      while (n > 1 && kk_task_group_push_mark(tg, &sync, roots[n-1], ctx)) {
+        kk_atomic(fetch_add)(&sync.pending, 1);
+        n--;
+      }
+    }
+    else {
+      pthread_mutex_destroy(&sync.lock);
+    }
+  }
+  // mark the remaining roots (all of them if we could not fan out) ourselves
+  while (n > 0) {
+    kk_block_mark_shared(roots[--n], ctx);
+  }
+  kk_free(roots, ctx);
+  // and wait until the workers are done, participating in the group meanwhile
+  if (fanout) {
+    pthread_mutex_lock(&sync.lock);
+    while (kk_atomic(load)(&sync.pending) > 0) {
+      pthread_mutex_unlock(&sync.lock);
+      kk_task_t* task = (tg->done ? NULL : kk_task_group_take(tg));
+      if (task != NULL) { kk_task_run(task, ctx); }
+      pthread_mutex_lock(&sync.lock);
+      if (task == NULL && kk_atomic(load)(&sync.pending) > 0) {
+        pthread_cond_wait(&sync.done, &sync.lock);
+      }
+    }
+    pthread_mutex_unlock(&sync.lock);
+    pthread_cond_destroy(&sync.done);
+    pthread_mutex_destroy(&sync.lock);
+  }
+}
+
+
 static pthread_once_t task_group_once = PTHREAD_ONCE_INIT;
 static kk_task_group_t* task_group = NULL;
 
@@ -361,13 +782,31 @@ static void kk_task_group_init(void) {
 kk_promise_t kk_task_schedule( kk_function_t fun, kk_context_t* ctx ) {
   pthread_once( &task_group_once, &kk_task_group_init );
   kk_assert(task_group != NULL);
-  kk_block_mark_shared( &fun->_block, ctx );  // mark everything reachable from the task as shared
-  if (ctx->task_group == NULL) { 
+  kk_task_group_mark_shared( task_group, &fun->_block, ctx );  // mark everything reachable from the task as shared
+  if (ctx->task_group == NULL) {
     ctx->task_group = task_group; // let main thread participate instead of blocking on a promise.get
   }
   return kk_task_group_schedule( task_group, fun, ctx );
 }
 
+// A separate small task group for blocking (file) i/o, so a stalled read or
+// write never occupies a cpu-bound worker (see the async operations in `os.c`).
+#define KK_IO_TASK_THREADS  (4)
+
+static pthread_once_t io_task_group_once = PTHREAD_ONCE_INIT;
+static kk_task_group_t* io_task_group = NULL;
+
+static void kk_io_task_group_init(void) {
+  io_task_group = kk_task_group_alloc(KK_IO_TASK_THREADS, kk_get_context());
+}
+
+kk_promise_t kk_io_task_schedule( kk_function_t fun, kk_context_t* ctx ) {
+  pthread_once( &io_task_group_once, &kk_io_task_group_init );
+  kk_assert(io_task_group != NULL);
+  kk_task_group_mark_shared( io_task_group, &fun->_block, ctx );
+  return kk_task_group_schedule( io_task_group, fun, ctx );  // the caller does not participate in this group
+}
+
 
 
 /*---------------------------------------------------------------------------
@@ -377,115 +816,550 @@ kk_promise_t kk_task_schedule( kk_function_t fun, kk_context_t* ctx ) {
 static void kk_promise_free( void* vp, kk_block_t* b, kk_context_t* ctx ) {
   kk_unused(b);
   promise_t* p = (promise_t*)(vp);
-  pthread_cond_destroy(&p->available);
-  pthread_mutex_destroy(&p->lock);  
   kk_box_drop(p->result,ctx);
   kk_free(p,ctx);
 }
 
-static kk_promise_t kk_promise_alloc(kk_context_t* ctx) {
-  kk_promise_t pr;
+kk_promise_t kk_promise_alloc(kk_context_t* ctx) {
   promise_t* p = (promise_t*)kk_zalloc(kk_ssizeof(promise_t),ctx);
-  if (p == NULL) goto err;
+  if (p == NULL) return kk_box_any(ctx);
   p->result = kk_box_any(ctx);
-  if (pthread_mutex_init(&p->lock, NULL) != 0) goto err;
-  if (pthread_cond_init(&p->available, NULL) != 0) goto err;
-  pr = kk_cptr_raw_box( &kk_promise_free, p, ctx );
+  kk_atomic_store_relaxed(&p->state, KK_PROMISE_PENDING);
+  kk_promise_t pr = kk_cptr_raw_box( &kk_promise_free, p, ctx );
   kk_box_mark_shared(pr,ctx);
   return pr;
-err:
-  kk_free(p,ctx);
-  return kk_box_any(ctx);
 }
 
 
-static void kk_promise_set( kk_promise_t pr, kk_box_t r, kk_context_t* ctx ) {
+void kk_promise_set( kk_promise_t pr, kk_box_t r, kk_context_t* ctx ) {
   promise_t* p = (promise_t*)kk_cptr_raw_unbox(pr);
   kk_box_mark_shared(r,ctx);
-  pthread_mutex_lock(&p->lock);
-  kk_box_drop(p->result,ctx);
+  kk_box_drop(p->result,ctx);  // the boxed-any placeholder; waiters only read the result after seeing the available state
   p->result = r;
-  pthread_mutex_unlock(&p->lock);
-  pthread_cond_signal(&p->available);
+  uint32_t state = kk_atomic_load_relaxed(&p->state);
+  while (!kk_atomic_cas_weak_acq_rel(&p->state, &state, KK_PROMISE_AVAILABLE)) { }  // release the result
+  if (state == KK_PROMISE_WAITING) {
+    kk_futex_wake_all(&p->state);
+  }
   kk_box_drop(pr,ctx);
 }
 
 /*
 static bool kk_promise_available( kk_promise_t pr, kk_context_t* ctx ) {
   promise_t* p = (promise_t*)kk_cptr_raw_unbox(pr);
-  pthread_mutex_lock(&p->lock);
-  bool available = !kk_box_is_any(p->result);
-  pthread_mutex_unlock(&p->lock);
+  bool available = (kk_atomic_load_acquire(&p->state) == KK_PROMISE_AVAILABLE);
   kk_box_drop(pr,ctx);
   return available;
 }
 */
 
-kk_box_t kk_promise_get( kk_promise_t pr, kk_context_t* ctx ) {  
+kk_box_t kk_promise_get( kk_promise_t pr, kk_context_t* ctx ) {
   promise_t* p = (promise_t*)kk_cptr_raw_unbox(pr);
-  pthread_mutex_lock(&p->lock);
-  while (kk_box_is_any(p->result)) {
+  while (kk_atomic_load_acquire(&p->state) != KK_PROMISE_AVAILABLE) {
     // if part of a task group, run other tasks while waiting
     if (ctx->task_group != NULL) {
-      pthread_mutex_unlock(&p->lock);
-      // try to get a task
+      // try to get a task (pop locally, drain the submission queue, or steal)
       kk_task_group_t* tg = ctx->task_group;
-      kk_task_t* task = NULL;
-      pthread_mutex_lock(&tg->tasks_lock);
-      if (!kk_tasks_is_empty(tg) && !tg->done) {
-        task = kk_tasks_dequeue(tg);
+      kk_task_t* task = (tg->done ? NULL : kk_task_group_take(tg));
+      if (task != NULL) {
+        kk_task_run(task, ctx);
+        continue;
       }
-      pthread_mutex_unlock(&tg->tasks_lock);
-      // run task
-      if (task != NULL) { 
-        kk_task_exec(task, ctx);
-        pthread_mutex_lock(&p->lock);        
+    }
+    // no task to run: announce ourselves as a waiter and park on the state word
+    uint32_t state = KK_PROMISE_PENDING;
+    if (kk_atomic_cas_strong_acq_rel(&p->state, &state, KK_PROMISE_WAITING) || state == KK_PROMISE_WAITING) {
+      kk_futex_wait(&p->state, KK_PROMISE_WAITING);
+    }
+  }
+  const kk_box_t result = kk_box_dup( p->result );
+  kk_box_drop(pr,ctx);
+  return result;
+}
+
+
+/*---------------------------------------------------------------------------
+  fork-join
+  `kk_task_group_schedule` pays a heap task and a promise for every work
+  item which drowns fine-grained parallel recursion in scheduling overhead.
+  A fork instead publishes a stack frame on the forking worker's own deque;
+  it only materializes into real parallel work when an idle worker steals
+  it. The deque already hands out every entry exactly once (pop and steal
+  race through a CAS on the top index), so no claim protocol is needed: the
+  join pops its own deque and either gets the frame back -- the common case,
+  run inline with no promise, futex, or heap traffic -- or finds it gone and
+  waits on the frame's state word (promise-style) after helping with other
+  tasks. The frame cannot go out of scope early since the join only returns
+  once the frame was consumed and, if stolen, completed.
+---------------------------------------------------------------------------*/
+
+// stealer side: run the frame and release the result to the waiting joiner
+static void kk_fork_run( kk_fork_t* fork, kk_context_t* ctx ) {
+  kk_function_t fun = fork->fun;
+  kk_box_t res = kk_function_call(kk_box_t,(kk_function_t,kk_context_t*),fun,(fun,ctx));
+  kk_box_mark_shared(res, ctx);   // the result crosses back to the joiner's thread
+  fork->result = res;
+  uint32_t state = kk_atomic_load_relaxed(&fork->state);
+  while (!kk_atomic_cas_weak_acq_rel(&fork->state, &state, KK_PROMISE_AVAILABLE)) { }  // release the result
+  if (state == KK_PROMISE_WAITING) {
+    kk_futex_wake_all(&fork->state);
+  }
+}
+
+void kk_task_fork( kk_fork_t* fork, kk_function_t fun, kk_context_t* ctx ) {
+  fork->fun = fun;
+  fork->result = kk_box_null;
+  fork->promise = kk_box_null;
+  fork->queued = false;
+  kk_atomic_store_relaxed(&fork->state, KK_PROMISE_PENDING);
+  kk_task_group_t* tg = ctx->task_group;
+  if (worker_deque != NULL && tg != NULL && !tg->done) {
+    kk_task_group_mark_shared(tg, &fun->_block, ctx);  // a stealer may run it on another thread
+    kk_atomic(fetch_add)(&tg->tasks_pending, 1);
+    if (kk_task_deque_push(worker_deque, kk_fork_as_task(fork), ctx)) {
+      fork->queued = true;
+      kk_task_group_wake(tg);
+    }
+    else {
+      kk_atomic(fetch_sub)(&tg->tasks_pending, 1);  // no deque space: run at the join instead
+    }
+  }
+  else {
+    // not on a pool worker (nor the participating main thread): fall back to a regular task
+    fork->fun = NULL;
+    fork->promise = kk_task_schedule(fun, ctx);
+  }
+}
+
+kk_box_t kk_task_join( kk_fork_t* fork, kk_context_t* ctx ) {
+  if (!kk_box_is_null(fork->promise)) {       // scheduled eagerly outside the pool
+    return kk_promise_get(fork->promise, ctx);
+  }
+  kk_task_group_t* tg = ctx->task_group;
+  if (fork->queued) {
+    // pop our own deque; everything above the frame was forked (or pushed) after it
+    kk_task_t* task;
+    while ((task = kk_task_deque_pop(worker_deque)) != NULL) {
+      kk_atomic(fetch_sub)(&tg->tasks_pending, 1);
+      if (task == kk_fork_as_task(fork)) {
+        fork->queued = false;                 // got it back: run inline below
+        break;
       }
-      else {        
-        pthread_mutex_lock(&p->lock);
-        if (kk_box_is_any(p->result)) {
-          pthread_cond_wait( &p->available, &p->lock);
-        }
-        /*
-        // no task, block for a while
-        struct timespec tm;
-        clock_gettime(CLOCK_REALTIME, &tm);
-        tm.tv_nsec     +=  100000000;  // 0.1s
-        if (tm.tv_nsec >= 1000000000) {
-          tm.tv_nsec   -= 1000000000;
-          tm.tv_sec += 1;
-        }
-        pthread_mutex_lock(&p->lock);
-        if (kk_box_is_any(p->result)) {
-          if (pthread_cond_timedwait( &p->available, &p->lock, &tm) == ETIMEDOUT) {
-            pthread_mutex_lock(&p->lock); 
-          }
+      kk_task_run(task, ctx);                 // younger work; run it in (reverse) forked order
+    }
+  }
+  if (!fork->queued) {
+    const kk_function_t fun = fork->fun;
+    if (fun != NULL) {
+      return kk_function_call(kk_box_t,(kk_function_t,kk_context_t*),fun,(fun,ctx));
+    }
+  }
+  else {
+    // the frame was stolen: help run other tasks, then park on the state word
+    while (kk_atomic_load_acquire(&fork->state) != KK_PROMISE_AVAILABLE) {
+      kk_task_t* task = (tg->done ? NULL : kk_task_group_take(tg));
+      if (task != NULL) {
+        kk_task_run(task, ctx);
+        continue;
+      }
+      uint32_t state = KK_PROMISE_PENDING;
+      if (kk_atomic_cas_strong_acq_rel(&fork->state, &state, KK_PROMISE_WAITING) || state == KK_PROMISE_WAITING) {
+        kk_futex_wait(&fork->state, KK_PROMISE_WAITING);
+      }
+    }
+  }
+  return fork->result;  // ownership moves to the joiner
+}
+
+// fork `right`, run `left` in place, and combine: the primitive behind
+// `fork-join` in `std/os/task` for divide-and-conquer recursion.
+kk_box_t kk_task_fork_join2( kk_function_t left, kk_function_t right, kk_function_t combine, kk_context_t* ctx ) {
+  kk_fork_t fork;
+  kk_task_fork(&fork, right, ctx);
+  kk_box_t rl = kk_function_call(kk_box_t,(kk_function_t,kk_context_t*),left,(left,ctx));
+  kk_box_t rr = kk_task_join(&fork, ctx);
+  return kk_function_call(kk_box_t,(kk_function_t,kk_box_t,kk_box_t,kk_context_t*),combine,(combine,rl,rr,ctx));
+}
+
+
+/*---------------------------------------------------------------------------
+  Parallel vector map / fold
+  The index range is split into a few chunks per worker with boundaries
+  rounded to whole cache lines of boxed elements, so no two workers store
+  into the same line of the result vector. Each chunk beyond the first is
+  a fork frame on the calling thread (see above); the caller runs the
+  first chunk itself and joins the rest in index order, so with no task
+  group -- or a range of less than a cache line per chunk -- everything
+  runs sequentially with no marking or scheduling at all. The source
+  vector and the element function are marked thread-shared up front, and
+  mapped results are marked before they are stored since they cross back
+  to the joining thread.
+---------------------------------------------------------------------------*/
+
+#define KK_PAR_LINE_ELEMS        (64/kk_ssizeof(kk_box_t))   // result slots per cache line
+#define KK_PAR_CHUNKS_PER_THREAD (4)                         // a little slack for load balance
+
+struct kk_par_chunk_fun_s {
+  struct kk_function_s _base;
+  kk_box_t fun;        // the element function (thread-shared)
+  kk_box_t src;        // kk_box_t* into the source vector (kept alive by the caller)
+  kk_box_t dst;        // kk_box_t* into the result vector, or null when folding
+  kk_box_t init;       // fold: the unit accumulator (thread-shared), else null
+  kk_box_t lo;
+  kk_box_t hi;
+};
+
+static kk_box_t kk_par_chunk_fun( kk_function_t fself, kk_context_t* ctx ) {
+  struct kk_par_chunk_fun_s* self = kk_function_as(struct kk_par_chunk_fun_s*, fself);
+  kk_function_t fun = kk_function_unbox(kk_box_dup(self->fun));
+  const kk_box_t* src = (const kk_box_t*)kk_cptr_unbox(self->src);
+  kk_box_t* dst = (kk_box_is_null(self->dst) ? NULL : (kk_box_t*)kk_cptr_unbox(self->dst));
+  kk_box_t acc = kk_box_dup(self->init);
+  const kk_ssize_t lo = kk_ssize_unbox(self->lo, ctx);
+  const kk_ssize_t hi = kk_ssize_unbox(self->hi, ctx);
+  kk_function_drop(fself, ctx);
+  if (dst != NULL) {
+    // map: write results in place (our lines of `dst` are ours alone)
+    kk_box_drop(acc, ctx);  // always null for a map
+    for (kk_ssize_t i = lo; i < hi; i++) {
+      kk_function_t f = kk_function_dup(fun);
+      kk_box_t res = kk_function_call(kk_box_t,(kk_function_t,kk_box_t,kk_context_t*),f,(f,kk_box_dup(src[i]),ctx));
+      kk_box_mark_shared(res, ctx);   // read (and dropped) on the joining thread
+      dst[i] = res;
+    }
+    kk_function_drop(fun, ctx);
+    return kk_unit_box(kk_Unit);
+  }
+  else {
+    // fold the chunk into a partial accumulator (returned through the fork frame)
+    for (kk_ssize_t i = lo; i < hi; i++) {
+      kk_function_t f = kk_function_dup(fun);
+      acc = kk_function_call(kk_box_t,(kk_function_t,kk_box_t,kk_box_t,kk_context_t*),f,(f,acc,kk_box_dup(src[i]),ctx));
+    }
+    kk_function_drop(fun, ctx);
+    return acc;
+  }
+}
+
+static kk_function_t kk_par_chunk_alloc( kk_function_t fun, const kk_box_t* src, kk_box_t* dst, kk_box_t init, kk_ssize_t lo, kk_ssize_t hi, kk_context_t* ctx ) {
+  struct kk_par_chunk_fun_s* f = kk_function_alloc_as(struct kk_par_chunk_fun_s, 7, ctx);
+  f->_base.fun = kk_cfun_ptr_box(&kk_par_chunk_fun, ctx);
+  f->fun = kk_function_box(fun);
+  f->src = kk_cptr_box((void*)src, ctx);
+  f->dst = (dst == NULL ? kk_box_null : kk_cptr_box(dst, ctx));
+  f->init = init;
+  f->lo = kk_ssize_box(lo, ctx);
+  f->hi = kk_ssize_box(hi, ctx);
+  return &f->_base;
+}
+
+// the task group for parallel maps/folds; lets the main thread participate (as `kk_task_schedule`)
+static kk_task_group_t* kk_par_task_group(kk_context_t* ctx) {
+  pthread_once( &task_group_once, &kk_task_group_init );
+  if (ctx->task_group == NULL) { ctx->task_group = task_group; }
+  return ctx->task_group;
+}
+
+// chunk size for `n` elements: whole cache lines, and at most a few chunks per worker
+static kk_ssize_t kk_par_chunk_size( kk_task_group_t* tg, kk_ssize_t n ) {
+  if (tg == NULL || tg->done || tg->thread_count <= 1 || n < 2*KK_PAR_LINE_ELEMS) {
+    return n;  // sequential
+  }
+  const kk_ssize_t chunks = KK_PAR_CHUNKS_PER_THREAD * tg->thread_count;
+  const kk_ssize_t size = (((n + chunks - 1) / chunks) + KK_PAR_LINE_ELEMS - 1) & ~(KK_PAR_LINE_ELEMS - 1);
+  return (size >= n ? n : size);
+}
+
+kk_vector_t kk_vector_par_map( kk_vector_t v, kk_function_t fun, kk_context_t* ctx ) {
+  kk_ssize_t n;
+  const kk_box_t* src = kk_vector_buf_borrow(v, &n);
+  kk_task_group_t* tg = kk_par_task_group(ctx);
+  const kk_ssize_t size = kk_par_chunk_size(tg, n);
+  kk_box_t* dst;
+  kk_vector_t res = kk_vector_alloc_uninit(n, &dst, ctx);
+  if (size < n) {
+    // parallel: workers dup source elements and our function concurrently
+    kk_task_group_mark_shared(tg, kk_datatype_as_ptr(v), ctx);
+    kk_task_group_mark_shared(tg, &fun->_block, ctx);
+    const kk_ssize_t nforks = (n - 1) / size;  // chunks beyond the first
+    kk_fork_t* forks = (kk_fork_t*)kk_malloc(nforks * kk_ssizeof(kk_fork_t), ctx);
+    for (kk_ssize_t c = 0; c < nforks; c++) {
+      const kk_ssize_t lo = (c + 1)*size;
+      const kk_ssize_t hi = (lo + size > n ? n : lo + size);
+      kk_task_fork(&forks[c], kk_par_chunk_alloc(kk_function_dup(fun), src, dst, kk_box_null, lo, hi, ctx), ctx);
+    }
+    for (kk_ssize_t i = 0; i < size; i++) {      // our own first chunk
+      kk_function_t f = kk_function_dup(fun);
+      dst[i] = kk_function_call(kk_box_t,(kk_function_t,kk_box_t,kk_context_t*),f,(f,kk_box_dup(src[i]),ctx));
+    }
+    for (kk_ssize_t c = 0; c < nforks; c++) {
+      kk_box_drop(kk_task_join(&forks[c], ctx), ctx);  // unit results
+    }
+    kk_free(forks, ctx);
+  }
+  else {
+    for (kk_ssize_t i = 0; i < n; i++) {
+      kk_function_t f = kk_function_dup(fun);
+      dst[i] = kk_function_call(kk_box_t,(kk_function_t,kk_box_t,kk_context_t*),f,(f,kk_box_dup(src[i]),ctx));
+    }
+  }
+  kk_function_drop(fun, ctx);
+  kk_vector_drop(v, ctx);
+  return res;
+}
+
+kk_box_t kk_vector_par_fold( kk_vector_t v, kk_box_t init, kk_function_t fun, kk_context_t* ctx ) {
+  kk_ssize_t n;
+  const kk_box_t* src = kk_vector_buf_borrow(v, &n);
+  kk_task_group_t* tg = kk_par_task_group(ctx);
+  const kk_ssize_t size = kk_par_chunk_size(tg, n);
+  kk_box_t acc = init;
+  if (size < n) {
+    kk_task_group_mark_shared(tg, kk_datatype_as_ptr(v), ctx);
+    kk_task_group_mark_shared(tg, &fun->_block, ctx);
+    kk_box_mark_shared(init, ctx);               // every chunk starts from `init`
+    const kk_ssize_t nforks = (n - 1) / size;
+    kk_fork_t* forks = (kk_fork_t*)kk_malloc(nforks * kk_ssizeof(kk_fork_t), ctx);
+    for (kk_ssize_t c = 0; c < nforks; c++) {
+      const kk_ssize_t lo = (c + 1)*size;
+      const kk_ssize_t hi = (lo + size > n ? n : lo + size);
+      kk_task_fork(&forks[c], kk_par_chunk_alloc(kk_function_dup(fun), src, NULL, kk_box_dup(init), lo, hi, ctx), ctx);
+    }
+    for (kk_ssize_t i = 0; i < size; i++) {      // our own first chunk
+      kk_function_t f = kk_function_dup(fun);
+      acc = kk_function_call(kk_box_t,(kk_function_t,kk_box_t,kk_box_t,kk_context_t*),f,(f,acc,kk_box_dup(src[i]),ctx));
+    }
+    for (kk_ssize_t c = 0; c < nforks; c++) {    // combine the partials in index order
+      kk_box_t partial = kk_task_join(&forks[c], ctx);
+      kk_function_t f = kk_function_dup(fun);
+      acc = kk_function_call(kk_box_t,(kk_function_t,kk_box_t,kk_box_t,kk_context_t*),f,(f,acc,partial,ctx));
+    }
+    kk_free(forks, ctx);
+  }
+  else {
+    for (kk_ssize_t i = 0; i < n; i++) {
+      kk_function_t f = kk_function_dup(fun);
+      acc = kk_function_call(kk_box_t,(kk_function_t,kk_box_t,kk_box_t,kk_context_t*),f,(f,acc,kk_box_dup(src[i]),ctx));
+    }
+  }
+  kk_function_drop(fun, ctx);
+  kk_vector_drop(v, ctx);
+  return acc;
+}
+
+
+/*---------------------------------------------------------------------------
+  Bounded channel
+  A bounded multi-producer multi-consumer ring buffer with a per-slot
+  sequence number (in the style of Vyukov's bounded mpmc queue): producers
+  and consumers claim a ticket with one CAS on their own counter and then
+  synchronize through the slot sequence alone, so a streaming pipeline
+  passes items without locks or per-item heap traffic. Parking on a full
+  or empty channel reuses the futex wait/notify above (like promises), and
+  wakes are only issued when a waiter announced itself, so the fast path
+  makes no system calls.
+---------------------------------------------------------------------------*/
+
+typedef struct kk_chan_slot_s {
+  _Atomic(kk_ssize_t) seq;
+  kk_box_t            value;
+} kk_chan_slot_t;
+
+typedef struct channel_s {
+  kk_ssize_t          mask;         // capacity - 1 (the capacity is a power of two)
+  kk_chan_slot_t*     slots;
+  _Atomic(kk_ssize_t) head;         // next send ticket
+  _Atomic(kk_ssize_t) tail;         // next receive ticket
+  _Atomic(uint32_t)   recv_version; // bumped on send (and close); receivers park on this word
+  _Atomic(uint32_t)   send_version; // bumped on receive (and close); senders park on this word
+  _Atomic(uint32_t)   recv_waiting; // receivers parked (or about to park)
+  _Atomic(uint32_t)   send_waiting; // senders parked (or about to park)
+  _Atomic(uint32_t)   closed;
+} channel_t;
+
+static void kk_chan_free( void* vch, kk_block_t* b, kk_context_t* ctx ) {
+  kk_unused(b);
+  channel_t* ch = (channel_t*)vch;
+  // drop the items still in the ring (no concurrent access: this was the last reference)
+  kk_ssize_t t = kk_atomic_load_relaxed(&ch->tail);
+  while (kk_atomic_load_relaxed(&ch->slots[t & ch->mask].seq) == t + 1) {
+    kk_box_drop(ch->slots[t & ch->mask].value, ctx);
+    t++;
+  }
+  kk_free(ch->slots, ctx);
+  kk_free(ch, ctx);
+}
+
+kk_chan_t kk_chan_alloc( kk_ssize_t capacity, kk_context_t* ctx ) {
+  kk_ssize_t cap = 2;
+  while (cap < capacity && cap < (KK_IZ(1) << 30)) { cap *= 2; }  // round up to a power of two
+  channel_t* ch = (channel_t*)kk_zalloc(kk_ssizeof(channel_t), ctx);
+  if (ch == NULL) return kk_box_any(ctx);
+  ch->slots = (kk_chan_slot_t*)kk_zalloc(cap * kk_ssizeof(kk_chan_slot_t), ctx);
+  if (ch->slots == NULL) { kk_free(ch, ctx); return kk_box_any(ctx); }
+  ch->mask = cap - 1;
+  for (kk_ssize_t i = 0; i < cap; i++) {
+    kk_atomic_store_relaxed(&ch->slots[i].seq, i);
+  }
+  kk_chan_t chb = kk_cptr_raw_box(&kk_chan_free, ch, ctx);
+  kk_box_mark_shared(chb, ctx);
+  return chb;
+}
+
+bool kk_chan_send( kk_chan_t chb, kk_box_t v, kk_context_t* ctx ) {
+  channel_t* ch = (channel_t*)kk_cptr_raw_unbox(chb);
+  kk_box_mark_shared(v, ctx);  // the value crosses threads
+  kk_chan_slot_t* slot;
+  kk_ssize_t e = kk_atomic_load_relaxed(&ch->head);
+  while (true) {
+    if (kk_unlikely(kk_atomic_load_acquire(&ch->closed) != 0)) {
+      kk_box_drop(v, ctx);
+      kk_box_drop(chb, ctx);
+      return false;
+    }
+    slot = &ch->slots[e & ch->mask];
+    const kk_ssize_t dif = kk_atomic_load_acquire(&slot->seq) - e;
+    if (dif == 0) {
+      if (kk_atomic_cas_weak_relaxed(&ch->head, &e, e + 1)) break;  // claimed the slot (`e` is reloaded on failure)
+    }
+    else if (dif < 0) {
+      // full: park until a receiver frees a slot (or the channel is closed)
+      kk_atomic(fetch_add)(&ch->send_waiting, 1);  // seq_cst: orders against the waiting check in `kk_chan_recv`
+      const uint32_t version = kk_atomic_load_acquire(&ch->send_version);
+      if (kk_atomic_load_acquire(&slot->seq) - e < 0 && kk_atomic_load_relaxed(&ch->closed) == 0) {
+        kk_futex_wait(&ch->send_version, version);
+      }
+      kk_atomic(fetch_sub)(&ch->send_waiting, 1);
+      e = kk_atomic_load_relaxed(&ch->head);
+    }
+    else {
+      e = kk_atomic_load_relaxed(&ch->head);  // raced with another sender
+    }
+  }
+  slot->value = v;
+  kk_atomic_store_release(&slot->seq, e + 1);  // publish
+  if (kk_atomic(load)(&ch->recv_waiting) > 0) {  // seq_cst: see the park in `kk_chan_recv`
+    kk_atomic_inc_relaxed(&ch->recv_version);
+    kk_futex_wake_all(&ch->recv_version);
+  }
+  kk_box_drop(chb, ctx);
+  return true;
+}
+
+bool kk_chan_recv( kk_chan_t chb, kk_box_t* result, kk_context_t* ctx ) {
+  channel_t* ch = (channel_t*)kk_cptr_raw_unbox(chb);
+  kk_chan_slot_t* slot;
+  kk_ssize_t t = kk_atomic_load_relaxed(&ch->tail);
+  while (true) {
+    slot = &ch->slots[t & ch->mask];
+    const kk_ssize_t dif = kk_atomic_load_acquire(&slot->seq) - (t + 1);
+    if (dif == 0) {
+      if (kk_atomic_cas_weak_relaxed(&ch->tail, &t, t + 1)) break;  // claimed the item (`t` is reloaded on failure)
+    }
+    else if (dif < 0) {
+      // empty; closed and drained? (a sender that already claimed a ticket still delivers: `head > t`)
+      if (kk_atomic_load_acquire(&ch->closed) != 0 && kk_atomic_load_relaxed(&ch->head) == t) {
+        kk_box_drop(chb, ctx);
+        return false;
+      }
+      // if part of a task group, run other tasks while waiting
+      if (ctx->task_group != NULL) {
+        kk_task_group_t* tg = ctx->task_group;
+        kk_task_t* task = (tg->done ? NULL : kk_task_group_take(tg));
+        if (task != NULL) {
+          kk_task_exec(task, ctx);
+          t = kk_atomic_load_relaxed(&ch->tail);
+          continue;
         }
-        */        
       }
+      // park until a sender publishes an item (or the channel is closed)
+      kk_atomic(fetch_add)(&ch->recv_waiting, 1);  // seq_cst: orders against the waiting check in `kk_chan_send`
+      const uint32_t version = kk_atomic_load_acquire(&ch->recv_version);
+      if (kk_atomic_load_acquire(&slot->seq) - (t + 1) < 0 && kk_atomic_load_relaxed(&ch->closed) == 0) {
+        kk_futex_wait(&ch->recv_version, version);
+      }
+      kk_atomic(fetch_sub)(&ch->recv_waiting, 1);
+      t = kk_atomic_load_relaxed(&ch->tail);
     }
-    // if in the main thread do a blocking wait
     else {
-      pthread_cond_wait( &p->available, &p->lock );
+      t = kk_atomic_load_relaxed(&ch->tail);  // raced with another receiver
     }
   }
-  pthread_mutex_unlock(&p->lock);  
-  const kk_box_t result = kk_box_dup( p->result );
-  kk_box_drop(pr,ctx);
-  return result;
+  *result = slot->value;
+  kk_atomic_store_release(&slot->seq, t + ch->mask + 1);  // free the slot for the next lap
+  if (kk_atomic(load)(&ch->send_waiting) > 0) {  // seq_cst: see the park in `kk_chan_send`
+    kk_atomic_inc_relaxed(&ch->send_version);
+    kk_futex_wake_all(&ch->send_version);
+  }
+  kk_box_drop(chb, ctx);
+  return true;
+}
+
+void kk_chan_close( kk_chan_t chb, kk_context_t* ctx ) {
+  channel_t* ch = (channel_t*)kk_cptr_raw_unbox(chb);
+  kk_atomic_store_release(&ch->closed, 1);
+  // bump both words so parked threads re-check the closed flag
+  kk_atomic_inc_relaxed(&ch->recv_version);
+  kk_atomic_inc_relaxed(&ch->send_version);
+  kk_futex_wake_all(&ch->recv_version);
+  kk_futex_wake_all(&ch->send_version);
+  kk_box_drop(chb, ctx);
 }
 
 
 /*---------------------------------------------------------------------------
    Lvar
+   A monotonic shared variable: `put` joins a value into the state and `get`
+   blocks until the state passes a threshold. Fan-in aggregation (hundreds
+   of tasks putting into one lvar) used to collapse on a single mutex, so
+   puts now land in per-thread stripes instead: a put exchanges its value
+   into its own stripe lock-free (combining outside any lock when the
+   stripe was occupied) and only a get folds the stripes into the root
+   under the mutex. Getters announce themselves so the futex wake on the
+   put path is skipped entirely while nobody waits.
 ---------------------------------------------------------------------------*/
 
+#define KK_LVAR_MAX_STRIPES  (64)
+
+typedef struct kk_lvar_stripe_s {
+  _Atomic(uintptr_t) value;   // boxed partial join, or `kk_box_null` when empty
+  uintptr_t          pad[7];  // keep concurrently written stripes on separate cache lines
+} kk_lvar_stripe_t;
+
 typedef struct lvar_s {
-  kk_box_t        result;
-  pthread_mutex_t lock;
-  pthread_cond_t  available;
+  kk_box_t          result;   // root join of the drained stripes; protected by `lock`
+  pthread_mutex_t   lock;     // protects `result` (getters fold and inspect under it)
+  _Atomic(uint32_t) version;  // bumped on every put; waiters park on this word
+  _Atomic(uint32_t) waiters;  // parked (or about to park) getters
+  _Atomic(kk_function_t) combine;  // the monotonic join, stashed by the first put
+  kk_ssize_t        stripe_count;  // a power of two
+  kk_lvar_stripe_t  stripes[1];    // allocated to `stripe_count` entries
 } lvar_t;
 
+// per-thread stripe index, assigned on first use
+static _Atomic(kk_ssize_t) lvar_thread_ids;
+static kk_decl_thread kk_ssize_t lvar_thread_id = -1;
+
+static kk_lvar_stripe_t* kk_lvar_stripe_of( lvar_t* lv ) {
+  if (lvar_thread_id < 0) { lvar_thread_id = kk_atomic(fetch_add)(&lvar_thread_ids, 1); }
+  return &lv->stripes[lvar_thread_id & (lv->stripe_count - 1)];
+}
+
+// fold the pending stripe values into the root; the caller holds `lv->lock`.
+static void kk_lvar_fold( lvar_t* lv, kk_context_t* ctx ) {
+  kk_function_t combine = kk_atomic_load_acquire(&lv->combine);
+  for (kk_ssize_t i = 0; i < lv->stripe_count; i++) {
+    kk_box_t val;
+    val.box = kk_atomic(exchange)(&lv->stripes[i].value, kk_box_null.box);
+    if (!kk_box_is_null(val)) {
+      kk_assert_internal(combine != NULL);  // set before the first stripe value is published
+      kk_function_dup(combine);
+      lv->result = kk_function_call(kk_box_t,(kk_function_t,kk_box_t,kk_box_t,kk_context_t*),combine,(combine,val,lv->result,ctx));
+    }
+  }
+  kk_box_mark_shared(lv->result, ctx);  // the result is handed out across threads
+}
+
 typedef kk_box_t kk_lvar_t;
 
 kk_lvar_t kk_lvar_alloc( kk_box_t init, kk_context_t* ctx );
@@ -496,19 +1370,32 @@ kk_box_t  kk_lvar_get( kk_lvar_t lvar, kk_box_t bot, kk_function_t is_gte, kk_co
 static void kk_lvar_free( void* lvar, kk_block_t* b, kk_context_t* ctx ) {
   kk_unused(b);
   lvar_t* lv = (lvar_t*)(lvar);
-  pthread_cond_destroy(&lv->available);
-  pthread_mutex_destroy(&lv->lock);  
+  pthread_mutex_destroy(&lv->lock);
+  for (kk_ssize_t i = 0; i < lv->stripe_count; i++) {  // drop stripes that were never folded
+    kk_box_t val;
+    val.box = kk_atomic_load_relaxed(&lv->stripes[i].value);
+    if (!kk_box_is_null(val)) { kk_box_drop(val,ctx); }
+  }
+  kk_function_t combine = kk_atomic_load_relaxed(&lv->combine);
+  if (combine != NULL) { kk_function_drop(combine,ctx); }
   kk_box_drop(lv->result,ctx);
   kk_free(lv,ctx);
 }
 
 kk_lvar_t kk_lvar_alloc(kk_box_t init, kk_context_t* ctx) {
   kk_lvar_t lvar;
-  lvar_t* lv = (lvar_t*)kk_zalloc(kk_ssizeof(lvar_t),ctx);
+  kk_ssize_t stripe_count = 2;
+  const kk_ssize_t cpu_count = kk_cpu_count(ctx);
+  while (stripe_count < cpu_count && stripe_count < KK_LVAR_MAX_STRIPES) { stripe_count *= 2; }
+  lvar_t* lv = (lvar_t*)kk_zalloc(kk_ssizeof(lvar_t) + (stripe_count - 1)*kk_ssizeof(kk_lvar_stripe_t),ctx);
   if (lv == NULL) goto err;
   lv->result = init;
+  lv->stripe_count = stripe_count;
+  for (kk_ssize_t i = 0; i < stripe_count; i++) {
+    kk_atomic_store_relaxed(&lv->stripes[i].value, kk_box_null.box);
+  }
   if (pthread_mutex_init(&lv->lock, NULL) != 0) goto err;
-  if (pthread_cond_init(&lv->available, NULL) != 0) goto err;
+  kk_atomic_store_relaxed(&lv->version, 0);
   lvar = kk_cptr_raw_box( &kk_lvar_free, lv, ctx );
   kk_box_mark_shared(init,ctx);
   kk_box_mark_shared(lvar,ctx);
@@ -522,11 +1409,33 @@ err:
 
 void kk_lvar_put( kk_lvar_t lvar, kk_box_t val, kk_function_t monotonic_combine, kk_context_t* ctx ) {
   lvar_t* lv = (lvar_t*)kk_cptr_raw_unbox(lvar);
-  pthread_mutex_lock(&lv->lock);
-  lv->result = kk_function_call(kk_box_t,(kk_function_t,kk_box_t,kk_box_t,kk_context_t*),monotonic_combine,(monotonic_combine,val,lv->result,ctx));
-  kk_box_mark_shared(lv->result,ctx);  // todo: can we mark outside the mutex?
-  pthread_mutex_unlock(&lv->lock);
-  pthread_cond_signal(&lv->available);
+  kk_box_mark_shared(val,ctx);  // outside any lock; a getter on another thread drains the stripe
+  // stash the combine so getters can fold the stripes (the join is the same across puts)
+  kk_block_mark_shared(&monotonic_combine->_block,ctx);
+  kk_function_t expected = NULL;
+  if (!kk_atomic_cas_strong_acq_rel(&lv->combine, &expected, monotonic_combine)) {
+    kk_function_drop(monotonic_combine,ctx);  // an earlier put already stored it
+  }
+  // publish into our own stripe: an exchange-based join, so concurrent puts
+  // to the same stripe and a draining getter never lose a value and the
+  // user combine always runs outside any lock
+  kk_lvar_stripe_t* stripe = kk_lvar_stripe_of(lv);
+  while (true) {
+    uintptr_t empty = kk_box_null.box;
+    if (kk_atomic_cas_strong_acq_rel(&stripe->value, &empty, val.box)) break;
+    kk_box_t cur;
+    cur.box = kk_atomic(exchange)(&stripe->value, kk_box_null.box);  // take the partial join out
+    if (!kk_box_is_null(cur)) {
+      kk_function_t combine = kk_atomic_load_relaxed(&lv->combine);
+      kk_function_dup(combine);
+      val = kk_function_call(kk_box_t,(kk_function_t,kk_box_t,kk_box_t,kk_context_t*),combine,(combine,val,cur,ctx));
+      kk_box_mark_shared(val,ctx);
+    }
+  }
+  kk_atomic(fetch_add)(&lv->version, 1);  // seq_cst: orders against the waiter check
+  if (kk_atomic(load)(&lv->waiters) > 0) {  // targeted: no system call while nobody waits
+    kk_futex_wake_all(&lv->version);
+  }
   kk_box_drop(lvar,ctx);
 }
 
@@ -536,6 +1445,10 @@ kk_box_t kk_lvar_get( kk_lvar_t lvar, kk_box_t bot, kk_function_t is_gte, kk_con
   kk_box_t result;
   pthread_mutex_lock(&lv->lock);
   while (true) {
+    // read the version before folding: a put that lands after the fold bumps
+    // past it and makes the park below return immediately
+    const uint32_t version = kk_atomic_load_acquire(&lv->version);
+    kk_lvar_fold(lv, ctx);
     kk_function_dup(is_gte);
     kk_box_dup(lv->result);
     kk_box_dup(bot);
@@ -544,51 +1457,25 @@ kk_box_t kk_lvar_get( kk_lvar_t lvar, kk_box_t bot, kk_function_t is_gte, kk_con
       result = kk_box_dup(lv->result);
       break;
     }
+    kk_atomic(fetch_add)(&lv->waiters, 1);  // seq_cst: announce before the put checks
+    pthread_mutex_unlock(&lv->lock);
     // if part of a task group, run other tasks while waiting
+    kk_task_t* task = NULL;
     if (ctx->task_group != NULL) {
-      pthread_mutex_unlock(&lv->lock);
-      // try to get a task
+      // try to get a task (pop locally, drain the submission queue, or steal)
       kk_task_group_t* tg = ctx->task_group;
-      kk_task_t* task = NULL;
-      pthread_mutex_lock(&tg->tasks_lock);
-      if (!kk_tasks_is_empty(tg) && !tg->done) {
-        task = kk_tasks_dequeue(tg);
-      }
-      pthread_mutex_unlock(&tg->tasks_lock);
-      // run task
-      if (task != NULL) { 
-        kk_task_exec(task, ctx);
-        pthread_mutex_lock(&lv->lock);        
-      }
-      else {
-        pthread_mutex_lock(&lv->lock);
-        if (kk_box_is_any(lv->result)) {
-          pthread_cond_wait( &lv->available, &lv->lock);
-        }
-        /*
-        // no task, block for a while
-        struct timespec tm;
-        clock_gettime(CLOCK_REALTIME, &tm);
-        tm.tv_nsec     +=  100000000;  // 0.1s
-        if (tm.tv_nsec >= 1000000000) {
-          tm.tv_nsec   -= 1000000000;
-          tm.tv_sec += 1;
-        }
-        pthread_mutex_lock(&lv->lock);
-        if (kk_box_is_any(lv->result)) {
-          if (pthread_cond_timedwait( &lv->available, &lv->lock, &tm) == ETIMEDOUT) {
-            pthread_mutex_lock(&lv->lock); 
-          }
-        }
-        */        
-      }
+      task = (tg->done ? NULL : kk_task_group_take(tg));
+    }
+    if (task != NULL) {
+      kk_task_run(task, ctx);
     }
-    // if in the main thread do a blocking wait
     else {
-      pthread_cond_wait( &lv->available, &lv->lock );
+      kk_futex_wait(&lv->version, version);
     }
+    kk_atomic(fetch_sub)(&lv->waiters, 1);
+    pthread_mutex_lock(&lv->lock);
   }
-  pthread_mutex_unlock(&lv->lock);  
+  pthread_mutex_unlock(&lv->lock);
   kk_box_drop(bot,ctx);
   kk_function_drop(is_gte,ctx);
   kk_box_drop(lvar,ctx);
@@ -90,9 +90,9 @@ static kk_secs_t kk_timer_ticks_prim(kk_asecs_t* asecs, kk_context_t* ctx) {
 #endif
 #endif
 
-kk_decl_export kk_secs_t kk_timer_ticks(kk_asecs_t* atto_secs, kk_context_t* ctx) {
-  kk_asecs_t asecs;
-  kk_secs_t  secs = kk_timer_ticks_prim(&asecs, ctx);
+// Normalize a raw monotonic sample: start the timeline at (about) zero on the
+// first call and keep it monotone over backward clock steps.
+static kk_secs_t kk_timer_ticks_adjust(kk_secs_t secs, kk_asecs_t asecs, kk_asecs_t* atto_secs, kk_context_t* ctx) {
   // init previous and delta
   if (ctx->timer_prev.seconds == 0 && ctx->timer_prev.attoseconds == 0) {
     ctx->timer_prev.seconds = secs;
@@ -120,12 +120,125 @@ kk_decl_export kk_secs_t kk_timer_ticks(kk_asecs_t* atto_secs, kk_context_t* ctx
   return secs;
 }
 
+kk_decl_export kk_secs_t kk_timer_ticks(kk_asecs_t* atto_secs, kk_context_t* ctx) {
+  kk_asecs_t asecs;
+  kk_secs_t  secs = kk_timer_ticks_prim(&asecs, ctx);
+  return kk_timer_ticks_adjust(secs, asecs, atto_secs, ctx);
+}
+
 kk_decl_export kk_asecs_t kk_timer_resolution(kk_context_t* ctx) {
   kk_timer_ticks_prim(NULL, ctx); // initialize
   kk_assert_internal(ctx->timer_freq != 0);
   return (KK_ASECS_PER_SEC / ctx->timer_freq);
 }
 
+/*--------------------------------------------------------------------------------------------------
+  Low overhead timer ticks for high-frequency tracing.
+  `kk_timer_ticks_coarse` reads the kernel coarse clock (updated once per tick, so no
+  hardware clock read) and aligns it to the `kk_timer_ticks` timeline with an offset
+  captured on first use. `kk_timer_ticks_fast` extrapolates the precise clock from
+  the cycle counter, recalibrating against `clock_gettime` about twice a second;
+  until a ~10ms calibration baseline exists it simply takes precise samples.
+  Both report on the `kk_timer_ticks` timeline so the three can be mixed, though
+  coarse values lag the others by up to one kernel tick (~1-16ms).
+--------------------------------------------------------------------------------------------------*/
+
+static int64_t kk_timer_ticks_nsecs(kk_context_t* ctx) {
+  kk_asecs_t asecs;
+  kk_secs_t  secs = kk_timer_ticks_prim(&asecs, ctx);
+  return (secs*KK_NSECS_PER_SEC + asecs/KK_ASECS_PER_NSEC);
+}
+
+kk_decl_export kk_secs_t kk_timer_ticks_coarse(kk_asecs_t* atto_secs, kk_context_t* ctx) {
+  int64_t ns;
+#if defined(WIN32)
+  ns = (int64_t)GetTickCount64() * KK_I64(1000000);
+#elif defined(CLOCK_MONOTONIC_COARSE)
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC_COARSE, &t);
+  ns = t.tv_sec*KK_NSECS_PER_SEC + t.tv_nsec;
+#else
+  kk_unused(ns);
+  return kk_timer_ticks(atto_secs, ctx);  // no coarse clock on this platform
+#endif
+#if defined(WIN32) || defined(CLOCK_MONOTONIC_COARSE)
+  if (ctx->timer_coarse_ofs == 0) {
+    // align to the adjusted `kk_timer_ticks` timeline on first use (one precise sample);
+    // after that the coarse clock is monotone by itself and never touches the
+    // `timer_prev`/`timer_delta` state of the precise timer.
+    kk_asecs_t asecs;
+    kk_secs_t  secs = kk_timer_ticks(&asecs, ctx);
+    ctx->timer_coarse_ofs = ns - (secs*KK_NSECS_PER_SEC + asecs/KK_ASECS_PER_NSEC);
+    if (ctx->timer_coarse_ofs == 0) { ctx->timer_coarse_ofs = 1; }
+  }
+  ns -= ctx->timer_coarse_ofs;
+  if (ns < 0) { ns = 0; }
+  if (atto_secs != NULL) { *atto_secs = (ns % KK_NSECS_PER_SEC)*KK_ASECS_PER_NSEC; }
+  return (ns / KK_NSECS_PER_SEC);
+#endif
+}
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define KK_HAS_TSC   (1)
+static inline uint64_t kk_tsc_read(void) { return __rdtsc(); }
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KK_HAS_TSC   (1)
+static inline uint64_t kk_tsc_read(void) {
+  uint32_t lo, hi;
+  __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+  return (((uint64_t)hi << 32) | lo);
+}
+#elif defined(__GNUC__) && defined(__aarch64__)
+#define KK_HAS_TSC        (1)
+#define KK_TSC_FREQ_KNOWN (1)   // the generic timer advertises its own frequency
+static inline uint64_t kk_tsc_read(void) {
+  uint64_t t; __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(t)); return t;
+}
+static inline uint64_t kk_tsc_freq(void) {
+  uint64_t f; __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(f)); return f;
+}
+#endif
+
+#if defined(KK_HAS_TSC)
+#define KK_TSC_RECAL_NSECS    KK_I64(500000000)  // extrapolate at most 0.5s from a calibration point
+#define KK_TSC_CAL_MIN_NSECS  KK_I64(10000000)   // baseline needed to estimate the tsc frequency
+#endif
+
+kk_decl_export kk_secs_t kk_timer_ticks_fast(kk_asecs_t* atto_secs, kk_context_t* ctx) {
+#if defined(KK_HAS_TSC)
+  const uint64_t tsc = kk_tsc_read();
+  if (ctx->tsc_nsec_per_cycle > 0.0 && tsc >= ctx->tsc_base) {
+    const int64_t ns = ctx->tsc_time_base + (int64_t)((double)(tsc - ctx->tsc_base) * ctx->tsc_nsec_per_cycle);
+    if (ns - ctx->tsc_time_base < KK_TSC_RECAL_NSECS) {
+      return kk_timer_ticks_adjust(ns / KK_NSECS_PER_SEC, (ns % KK_NSECS_PER_SEC)*KK_ASECS_PER_NSEC, atto_secs, ctx);
+    }
+  }
+  // (re)calibrate against the precise clock
+  const int64_t ns = kk_timer_ticks_nsecs(ctx);
+#if defined(KK_TSC_FREQ_KNOWN)
+  ctx->tsc_nsec_per_cycle = (double)KK_NSECS_PER_SEC / (double)kk_tsc_freq();
+  ctx->tsc_base = tsc;
+  ctx->tsc_time_base = ns;
+#else
+  if (ctx->tsc_base == 0) {
+    ctx->tsc_base = tsc;           // first sample: start the calibration baseline
+    ctx->tsc_time_base = ns;
+  }
+  else if (ns - ctx->tsc_time_base >= KK_TSC_CAL_MIN_NSECS && tsc > ctx->tsc_base) {
+    // assumes an invariant tsc (as on all current x64); a non-invariant tsc only
+    // degrades precision as every sample recalibrates within the baseline window
+    ctx->tsc_nsec_per_cycle = (double)(ns - ctx->tsc_time_base) / (double)(tsc - ctx->tsc_base);
+    ctx->tsc_base = tsc;
+    ctx->tsc_time_base = ns;
+  }
+#endif
+  return kk_timer_ticks_adjust(ns / KK_NSECS_PER_SEC, (ns % KK_NSECS_PER_SEC)*KK_ASECS_PER_NSEC, atto_secs, ctx);
+#else
+  return kk_timer_ticks(atto_secs, ctx);  // no cycle counter on this platform
+#endif
+}
+
 /*--------------------------------------------------------------------------------------------------
   Current Time
 --------------------------------------------------------------------------------------------------*/
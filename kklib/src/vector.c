@@ -50,12 +50,116 @@ kk_vector_t kk_vector_copy(kk_vector_t vec, kk_context_t* ctx) {
   return kk_vector_realloc(vec, len, kk_box_null, ctx);
 }
 
+/*--------------------------------------------------------------------------------------------------
+  Views
+  A view shares the parent's element storage so taking a sub-range is O(1);
+  the parent is kept alive through the view's scanned parent field and is
+  released by the generic drop path when the last view drops. Views of views
+  are flattened so chains never build up.
+--------------------------------------------------------------------------------------------------*/
+
+kk_vector_t kk_vector_view(kk_vector_t vec, kk_ssize_t offset, kk_ssize_t length, kk_context_t* ctx) {
+  kk_ssize_t len;
+  kk_vector_buf_borrow(vec, &len);
+  if (offset < 0) { offset = 0; }
+  if (offset > len) { offset = len; }
+  if (length > len - offset) { length = len - offset; }
+  if (length <= 0) {
+    kk_vector_drop(vec, ctx);
+    return kk_vector_empty();
+  }
+  if (offset == 0 && length == len) {
+    return vec;  // the whole range (also catches a view over its full range)
+  }
+  if (kk_datatype_has_ptr_tag(vec, KK_TAG_VECTOR_VIEW)) {
+    // flatten: view into the view's parent directly
+    kk_vector_view_t vw = kk_datatype_as_assert(kk_vector_view_t, vec, KK_TAG_VECTOR_VIEW);
+    offset += vw->offset;
+    kk_vector_t parent = kk_datatype_unbox(kk_box_dup(vw->parent));
+    kk_vector_drop(vec, ctx);
+    vec = parent;
+  }
+  kk_vector_view_t v = kk_block_alloc_as(struct kk_vector_view_s, 1, KK_TAG_VECTOR_VIEW, ctx);
+  v->parent = kk_datatype_box(vec);
+  v->offset = offset;
+  v->length = length;
+  return kk_datatype_from_ptr(&v->_block);
+}
+
+/*--------------------------------------------------------------------------------------------------
+  Unboxed vectors
+  The elements are plain `int64_t`/`double` values so initialization and
+  copying is a flat fill/memcpy without any reference count traffic.
+--------------------------------------------------------------------------------------------------*/
+
+kk_vector_int64_t kk_vector_int64_alloc(kk_ssize_t length, int64_t def, kk_context_t* ctx) {
+  int64_t* v;
+  kk_vector_int64_t vec = kk_vector_int64_alloc_uninit(length, &v, ctx);
+  for (kk_ssize_t i = 0; i < length; i++) {
+    v[i] = def;
+  }
+  return vec;
+}
+
+kk_vector_float64_t kk_vector_float64_alloc(kk_ssize_t length, double def, kk_context_t* ctx) {
+  double* v;
+  kk_vector_float64_t vec = kk_vector_float64_alloc_uninit(length, &v, ctx);
+  for (kk_ssize_t i = 0; i < length; i++) {
+    v[i] = def;
+  }
+  return vec;
+}
+
+kk_vector_int64_t kk_vector_int64_copy(kk_vector_int64_t vec, kk_context_t* ctx) {
+  kk_ssize_t len;
+  const int64_t* src = kk_vector_int64_buf_borrow(vec, &len);
+  int64_t* dest;
+  kk_vector_int64_t vdest = kk_vector_int64_alloc_uninit(len, &dest, ctx);
+  if (len > 0) { kk_memcpy(dest, src, len*kk_ssizeof(int64_t)); }
+  kk_vector_int64_drop(vec, ctx);
+  return vdest;
+}
+
+kk_vector_float64_t kk_vector_float64_copy(kk_vector_float64_t vec, kk_context_t* ctx) {
+  kk_ssize_t len;
+  const double* src = kk_vector_float64_buf_borrow(vec, &len);
+  double* dest;
+  kk_vector_float64_t vdest = kk_vector_float64_alloc_uninit(len, &dest, ctx);
+  if (len > 0) { kk_memcpy(dest, src, len*kk_ssizeof(double)); }
+  kk_vector_float64_drop(vec, ctx);
+  return vdest;
+}
+
+// functional update: in-place when unique, and a fresh copy otherwise
+kk_vector_int64_t kk_vector_int64_set(kk_vector_int64_t vec, kk_ssize_t i, int64_t value, kk_context_t* ctx) {
+  if (kk_unlikely(!kk_datatype_is_unique(vec))) {
+    vec = kk_vector_int64_copy(vec, ctx);
+  }
+  kk_ssize_t len;
+  int64_t* v = kk_vector_int64_buf_borrow(vec, &len);
+  kk_assert(i >= 0 && i < len);
+  v[i] = value;
+  return vec;
+}
+
+kk_vector_float64_t kk_vector_float64_set(kk_vector_float64_t vec, kk_ssize_t i, double value, kk_context_t* ctx) {
+  if (kk_unlikely(!kk_datatype_is_unique(vec))) {
+    vec = kk_vector_float64_copy(vec, ctx);
+  }
+  kk_ssize_t len;
+  double* v = kk_vector_float64_buf_borrow(vec, &len);
+  kk_assert(i >= 0 && i < len);
+  v[i] = value;
+  return vec;
+}
+
 kk_unit_t kk_ref_vector_assign_borrow(kk_ref_t r, kk_integer_t idx, kk_box_t value, kk_context_t* ctx) {
   if (kk_likely(!kk_block_is_thread_shared(&r->_block))) {
     // fast path
     kk_box_t b; b.box = kk_atomic_load_relaxed(&r->value);
     kk_vector_t v = kk_vector_unbox(b, ctx);
-    if(kk_unlikely(! kk_datatype_is_unique(v))) {
+    // a view is never updated in place: even a unique view block shares the parent's storage
+    if(kk_unlikely(! kk_datatype_is_unique(v) || kk_datatype_has_ptr_tag(v, KK_TAG_VECTOR_VIEW))) {
       // the old v is dropped by kk_ref_set_borrow
       v = kk_vector_copy(kk_vector_dup(v), ctx);
       kk_ref_set_borrow(r, kk_vector_box(v, ctx), ctx);
@@ -72,4 +176,235 @@ kk_unit_t kk_ref_vector_assign_borrow(kk_ref_t r, kk_integer_t idx, kk_box_t val
     kk_unsupported_external("kk_ref_vector_assign with a thread-shared reference");
   }
   return kk_Unit;
-}
\ No newline at end of file
+}
+
+/*--------------------------------------------------------------------------------------------------
+  Persistent vectors
+  A 32-way radix-balanced tree (the RRB representation restricted to set and
+  push, which keeps every node off the right edge full so lookups are pure
+  radix arithmetic): `at`/`set`/`push` are O(log32 n) and any number of
+  versions share structure, where a regular `kk_vector_t` update copies all
+  elements unless the vector is unique. The last up to 32 elements live in a
+  separate tail leaf so consecutive pushes touch the tree only once every 32
+  elements. Nodes and leaves are ordinary boxed vectors: the generic Perceus
+  drop- and thread-share marking paths in `refcount.c` release and mark the
+  tree without special cases, and interior updates copy only the root-to-leaf
+  path (mutating in place whenever a node on it is unique).
+--------------------------------------------------------------------------------------------------*/
+
+#define KK_PVEC_BITS   (5)
+#define KK_PVEC_WIDTH  (KK_IZ(1) << KK_PVEC_BITS)   // 32 entries per node
+#define KK_PVEC_MASK   (KK_PVEC_WIDTH - 1)
+
+// index of the first element in the tail leaf
+static kk_ssize_t kk_pvec_tail_off(kk_ssize_t size) {
+  return (size <= KK_PVEC_WIDTH ? 0 : (((size - 1) >> KK_PVEC_BITS) << KK_PVEC_BITS));
+}
+
+static kk_pvec_t kk_pvec_alloc(kk_box_t root, kk_box_t tail, kk_ssize_t size, kk_ssize_t shift, kk_context_t* ctx) {
+  kk_pvec_base_t p = kk_block_alloc_as(struct kk_pvec_s, 2, KK_TAG_PVEC, ctx);
+  p->root  = root;
+  p->tail  = tail;
+  p->size  = size;
+  p->shift = shift;
+  return kk_datatype_from_ptr(&p->_block);
+}
+
+kk_pvec_t kk_pvec_empty(kk_context_t* ctx) {
+  return kk_pvec_alloc(kk_vector_box(kk_vector_empty(), ctx), kk_vector_box(kk_vector_empty(), ctx), 0, 0, ctx);
+}
+
+kk_box_t kk_pvec_at_borrow(kk_pvec_t p, kk_ssize_t i) {
+  kk_pvec_base_t pv = kk_pvec_as_base_borrow(p);
+  kk_assert(i >= 0 && i < pv->size);
+  const kk_ssize_t toff = kk_pvec_tail_off(pv->size);
+  if (i >= toff) {
+    return kk_vector_at_borrow(kk_vector_unbox(pv->tail, NULL), i - toff);
+  }
+  kk_vector_t node = kk_vector_unbox(pv->root, NULL);
+  for (kk_ssize_t level = pv->shift; level > 0; level -= KK_PVEC_BITS) {
+    node = kk_vector_unbox(kk_vector_buf_borrow(node, NULL)[(i >> level) & KK_PVEC_MASK], NULL);
+  }
+  return kk_vector_at_borrow(node, i & KK_PVEC_MASK);
+}
+
+// Ensure a node is unique so its slots can be updated in place (consumes `v`).
+static kk_vector_t kk_pvec_node_unique(kk_vector_t v, kk_context_t* ctx) {
+  if (kk_datatype_is_unique(v)) return v;
+  return kk_vector_copy(v, ctx);
+}
+
+// Append one entry to a node or leaf (nodes keep their exact length); consumes both.
+static kk_vector_t kk_pvec_node_append(kk_vector_t node, kk_box_t x, kk_context_t* ctx) {
+  kk_ssize_t len;
+  kk_box_t* src = kk_vector_buf_borrow(node, &len);
+  kk_box_t* dest;
+  kk_vector_t v = kk_vector_alloc_uninit(len + 1, &dest, ctx);
+  for (kk_ssize_t i = 0; i < len; i++) {
+    dest[i] = kk_box_dup(src[i]);
+  }
+  dest[len] = x;
+  kk_vector_drop(node, ctx);
+  return v;
+}
+
+// Functional update of element `i`: copies only the path from the root (in
+// place when a node is unique). Consumes `node` and `x`.
+static kk_vector_t kk_pvec_node_set(kk_vector_t node, kk_ssize_t level, kk_ssize_t i, kk_box_t x, kk_context_t* ctx) {
+  node = kk_pvec_node_unique(node, ctx);
+  kk_box_t* buf = kk_vector_buf_borrow(node, NULL);
+  const kk_ssize_t idx = ((i >> level) & KK_PVEC_MASK);
+  if (level == 0) {
+    kk_box_drop(buf[idx], ctx);
+    buf[idx] = x;
+  }
+  else {
+    kk_vector_t child = kk_vector_unbox(buf[idx], NULL);  // move out of the (now unique) node
+    buf[idx] = kk_vector_box(kk_pvec_node_set(child, level - KK_PVEC_BITS, i, x, ctx), ctx);
+  }
+  return node;
+}
+
+// A path of singleton nodes of depth `level` down to `leaf`; consumes `leaf`.
+static kk_vector_t kk_pvec_new_path(kk_ssize_t level, kk_vector_t leaf, kk_context_t* ctx) {
+  if (level == 0) return leaf;
+  kk_box_t* buf;
+  kk_vector_t node = kk_vector_alloc_uninit(1, &buf, ctx);
+  buf[0] = kk_vector_box(kk_pvec_new_path(level - KK_PVEC_BITS, leaf, ctx), ctx);
+  return node;
+}
+
+// Insert a full leaf whose first element has index `i` at the right edge of
+// the tree; consumes `node` and `leaf`.
+static kk_vector_t kk_pvec_push_leaf(kk_vector_t node, kk_ssize_t level, kk_ssize_t i, kk_vector_t leaf, kk_context_t* ctx) {
+  kk_assert_internal(level > 0);
+  const kk_ssize_t idx = ((i >> level) & KK_PVEC_MASK);
+  const kk_ssize_t len = kk_vector_len_borrow(node);
+  if (idx < len) {
+    // descend along the right edge (a full leaf child is never descended into)
+    kk_assert_internal(idx == len - 1 && level > KK_PVEC_BITS);
+    node = kk_pvec_node_unique(node, ctx);
+    kk_box_t* buf = kk_vector_buf_borrow(node, NULL);
+    kk_vector_t child = kk_vector_unbox(buf[idx], NULL);
+    buf[idx] = kk_vector_box(kk_pvec_push_leaf(child, level - KK_PVEC_BITS, i, leaf, ctx), ctx);
+    return node;
+  }
+  return kk_pvec_node_append(node, kk_vector_box(kk_pvec_new_path(level - KK_PVEC_BITS, leaf, ctx), ctx), ctx);
+}
+
+kk_pvec_t kk_pvec_push(kk_pvec_t p, kk_box_t x, kk_context_t* ctx) {
+  kk_pvec_base_t pv = kk_pvec_as_base_borrow(p);
+  const kk_ssize_t size = pv->size;
+  const kk_ssize_t toff = kk_pvec_tail_off(size);
+  kk_ssize_t shift = pv->shift;
+  const bool unique = kk_datatype_is_unique(p);
+  kk_box_t root = (unique ? pv->root : kk_box_dup(pv->root));
+  kk_box_t tail = (unique ? pv->tail : kk_box_dup(pv->tail));
+  if (size - toff < KK_PVEC_WIDTH) {
+    // room in the tail
+    tail = kk_vector_box(kk_pvec_node_append(kk_vector_unbox(tail, NULL), x, ctx), ctx);
+  }
+  else {
+    // the tail is full: push it into the tree and start a fresh tail
+    kk_vector_t leaf  = kk_vector_unbox(tail, NULL);
+    kk_vector_t rootv = kk_vector_unbox(root, NULL);
+    if (size == KK_PVEC_WIDTH) {
+      kk_vector_drop(rootv, ctx);  // the empty placeholder: the first leaf becomes the root
+      rootv = leaf;
+      shift = 0;
+    }
+    else if (toff >= (KK_IZ(1) << (shift + KK_PVEC_BITS))) {
+      // the tree is full: grow a new root over the old tree and a fresh path
+      kk_box_t* buf;
+      kk_vector_t nroot = kk_vector_alloc_uninit(2, &buf, ctx);
+      buf[0] = kk_vector_box(rootv, ctx);
+      buf[1] = kk_vector_box(kk_pvec_new_path(shift, leaf, ctx), ctx);
+      rootv = nroot;
+      shift += KK_PVEC_BITS;
+    }
+    else {
+      rootv = kk_pvec_push_leaf(rootv, shift, toff, leaf, ctx);
+    }
+    root = kk_vector_box(rootv, ctx);
+    kk_box_t* tbuf;
+    kk_vector_t ntail = kk_vector_alloc_uninit(1, &tbuf, ctx);
+    tbuf[0] = x;
+    tail = kk_vector_box(ntail, ctx);
+  }
+  if (unique) {
+    pv->root = root; pv->tail = tail; pv->size = size + 1; pv->shift = shift;
+    return p;
+  }
+  kk_pvec_t r = kk_pvec_alloc(root, tail, size + 1, shift, ctx);
+  kk_pvec_drop(p, ctx);
+  return r;
+}
+
+kk_pvec_t kk_pvec_set(kk_pvec_t p, kk_ssize_t i, kk_box_t x, kk_context_t* ctx) {
+  kk_pvec_base_t pv = kk_pvec_as_base_borrow(p);
+  kk_assert(i >= 0 && i < pv->size);
+  const kk_ssize_t toff = kk_pvec_tail_off(pv->size);
+  const bool unique = kk_datatype_is_unique(p);
+  kk_box_t root = (unique ? pv->root : kk_box_dup(pv->root));
+  kk_box_t tail = (unique ? pv->tail : kk_box_dup(pv->tail));
+  if (i >= toff) {
+    kk_vector_t leaf = kk_pvec_node_unique(kk_vector_unbox(tail, NULL), ctx);
+    kk_box_t* buf = kk_vector_buf_borrow(leaf, NULL);
+    kk_box_drop(buf[i - toff], ctx);
+    buf[i - toff] = x;
+    tail = kk_vector_box(leaf, ctx);
+  }
+  else {
+    root = kk_vector_box(kk_pvec_node_set(kk_vector_unbox(root, NULL), pv->shift, i, x, ctx), ctx);
+  }
+  if (unique) {
+    pv->root = root; pv->tail = tail;
+    return p;
+  }
+  kk_pvec_t r = kk_pvec_alloc(root, tail, pv->size, pv->shift, ctx);
+  kk_pvec_drop(p, ctx);
+  return r;
+}
+
+kk_pvec_t kk_pvec_from_vector(kk_vector_t v, kk_context_t* ctx) {
+  kk_ssize_t n;
+  kk_box_t* buf = kk_vector_buf_borrow(v, &n);
+  kk_pvec_t p = kk_pvec_empty(ctx);
+  for (kk_ssize_t i = 0; i < n; i++) {
+    p = kk_pvec_push(p, kk_box_dup(buf[i]), ctx);
+  }
+  kk_vector_drop(v, ctx);
+  return p;
+}
+
+// In-order copy of a subtree into `dest` (borrows the tree, dups the elements).
+static kk_box_t* kk_pvec_collect(kk_vector_t node, kk_ssize_t level, kk_box_t* dest) {
+  kk_ssize_t len;
+  kk_box_t* buf = kk_vector_buf_borrow(node, &len);
+  if (level == 0) {
+    for (kk_ssize_t i = 0; i < len; i++) {
+      *dest++ = kk_box_dup(buf[i]);
+    }
+  }
+  else {
+    for (kk_ssize_t i = 0; i < len; i++) {
+      dest = kk_pvec_collect(kk_vector_unbox(buf[i], NULL), level - KK_PVEC_BITS, dest);
+    }
+  }
+  return dest;
+}
+
+kk_vector_t kk_pvec_to_vector(kk_pvec_t p, kk_context_t* ctx) {
+  kk_pvec_base_t pv = kk_pvec_as_base_borrow(p);
+  kk_box_t* dest;
+  kk_vector_t v = kk_vector_alloc_uninit(pv->size, &dest, ctx);
+  if (pv->size > 0) {
+    const kk_ssize_t toff = kk_pvec_tail_off(pv->size);
+    if (toff > 0) {
+      dest = kk_pvec_collect(kk_vector_unbox(pv->root, NULL), pv->shift, dest);
+    }
+    kk_pvec_collect(kk_vector_unbox(pv->tail, NULL), 0, dest);
+  }
+  kk_pvec_drop(p, ctx);
+  return v;
+}
@@ -0,0 +1,65 @@
+/*---------------------------------------------------------------------------
+  Copyright 2020-2021, Microsoft Research, Daan Leijen.
+
+  This is free software; you can redistribute it and/or modify it under the
+  terms of the Apache License, Version 2.0. A copy of the License can be
+  found in the LICENSE file at the root of this distribution.
+---------------------------------------------------------------------------*/
+#include <string.h>
+#include "bench.h"
+
+/*----------------------------------------------------------------
+  Bytes and the bytes builder (see `bytes.c`)
+----------------------------------------------------------------*/
+
+#define CHUNK_LEN  (64)
+
+static void bench_builder_append(kk_ssize_t iters, kk_context_t* ctx) {
+  uint8_t chunk[CHUNK_LEN];
+  memset(chunk, 'x', CHUNK_LEN);
+  kk_bytes_builder_t bb;
+  kk_bytes_builder_init(&bb);
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_bytes_builder_append_buf(&bb, chunk, CHUNK_LEN, ctx);
+    if ((i & 0x3FF) == 0x3FF) {            // materialize every 1024 appends (64KB)
+      kk_bytes_t b = kk_bytes_builder_done(&bb, ctx);
+      kk_bench_sink += (uint64_t)kk_bytes_len_borrow(b);
+      kk_bytes_drop(b, ctx);
+    }
+  }
+  kk_bytes_builder_clear(&bb, ctx);
+}
+
+static void bench_bytes_cat(kk_ssize_t iters, kk_context_t* ctx) {
+  uint8_t buf[256];
+  memset(buf, 'y', sizeof(buf));
+  uint8_t* p;
+  kk_bytes_t x = kk_bytes_alloc_len(sizeof(buf), sizeof(buf), buf, &p, ctx);
+  kk_bytes_t y = kk_bytes_alloc_len(sizeof(buf), sizeof(buf), buf, &p, ctx);
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_bytes_t r = kk_bytes_cat(kk_bytes_dup(x), kk_bytes_dup(y), ctx);
+    kk_bench_sink += (uint64_t)kk_bytes_len_borrow(r);
+    kk_bytes_drop(r, ctx);
+  }
+  kk_bytes_drop(x, ctx);
+  kk_bytes_drop(y, ctx);
+}
+
+static void bench_bytes_cmp(kk_ssize_t iters, kk_context_t* ctx) {
+  uint8_t buf[4096];
+  memset(buf, 'z', sizeof(buf));
+  uint8_t* p;
+  kk_bytes_t x = kk_bytes_alloc_len(sizeof(buf), sizeof(buf), buf, &p, ctx);
+  kk_bytes_t y = kk_bytes_alloc_len(sizeof(buf), sizeof(buf), buf, &p, ctx);
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_bench_sink += (uint64_t)(kk_bytes_cmp_borrow(x, y) + 1);
+  }
+  kk_bytes_drop(x, ctx);
+  kk_bytes_drop(y, ctx);
+}
+
+void kk_bench_register_bytes(void) {
+  kk_bench_add("bytes-builder-append-64", &bench_builder_append, 1000000);
+  kk_bench_add("bytes-cat-256", &bench_bytes_cat, 1000000);
+  kk_bench_add("bytes-cmp-4k", &bench_bytes_cmp, 1000000);
+}
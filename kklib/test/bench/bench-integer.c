@@ -0,0 +1,69 @@
+/*---------------------------------------------------------------------------
+  Copyright 2020-2021, Microsoft Research, Daan Leijen.
+
+  This is free software; you can redistribute it and/or modify it under the
+  terms of the Apache License, Version 2.0. A copy of the License can be
+  found in the LICENSE file at the root of this distribution.
+---------------------------------------------------------------------------*/
+#include "bench.h"
+
+/*----------------------------------------------------------------
+  Arbitrary precision integers (see `integer.c`)
+----------------------------------------------------------------*/
+
+#define BIG80  "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+#define BIG16  "9876543210987654"
+
+static void bench_small_add(kk_ssize_t iters, kk_context_t* ctx) {
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_integer_t r = kk_integer_add(kk_integer_from_small((kk_intf_t)(i & 0xFFF)), kk_integer_from_small(1234), ctx);
+    kk_bench_sink += (uint64_t)_kk_integer_value(r);
+  }
+}
+
+static void bench_small_mul(kk_ssize_t iters, kk_context_t* ctx) {
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_integer_t r = kk_integer_mul(kk_integer_from_small((kk_intf_t)(i & 0xFFF)), kk_integer_from_small(1234), ctx);
+    kk_bench_sink += (uint64_t)_kk_integer_value(r);
+  }
+}
+
+static void bench_big_add(kk_ssize_t iters, kk_context_t* ctx) {
+  kk_integer_t x = kk_integer_from_str(BIG80, ctx);
+  kk_integer_t y = kk_integer_from_str(BIG80, ctx);
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_integer_t r = kk_integer_add(kk_integer_dup(x), kk_integer_dup(y), ctx);
+    kk_bench_sink += (uint64_t)_kk_integer_value(r);
+    kk_integer_drop(r, ctx);
+  }
+  kk_integer_drop(x, ctx);
+  kk_integer_drop(y, ctx);
+}
+
+static void bench_big_mul(kk_ssize_t iters, kk_context_t* ctx) {
+  kk_integer_t x = kk_integer_from_str(BIG80, ctx);
+  kk_integer_t y = kk_integer_from_str(BIG16, ctx);
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_integer_t r = kk_integer_mul(kk_integer_dup(x), kk_integer_dup(y), ctx);
+    kk_bench_sink += (uint64_t)_kk_integer_value(r);
+    kk_integer_drop(r, ctx);
+  }
+  kk_integer_drop(x, ctx);
+  kk_integer_drop(y, ctx);
+}
+
+static void bench_parse(kk_ssize_t iters, kk_context_t* ctx) {
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_integer_t r = kk_integer_from_str(BIG80, ctx);
+    kk_bench_sink += (uint64_t)_kk_integer_value(r);
+    kk_integer_drop(r, ctx);
+  }
+}
+
+void kk_bench_register_integer(void) {
+  kk_bench_add("integer-small-add", &bench_small_add, 10000000);
+  kk_bench_add("integer-small-mul", &bench_small_mul, 10000000);
+  kk_bench_add("integer-big-add-80", &bench_big_add, 1000000);
+  kk_bench_add("integer-big-mul-80x16", &bench_big_mul, 1000000);
+  kk_bench_add("integer-parse-80", &bench_parse, 1000000);
+}
@@ -0,0 +1,88 @@
+/*---------------------------------------------------------------------------
+  Copyright 2020-2021, Microsoft Research, Daan Leijen.
+
+  This is free software; you can redistribute it and/or modify it under the
+  terms of the Apache License, Version 2.0. A copy of the License can be
+  found in the LICENSE file at the root of this distribution.
+---------------------------------------------------------------------------*/
+#include "bench.h"
+
+/*----------------------------------------------------------------
+  Block allocation and dup/drop throughput (see `refcount.c`)
+----------------------------------------------------------------*/
+
+#define TAG_PAIR  ((kk_tag_t)100)
+
+typedef struct pair_s {
+  kk_block_t _block;
+  kk_box_t fst;
+  kk_box_t snd;
+} *pair_t;
+
+static kk_block_t* pair_alloc(kk_box_t fst, kk_box_t snd, kk_context_t* ctx) {
+  pair_t p = (pair_t)kk_block_alloc(kk_ssizeof(struct pair_s), 2, TAG_PAIR, ctx);
+  p->fst = fst;
+  p->snd = snd;
+  return &p->_block;
+}
+
+static void bench_alloc_free(kk_ssize_t iters, kk_context_t* ctx) {
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_block_t* b = pair_alloc(kk_intf_box(i), kk_intf_box(i + 1), ctx);
+    kk_bench_sink += (uint64_t)(uintptr_t)b;
+    kk_block_drop(b, ctx);
+  }
+}
+
+static void bench_dup_drop(kk_ssize_t iters, kk_context_t* ctx) {
+  kk_block_t* b = pair_alloc(kk_intf_box(1), kk_intf_box(2), ctx);
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_block_dup(b);
+    kk_block_drop(b, ctx);
+  }
+  kk_bench_sink += (uint64_t)kk_block_refcount(b);
+  kk_block_drop(b, ctx);
+}
+
+static void bench_shared_dup_drop(kk_ssize_t iters, kk_context_t* ctx) {
+  kk_block_t* b = pair_alloc(kk_intf_box(1), kk_intf_box(2), ctx);
+  kk_block_mark_shared(b, ctx);  // dup/drop take the atomic (biased) path
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_block_dup(b);
+    kk_block_drop(b, ctx);
+  }
+  kk_block_drop(b, ctx);
+  kk_rc_bias_flush(ctx);
+}
+
+#define LIST_LEN (1000)
+
+static void bench_list_build_drop(kk_ssize_t iters, kk_context_t* ctx) {
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_box_t xs = kk_intf_box(0);
+    for (kk_ssize_t j = 0; j < LIST_LEN; j++) {  // cons cells as pairs
+      xs = kk_ptr_box(pair_alloc(kk_intf_box(j), xs, ctx));
+    }
+    kk_box_drop(xs, ctx);  // cascaded drop of the whole list
+  }
+}
+
+static void bench_arena_list_build_drop(kk_ssize_t iters, kk_context_t* ctx) {
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_arena_begin(ctx);
+    kk_box_t xs = kk_intf_box(0);
+    for (kk_ssize_t j = 0; j < LIST_LEN; j++) {
+      xs = kk_ptr_box(pair_alloc(kk_intf_box(j), xs, ctx));
+    }
+    kk_box_drop(xs, ctx);
+    kk_arena_end(ctx);
+  }
+}
+
+void kk_bench_register_refcount(void) {
+  kk_bench_add("block-alloc-free", &bench_alloc_free, 1000000);
+  kk_bench_add("block-dup-drop", &bench_dup_drop, 10000000);
+  kk_bench_add("block-dup-drop-shared", &bench_shared_dup_drop, 10000000);
+  kk_bench_add("list-build-drop-1000", &bench_list_build_drop, 1000);
+  kk_bench_add("list-build-drop-arena-1000", &bench_arena_list_build_drop, 1000);
+}
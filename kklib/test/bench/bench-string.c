@@ -0,0 +1,91 @@
+/*---------------------------------------------------------------------------
+  Copyright 2020-2021, Microsoft Research, Daan Leijen.
+
+  This is free software; you can redistribute it and/or modify it under the
+  terms of the Apache License, Version 2.0. A copy of the License can be
+  found in the LICENSE file at the root of this distribution.
+---------------------------------------------------------------------------*/
+#include <string.h>
+#include "bench.h"
+
+/*----------------------------------------------------------------
+  Strings and UTF-8 validation (see `string.c`)
+----------------------------------------------------------------*/
+
+#define BUF_LEN  (4096)
+
+// mostly ascii with some multi-byte sequences mixed in
+static uint8_t* make_utf8_buf(kk_context_t* ctx) {
+  uint8_t* buf = (uint8_t*)kk_malloc(BUF_LEN + 1, ctx);
+  for (kk_ssize_t i = 0; i < BUF_LEN; ) {
+    if (i % 97 == 0 && i + 2 < BUF_LEN) {
+      buf[i++] = 0xC3; buf[i++] = 0xA9;  // e-acute
+    }
+    else {
+      buf[i] = (uint8_t)('a' + (i % 26));
+      i++;
+    }
+  }
+  buf[BUF_LEN] = 0;
+  return buf;
+}
+
+static void bench_utf8_validate(kk_ssize_t iters, kk_context_t* ctx) {
+  uint8_t* buf = make_utf8_buf(ctx);
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_bench_sink += (kk_utf8_is_validn(BUF_LEN, buf) ? 1 : 0);
+  }
+  kk_free(buf, ctx);
+}
+
+static void bench_string_alloc(kk_ssize_t iters, kk_context_t* ctx) {
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_string_t s = kk_string_alloc_dup_valid_utf8("hello benchmark world", ctx);
+    kk_bench_sink += (uint64_t)kk_string_len_borrow(s);
+    kk_string_drop(s, ctx);
+  }
+}
+
+static void bench_string_cat(kk_ssize_t iters, kk_context_t* ctx) {
+  kk_string_t x = kk_string_alloc_dup_valid_utf8("the quick brown fox ", ctx);
+  kk_string_t y = kk_string_alloc_dup_valid_utf8("jumps over the lazy dog", ctx);
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_string_t r = kk_string_cat(kk_string_dup(x), kk_string_dup(y), ctx);
+    kk_bench_sink += (uint64_t)kk_string_len_borrow(r);
+    kk_string_drop(r, ctx);
+  }
+  kk_string_drop(x, ctx);
+  kk_string_drop(y, ctx);
+}
+
+static void bench_string_cmp(kk_ssize_t iters, kk_context_t* ctx) {
+  uint8_t* buf = make_utf8_buf(ctx);
+  kk_string_t x = kk_string_alloc_dup_valid_utf8((const char*)buf, ctx);
+  kk_string_t y = kk_string_alloc_dup_valid_utf8((const char*)buf, ctx);
+  kk_free(buf, ctx);
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_bench_sink += (uint64_t)(kk_string_cmp_borrow(x, y) + 1);
+  }
+  kk_string_drop(x, ctx);
+  kk_string_drop(y, ctx);
+}
+
+static void bench_string_count_pattern(kk_ssize_t iters, kk_context_t* ctx) {
+  uint8_t* buf = make_utf8_buf(ctx);
+  kk_string_t s = kk_string_alloc_dup_valid_utf8((const char*)buf, ctx);
+  kk_string_t pat = kk_string_alloc_dup_valid_utf8("mnop", ctx);
+  kk_free(buf, ctx);
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_bench_sink += (uint64_t)kk_string_count_pattern_borrow(s, pat);
+  }
+  kk_string_drop(s, ctx);
+  kk_string_drop(pat, ctx);
+}
+
+void kk_bench_register_string(void) {
+  kk_bench_add("utf8-validate-4k", &bench_utf8_validate, 100000);
+  kk_bench_add("string-alloc-drop", &bench_string_alloc, 1000000);
+  kk_bench_add("string-cat", &bench_string_cat, 1000000);
+  kk_bench_add("string-cmp-4k", &bench_string_cmp, 1000000);
+  kk_bench_add("string-count-pattern-4k", &bench_string_count_pattern, 100000);
+}
@@ -0,0 +1,70 @@
+/*---------------------------------------------------------------------------
+  Copyright 2020-2021, Microsoft Research, Daan Leijen.
+
+  This is free software; you can redistribute it and/or modify it under the
+  terms of the Apache License, Version 2.0. A copy of the License can be
+  found in the LICENSE file at the root of this distribution.
+---------------------------------------------------------------------------*/
+#include "bench.h"
+#include "kklib/thread.h"
+
+/*----------------------------------------------------------------
+  Task scheduling and promises (see `thread.c`)
+----------------------------------------------------------------*/
+
+static kk_box_t bench_task_fun(kk_function_t self, kk_context_t* ctx) {
+  kk_function_drop(self, ctx);
+  return kk_intf_box(42);
+}
+
+#define TASK_BATCH  (256)
+
+static void bench_task_schedule(kk_ssize_t iters, kk_context_t* ctx) {
+  kk_promise_t prs[TASK_BATCH];
+  for (kk_ssize_t i = 0; i < iters; i += TASK_BATCH) {
+    kk_define_static_function(fun, bench_task_fun, ctx);
+    for (kk_ssize_t j = 0; j < TASK_BATCH; j++) {
+      prs[j] = kk_task_schedule(kk_function_dup(fun), ctx);
+    }
+    for (kk_ssize_t j = 0; j < TASK_BATCH; j++) {
+      kk_box_t r = kk_promise_get(prs[j], ctx);
+      kk_bench_sink += (uint64_t)kk_intf_unbox(r);
+      kk_box_drop(r, ctx);
+    }
+  }
+}
+
+static void bench_promise_roundtrip(kk_ssize_t iters, kk_context_t* ctx) {
+  for (kk_ssize_t i = 0; i < iters; i++) {
+    kk_promise_t pr = kk_promise_alloc(ctx);
+    kk_promise_set(kk_box_dup(pr), kk_intf_box(i), ctx);
+    kk_box_t r = kk_promise_get(pr, ctx);
+    kk_bench_sink += (uint64_t)kk_intf_unbox(r);
+    kk_box_drop(r, ctx);
+  }
+}
+
+#define CHAN_BATCH  (256)
+
+static void bench_chan_roundtrip(kk_ssize_t iters, kk_context_t* ctx) {
+  kk_chan_t ch = kk_chan_alloc(CHAN_BATCH, ctx);
+  for (kk_ssize_t i = 0; i < iters; i += CHAN_BATCH) {
+    for (kk_ssize_t j = 0; j < CHAN_BATCH; j++) {
+      kk_chan_send(kk_box_dup(ch), kk_intf_box(j), ctx);
+    }
+    for (kk_ssize_t j = 0; j < CHAN_BATCH; j++) {
+      kk_box_t r;
+      if (kk_chan_recv(kk_box_dup(ch), &r, ctx)) {
+        kk_bench_sink += (uint64_t)kk_intf_unbox(r);
+        kk_box_drop(r, ctx);
+      }
+    }
+  }
+  kk_box_drop(ch, ctx);
+}
+
+void kk_bench_register_thread(void) {
+  kk_bench_add("task-schedule-trivial", &bench_task_schedule, 16384);
+  kk_bench_add("promise-set-get", &bench_promise_roundtrip, 100000);
+  kk_bench_add("chan-send-recv-256", &bench_chan_roundtrip, 1000000);
+}
@@ -0,0 +1,142 @@
+/*---------------------------------------------------------------------------
+  Copyright 2020-2021, Microsoft Research, Daan Leijen.
+
+  This is free software; you can redistribute it and/or modify it under the
+  terms of the Apache License, Version 2.0. A copy of the License can be
+  found in the LICENSE file at the root of this distribution.
+---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/*----------------------------------------------------------------
+  Timers: monotonic nanoseconds and a raw cycle counter
+----------------------------------------------------------------*/
+
+#if defined(_WIN32)
+#include <windows.h>
+static int64_t bench_nsecs(void) {
+  static LARGE_INTEGER freq;  // = 0
+  LARGE_INTEGER t;
+  if (freq.QuadPart == 0) { QueryPerformanceFrequency(&freq); }
+  QueryPerformanceCounter(&t);
+  return (int64_t)((double)t.QuadPart * 1e9 / (double)freq.QuadPart);
+}
+#else
+#include <time.h>
+static int64_t bench_nsecs(void) {
+  struct timespec t;
+#if defined(CLOCK_MONOTONIC)
+  clock_gettime(CLOCK_MONOTONIC, &t);
+#else
+  clock_gettime(CLOCK_REALTIME, &t);
+#endif
+  return ((int64_t)t.tv_sec * 1000000000) + (int64_t)t.tv_nsec;
+}
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+static uint64_t bench_cycles(void) {
+  return __rdtsc();
+}
+#elif defined(__aarch64__)
+static uint64_t bench_cycles(void) {
+  uint64_t t;
+  __asm__ volatile("mrs %0, cntvct_el0" : "=r"(t));
+  return t;
+}
+#else
+static uint64_t bench_cycles(void) {
+  return 0;  // unsupported: the cycle column reads 0
+}
+#endif
+
+/*----------------------------------------------------------------
+  Registry and runner
+----------------------------------------------------------------*/
+
+#define BENCH_MAX      (64)
+#define BENCH_WARMUP   (3)
+#define BENCH_SAMPLES  (15)
+
+typedef struct bench_s {
+  const char*     name;
+  kk_bench_fun_t* fun;
+  kk_ssize_t      iters;
+} bench_t;
+
+static bench_t benches[BENCH_MAX];
+static int     bench_count;
+
+volatile uint64_t kk_bench_sink;
+
+void kk_bench_add(const char* name, kk_bench_fun_t* fun, kk_ssize_t iters) {
+  if (bench_count >= BENCH_MAX) {
+    fprintf(stderr, "too many benchmarks registered (max %d)\n", BENCH_MAX);
+    exit(1);
+  }
+  bench_t* b = &benches[bench_count++];
+  b->name = name;
+  b->fun = fun;
+  b->iters = iters;
+}
+
+static int cmp_int64(const void* p, const void* q) {
+  const int64_t x = *(const int64_t*)p;
+  const int64_t y = *(const int64_t*)q;
+  return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+static void bench_run(const bench_t* b, kk_context_t* ctx) {
+  int64_t  ns[BENCH_SAMPLES];
+  int64_t  cy[BENCH_SAMPLES];
+  for (int s = -BENCH_WARMUP; s < BENCH_SAMPLES; s++) {
+    const int64_t  t0 = bench_nsecs();
+    const uint64_t c0 = bench_cycles();
+    b->fun(b->iters, ctx);
+    const uint64_t c1 = bench_cycles();
+    const int64_t  t1 = bench_nsecs();
+    if (s >= 0) {                      // discard warmup samples
+      ns[s] = t1 - t0;
+      cy[s] = (int64_t)(c1 - c0);
+    }
+  }
+  qsort(ns, BENCH_SAMPLES, sizeof(int64_t), &cmp_int64);
+  qsort(cy, BENCH_SAMPLES, sizeof(int64_t), &cmp_int64);
+  const double iters = (double)b->iters;
+  printf("%-28s %10ld %12.2f %12.2f %12.1f\n", b->name, (long)b->iters,
+         (double)ns[0] / iters,                   // min ns/op
+         (double)ns[BENCH_SAMPLES/2] / iters,     // median ns/op
+         (double)cy[BENCH_SAMPLES/2] / iters);    // median cycles/op
+}
+
+int main(int argc, char** argv) {
+  kk_context_t* ctx = kk_main_start(argc, argv);
+  const char* filter = (ctx->argc > 1 ? ctx->argv[1] : NULL);
+
+  kk_bench_register_refcount();
+  kk_bench_register_integer();
+  kk_bench_register_string();
+  kk_bench_register_bytes();
+  kk_bench_register_thread();
+
+  printf("%-28s %10s %12s %12s %12s\n", "benchmark", "iters", "min ns/op", "med ns/op", "med cyc/op");
+  int ran = 0;
+  for (int i = 0; i < bench_count; i++) {
+    if (filter != NULL && strstr(benches[i].name, filter) == NULL) continue;
+    bench_run(&benches[i], ctx);
+    ran++;
+  }
+  if (ran == 0) {
+    fprintf(stderr, "no benchmark matches '%s'\n", (filter == NULL ? "" : filter));
+    return 1;
+  }
+  kk_main_end(ctx);
+  return 0;
+}
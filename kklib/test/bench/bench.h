@@ -0,0 +1,33 @@
+#pragma once
+/*---------------------------------------------------------------------------
+  Copyright 2020-2021, Microsoft Research, Daan Leijen.
+
+  This is free software; you can redistribute it and/or modify it under the
+  terms of the Apache License, Version 2.0. A copy of the License can be
+  found in the LICENSE file at the root of this distribution.
+---------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "kklib.h"
+
+/*----------------------------------------------------------------
+  Micro benchmark harness (see `bench.c`).
+
+  A benchmark is a function running `iters` iterations of one
+  operation; the harness times it over several samples (after
+  warmup) and reports the minimum and median nanoseconds and
+  cycles per operation. Results are assigned to `kk_bench_sink`
+  (volatile) so the measured operations cannot be optimized away.
+----------------------------------------------------------------*/
+
+typedef void (kk_bench_fun_t)(kk_ssize_t iters, kk_context_t* ctx);
+
+void kk_bench_add(const char* name, kk_bench_fun_t* fun, kk_ssize_t iters);
+
+extern volatile uint64_t kk_bench_sink;
+
+// per subsystem registration (see the `bench-*.c` files)
+void kk_bench_register_refcount(void);
+void kk_bench_register_integer(void);
+void kk_bench_register_string(void);
+void kk_bench_register_bytes(void);
+void kk_bench_register_thread(void);
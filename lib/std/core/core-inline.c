@@ -18,8 +18,16 @@ kk_std_core__list kk_vector_to_list(kk_vector_t v, kk_std_core__list tail, kk_co
   kk_std_core__list nil  = kk_std_core__new_Nil(ctx);
   struct kk_std_core_Cons* cons = NULL;
   kk_std_core__list list = kk_std_core__new_Nil(ctx);
+  kk_reuse_t cells[64];          // batch the cons cell allocations (see `kk_block_alloc_n`)
+  kk_ssize_t filled = 0;
+  kk_ssize_t used = 0;
   for( kk_ssize_t i = 0; i < n; i++ ) {
-    kk_std_core__list hd = kk_std_core__new_Cons(kk_reuse_null,kk_box_dup(p[i]), nil, ctx);
+    if (used == filled) {
+      filled = (n - i < 64 ? n - i : 64);
+      kk_block_alloc_n(cells, filled, kk_ssizeof(struct kk_std_core_Cons), ctx);
+      used = 0;
+    }
+    kk_std_core__list hd = kk_std_core__new_Cons(cells[used++],kk_box_dup(p[i]), nil, ctx);
     if (cons==NULL) {
       list = hd;
     }
@@ -80,11 +88,19 @@ kk_std_core__list kk_string_to_list(kk_string_t s, kk_context_t* ctx) {
   kk_std_core__list nil  = kk_std_core__new_Nil(ctx);
   kk_std_core__list list = nil;
   struct kk_std_core_Cons* tl = NULL;
+  kk_reuse_t cells[64];          // batch the cons cell allocations (see `kk_block_alloc_n`);
+  kk_ssize_t filled = 0;         // the char count is not known up front so unused tokens are returned
+  kk_ssize_t used = 0;
   kk_ssize_t count;
   while( p < end ) {
+    if (used == filled) {
+      filled = (end - p < 64 ? end - p : 64);  // every char takes at least one byte
+      kk_block_alloc_n(cells, filled, kk_ssizeof(struct kk_std_core_Cons), ctx);
+      used = 0;
+    }
     kk_char_t c = kk_utf8_read(p,&count);
     p += count;
-    kk_std_core__list cons = kk_std_core__new_Cons(kk_reuse_null,kk_char_box(c,ctx), nil, ctx);
+    kk_std_core__list cons = kk_std_core__new_Cons(cells[used++],kk_char_box(c,ctx), nil, ctx);
     if (tl!=NULL) {
       tl->tail = cons;
     }
@@ -93,6 +109,9 @@ kk_std_core__list kk_string_to_list(kk_string_t s, kk_context_t* ctx) {
     }
     tl = kk_std_core__as_Cons(cons);
   }
+  while (used < filled) {
+    kk_reuse_drop(cells[used++], ctx);
+  }
   kk_string_drop(s,ctx);
   return list;
 }
@@ -139,7 +158,11 @@ static inline void kk_sslice_start_end_borrow( kk_std_core__sslice sslice, const
 }
 
 kk_integer_t kk_slice_count( kk_std_core__sslice sslice, kk_context_t* ctx ) {
-  // TODO: optimize this by extending kk_string_count
+  if (kk_string_is_ascii_borrow(sslice.str)) {  // every char is one byte
+    kk_ssize_t count = sslice.len;
+    kk_std_core__sslice_drop(sslice,ctx);
+    return kk_integer_from_ssize_t(count,ctx);
+  }
   const uint8_t* start;
   const uint8_t* end;
   kk_sslice_start_end_borrow(sslice, &start, &end);
@@ -222,6 +245,13 @@ struct kk_std_core_Sslice kk_slice_extend_borrow( struct kk_std_core_Sslice slic
   const uint8_t* s0;
   const uint8_t* s1;
   kk_sslice_start_end_borrow(slice,&s0,&s1);
+  if (kk_string_is_ascii_borrow(slice.str)) {  // every char is one byte: extend by byte offset
+    const kk_ssize_t slen = kk_string_len_borrow(slice.str);
+    const kk_ssize_t end0 = slice.start + slice.len;
+    const kk_ssize_t end1 = (cnt > slen - end0 ? slen : (cnt < -end0 ? 0 : end0 + cnt));
+    if (end1 == end0) return slice;
+    return kk_std_core__new_Sslice(slice.str, slice.start, (end1 < slice.start ? 0 : end1 - slice.start), ctx);
+  }
   const uint8_t* t  = s1;
   if (cnt >= 0) {
     do {
@@ -250,6 +280,15 @@ struct kk_std_core_Sslice kk_slice_advance_borrow( struct kk_std_core_Sslice sli
   const uint8_t* s1;
   const uint8_t* send;
   kk_sslice_start_end_borrowx(slice,&s0,&s1,&sstart,&send);
+  if (kk_string_is_ascii_borrow(slice.str)) {  // every char is one byte: advance by byte offset
+    const kk_ssize_t slen   = (send - sstart);
+    const kk_ssize_t start1 = (cnt > slen - slice.start ? slen : (cnt < -slice.start ? 0 : slice.start + cnt));
+    if (start1 == slice.start) return slice;
+    const kk_ssize_t end0 = slice.start + slice.len;
+    kk_ssize_t end1 = (cnt > slen - end0 ? slen : (cnt < -end0 ? 0 : end0 + cnt));
+    if (end1 < start1) end1 = start1;
+    return kk_std_core__new_Sslice(slice.str, start1, end1 - start1, ctx);
+  }
   // advance the start
   const uint8_t* t0  = s0;
   if (cnt >= 0) {
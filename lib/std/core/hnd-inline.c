@@ -61,14 +61,41 @@ kk_std_core_hnd__ev kk_ev_none(kk_context_t* ctx) {
 }
 
 
+// Effect operations resolve their handler by scanning the evidence vector for
+// their tag; handler-heavy code repeats the same lookups under a stable vector
+// so we keep a small direct-mapped cache in the context, keyed on the
+// (evidence vector, tag name) pointer pair. Since the key includes the vector
+// itself there is no explicit invalidation: `kk_evv_insert`/`kk_evv_delete`
+// allocate a fresh vector and the stale entries simply miss.
+static inline kk_evv_cache_t* kk_evv_cache_at( uintptr_t tag, kk_context_t* ctx ) {
+  return &ctx->evv_cache[(tag >> 4) & (KK_EVV_CACHE_SIZE-1)];
+}
+
 kk_ssize_t kk_evv_index( struct kk_std_core_hnd_Htag htag, kk_context_t* ctx ) {
   // todo: drop htag?
   kk_ssize_t len;
   kk_std_core_hnd__ev single;
   kk_std_core_hnd__ev* vec = kk_evv_as_vec(ctx->evv,&len,&single);
+  const uintptr_t tag = htag.tagname.bytes.dbox;
+  kk_evv_cache_t* cache = kk_evv_cache_at(tag,ctx);
+  if (cache->evv == (uintptr_t)ctx->evv && cache->tag == tag) {
+    // a cached vector address may have been reused so verify the entry still
+    // resolves this tag; tag names are unique literals so comparing pointers suffices
+    const kk_ssize_t i = cache->index;
+    if (i < len && kk_std_core_hnd__as_Ev(vec[i])->htag.tagname.bytes.dbox == tag &&
+        (i == 0 || kk_std_core_hnd__as_Ev(vec[i-1])->htag.tagname.bytes.dbox != tag)) {
+      return i;
+    }
+  }
   for(kk_ssize_t i = 0; i < len; i++) {
     struct kk_std_core_hnd_Ev* ev = kk_std_core_hnd__as_Ev(vec[i]);
-    if (kk_string_cmp_borrow(htag.tagname,ev->htag.tagname) <= 0) return i; // break on insertion point
+    const int cmp = kk_string_cmp_borrow(htag.tagname,ev->htag.tagname);
+    if (cmp <= 0) { // break on insertion point
+      if (cmp == 0) { // only cache exact matches
+        cache->evv = (uintptr_t)ctx->evv; cache->tag = tag; cache->index = i;
+      }
+      return i;
+    }
   }
   //string_t evvs = kk_evv_show(dup_datatype_as(kk_evv_t,ctx->evv),ctx);
   //fatal_error(EFAULT,"cannot find tag '%s' in: %s", string_cbuf_borrow(htag.htag), string_cbuf_borrow(evvs));
@@ -122,6 +149,7 @@ static void kk_evv_update_cfc_borrow(kk_evv_t evv, int32_t cfc, kk_context_t* ct
 }
 
 kk_evv_t kk_evv_insert(kk_evv_t evvd, kk_std_core_hnd__ev evd, kk_context_t* ctx) {
+  kk_stat_inc(ctx, evv_inserts);
   struct kk_std_core_hnd_Ev* ev = kk_std_core_hnd__as_Ev(evd);
   // update ev with parent evidence vector (either at init, or due to non-scoped resumptions)
   int32_t marker = ev->marker.m;
@@ -348,6 +376,7 @@ kk_function_t kk_yield_to( struct kk_std_core_hnd_Marker m, kk_function_t clause
   kk_yield_t* yield = &ctx->yield;
   kk_assert_internal(!kk_yielding(ctx)); // already yielding
   ctx->yielding = KK_YIELD_NORMAL;
+  kk_profile_yield_begin(ctx);           // samples during the yield attribute to the current function
   yield->marker = m.m;
   yield->clause = clause;
   yield->conts_count = 0;
@@ -387,6 +416,7 @@ struct kk_std_core_hnd_yld_s kk_yield_prompt( struct kk_std_core_hnd_Marker m, k
     kk_function_t cont = (ctx->yielding == KK_YIELD_FINAL ? fun_fatal_resume_final(ctx) : new_kcompose(yield->conts, yield->conts_count, ctx));
     kk_function_t clause = yield->clause;
     ctx->yielding = KK_YIELD_NONE;
+    kk_profile_yield_end(ctx);
     #ifndef NDEBUG
     kk_memset(yield,0,kk_ssizeof(kk_yield_t));
     #endif
@@ -428,6 +458,7 @@ kk_std_core_hnd__yield_info kk_yield_capture(kk_context_t* ctx) {
   yld->marker = ctx->yield.marker;
   yld->yielding = ctx->yielding;
   ctx->yielding = 0;
+  kk_profile_yield_end(ctx);
   ctx->yield.conts_count = 0;
   return kk_datatype_from_base(&yld->_base);
 }
@@ -439,6 +470,7 @@ kk_box_t kk_yield_reyield( kk_std_core_hnd__yield_info yldinfo, kk_context_t* ct
   ctx->yield.marker = yld->marker;
   ctx->yield.conts_count = yld->conts_count;
   ctx->yielding = yld->yielding;
+  kk_profile_yield_begin(ctx);
   for(kk_ssize_t i = 0; i < yld->conts_count; i++) {
     ctx->yield.conts[i] = kk_function_dup(yld->conts[i]);
   }
@@ -26,3 +26,19 @@ static kk_std_core__error kk_os_list_directory_prim( kk_string_t dir, kk_context
   if (err != 0) return kk_error_from_errno(err,ctx);
            else return kk_error_ok(kk_vector_box(contents,ctx),ctx);
 }
+
+static kk_std_core__error kk_os_diriter_open_error( kk_string_t dir, kk_context_t* ctx ) {
+  kk_box_t iter;
+  const int err = kk_os_diriter_open(dir,&iter,ctx);
+  if (err != 0) return kk_error_from_errno(err,ctx);
+           else return kk_error_ok(iter,ctx);
+}
+
+static kk_std_core__error kk_os_diriter_next_error( kk_box_t iter, kk_context_t* ctx ) {
+  kk_string_t name;
+  int kind;
+  const int err = kk_os_diriter_next(iter,&name,&kind,ctx);
+  if (err != 0) return kk_error_from_errno(err,ctx);
+  kk_std_core_types__tuple2_ res = kk_std_core_types__new_dash__lp__comma__rp_( kk_string_box(name), kk_integer_box(kk_integer_from_small(kind)), ctx );
+  return kk_error_ok( kk_std_core_types__tuple2__box(res,ctx), ctx );
+}
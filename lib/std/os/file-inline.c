@@ -18,3 +18,48 @@ static kk_std_core__error kk_os_write_text_file_error( kk_string_t path, kk_stri
   if (err != 0) return kk_error_from_errno(err,ctx);
            else return kk_error_ok(kk_unit_box(kk_Unit),ctx);
 }
+
+static kk_std_core__error kk_os_await_file_error( kk_box_t pr, kk_context_t* ctx ) {
+  kk_box_t result;
+  const int err = kk_os_aio_await(pr,&result,ctx);
+  if (err != 0) return kk_error_from_errno(err,ctx);
+           else return kk_error_ok(result,ctx);
+}
+
+static kk_std_core__error kk_os_freader_open_error( kk_string_t path, kk_ssize_t chunk_size, kk_context_t* ctx ) {
+  kk_box_t reader;
+  const int err = kk_os_freader_open(path,chunk_size,&reader,ctx);
+  if (err != 0) return kk_error_from_errno(err,ctx);
+           else return kk_error_ok(reader,ctx);
+}
+
+static kk_std_core__error kk_os_freader_next_error( kk_box_t reader, kk_context_t* ctx ) {
+  kk_bytes_t chunk;
+  const int err = kk_os_freader_next(reader,&chunk,ctx);
+  if (err != 0) return kk_error_from_errno(err,ctx);
+           else return kk_error_ok(kk_string_box(kk_string_convert_from_qutf8(chunk,ctx)),ctx);
+}
+
+static kk_std_core__error kk_os_lreader_open_error( kk_string_t path, kk_ssize_t buf_size, kk_context_t* ctx ) {
+  kk_box_t reader;
+  const int err = kk_os_lreader_open(path,buf_size,&reader,ctx);
+  if (err != 0) return kk_error_from_errno(err,ctx);
+           else return kk_error_ok(reader,ctx);
+}
+
+static kk_std_core__error kk_os_lreader_read_line_error( kk_box_t reader, kk_context_t* ctx ) {
+  kk_string_t line;
+  bool has_line;
+  const int err = kk_os_lreader_read_line(reader,&line,&has_line,ctx);
+  if (err != 0) return kk_error_from_errno(err,ctx);
+  const kk_std_core_types__maybe m = (has_line ? kk_std_core_types__new_Just(kk_string_box(line),ctx)
+                                               : kk_std_core_types__new_Nothing(ctx));
+  return kk_error_ok(kk_std_core_types__maybe_box(m,ctx),ctx);
+}
+
+static kk_std_core__error kk_os_lreader_read_lines_error( kk_box_t reader, kk_ssize_t max_lines, kk_context_t* ctx ) {
+  kk_vector_t lines;
+  const int err = kk_os_lreader_read_lines(reader,max_lines,&lines,ctx);
+  if (err != 0) return kk_error_from_errno(err,ctx);
+           else return kk_error_ok(kk_vector_box(lines,ctx),ctx);
+}
@@ -17,3 +17,10 @@ static kk_integer_t kk_os_run_system_prim( kk_string_t cmd, kk_context_t* ctx )
   const int exitcode = kk_os_run_system(cmd,ctx);
   return kk_integer_from_int(exitcode,ctx);
 }
+
+static kk_std_core__error kk_os_await_command_error( kk_box_t pr, kk_context_t* ctx ) {
+  kk_box_t result;
+  const int err = kk_os_aio_await(pr,&result,ctx);
+  if (err != 0) { kk_box_drop(result,ctx); return kk_error_from_errno(err,ctx); }
+              else return kk_error_ok(result,ctx);
+}
@@ -0,0 +1,16 @@
+/*---------------------------------------------------------------------------
+  Copyright 2021-2021, Microsoft Research, Daan Leijen.
+
+  This is free software; you can redistribute it and/or modify it under the
+  terms of the Apache License, Version 2.0. A copy of the License can be
+  found in the LICENSE file at the root of this distribution.
+---------------------------------------------------------------------------*/
+#include "kklib/thread.h"
+
+static kk_std_core_types__maybe kk_chan_recv_maybe( kk_box_t ch, kk_context_t* ctx ) {
+  kk_box_t result;
+  if (kk_chan_recv(ch, &result, ctx)) {
+    return kk_std_core_types__new_Just(result, ctx);
+  }
+  return kk_std_core_types__new_Nothing(ctx);
+}
@@ -29,6 +29,9 @@ static void kk_pcre2_free( void* p, void* data ) {
   kk_free(p,kk_get_context());
 }
 
+static void kk_match_data_cache_done(void);
+static void kk_regex_cache_done(kk_context_t* ctx);
+
 static void kk_regex_custom_init( kk_context_t* ctx ) {
   gen_ctx = pcre2_general_context_create( &kk_pcre2_malloc, &kk_pcre2_free, NULL );
   if (gen_ctx != NULL) {
@@ -42,6 +45,8 @@ static void kk_regex_custom_init( kk_context_t* ctx ) {
 }
 
 static void kk_regex_custom_done( kk_context_t* ctx ) {
+  kk_match_data_cache_done();
+  kk_regex_cache_done(ctx);
   if (cmp_ctx != NULL) {
     pcre2_compile_context_free(cmp_ctx);
     cmp_ctx = NULL;
@@ -59,45 +64,188 @@ static void kk_regex_custom_done( kk_context_t* ctx ) {
 
 /* -----------------------------------------------------------------------
   Compile
+  Compiled patterns are refcounted so many regex values (and the pattern
+  cache below) can share a single `pcre2_code`.
 ------------------------------------------------------------------------*/
 
-static void kk_regex_free( void* pre, kk_block_t* b, kk_context_t* ctx ) {
-  kk_unused(ctx);
-  pcre2_code* re = (pcre2_code*)pre;
-  //kk_info_message( "free regex at %p\n", re );
-  if (re != NULL) pcre2_code_free(re);
+typedef struct kk_regex_entry_s {
+  pcre2_code*       re;
+  _Atomic(intptr_t) refcount;   // held by the cache and by every regex value; may drop on any thread
+} kk_regex_entry_t;
+
+static kk_regex_entry_t* kk_regex_entry_alloc( pcre2_code* re, intptr_t rc, kk_context_t* ctx ) {
+  kk_regex_entry_t* entry = (kk_regex_entry_t*)kk_malloc( kk_ssizeof(kk_regex_entry_t), ctx );
+  entry->re = re;
+  kk_atomic_store_relaxed(&entry->refcount, rc);
+  return entry;
+}
+
+static void kk_regex_entry_release( kk_regex_entry_t* entry, kk_context_t* ctx ) {
+  if (entry == NULL) return;
+  if (kk_atomic_dec_release(&entry->refcount) == 1) {
+    kk_atomic_fence_acquire();
+    if (entry->re != NULL) pcre2_code_free(entry->re);
+    kk_free(entry,ctx);
+  }
+}
+
+static void kk_regex_free( void* pentry, kk_block_t* b, kk_context_t* ctx ) {
+  kk_unused(b);
+  //kk_info_message( "free regex entry at %p\n", pentry );
+  kk_regex_entry_release( (kk_regex_entry_t*)pentry, ctx );
 }
 
 #define KK_REGEX_OPTIONS  (PCRE2_ALT_BSUX | PCRE2_EXTRA_ALT_BSUX | PCRE2_MATCH_UNSET_BACKREF /* javascript compat */ \
                           | PCRE2_NEVER_BACKSLASH_C | PCRE2_NEVER_UCP | PCRE2_UTF /* utf-8 safety */ \
                           )
 
+/* -----------------------------------------------------------------------
+  Compiled pattern cache
+  Cache recently compiled patterns per thread (keyed by the pattern
+  source and options) so code that constructs a regex from the same
+  literal in a loop does not recompile (and re-jit) every iteration.
+  (as with the match data cache, worker threads leak at most the cached
+  entries on exit; the main thread frees them in kk_regex_custom_done)
+------------------------------------------------------------------------*/
+
+#define KK_REGEX_CACHE_SIZE  (16)
+
+typedef struct kk_regex_cached_s {
+  uint8_t*          pat;        // owned copy of the pattern source
+  kk_ssize_t        len;
+  uint32_t          options;
+  uint64_t          stamp;      // for lru eviction
+  kk_regex_entry_t* entry;
+} kk_regex_cached_t;
+
+static kk_decl_thread kk_regex_cached_t regex_cache[KK_REGEX_CACHE_SIZE];
+static kk_decl_thread uint64_t          regex_cache_clock;
+
+static kk_regex_entry_t* kk_regex_cache_lookup( const uint8_t* cpat, kk_ssize_t len, uint32_t options ) {
+  for( int i = 0; i < KK_REGEX_CACHE_SIZE; i++ ) {
+    kk_regex_cached_t* c = &regex_cache[i];
+    if (c->entry != NULL && c->options == options && c->len == len && memcmp(c->pat, cpat, len) == 0) {
+      c->stamp = ++regex_cache_clock;
+      kk_atomic_inc_relaxed(&c->entry->refcount);
+      return c->entry;
+    }
+  }
+  return NULL;
+}
+
+static void kk_regex_cache_insert( const uint8_t* cpat, kk_ssize_t len, uint32_t options, kk_regex_entry_t* entry, kk_context_t* ctx ) {
+  // find a free slot, or evict the least recently used one
+  kk_regex_cached_t* c = &regex_cache[0];
+  for( int i = 0; i < KK_REGEX_CACHE_SIZE; i++ ) {
+    if (regex_cache[i].entry == NULL) { c = &regex_cache[i]; break; }
+    if (regex_cache[i].stamp < c->stamp) { c = &regex_cache[i]; }
+  }
+  if (c->entry != NULL) {
+    kk_regex_entry_release(c->entry, ctx);
+    kk_free(c->pat, ctx);
+  }
+  c->pat = (uint8_t*)kk_malloc(len, ctx);
+  memcpy(c->pat, cpat, len);
+  c->len = len;
+  c->options = options;
+  c->stamp = ++regex_cache_clock;
+  c->entry = entry;
+  kk_atomic_inc_relaxed(&entry->refcount);  // the cache holds its own reference
+}
+
+static void kk_regex_cache_done( kk_context_t* ctx ) {
+  for( int i = 0; i < KK_REGEX_CACHE_SIZE; i++ ) {
+    kk_regex_cached_t* c = &regex_cache[i];
+    if (c->entry != NULL) {
+      kk_regex_entry_release(c->entry, ctx);
+      kk_free(c->pat, ctx);
+      c->entry = NULL;
+      c->pat = NULL;
+    }
+  }
+}
+
 static kk_box_t kk_regex_create( kk_string_t pat, bool ignore_case, bool multi_line, kk_context_t* ctx ) {
   kk_ssize_t len;
   const uint8_t* cpat = kk_string_buf_borrow( pat, &len );
-  PCRE2_SIZE errofs = 0;
-  int        errnum = 0;
   uint32_t   options = KK_REGEX_OPTIONS;
   if (ignore_case) options |= PCRE2_CASELESS;
   if (multi_line)  options |= PCRE2_MULTILINE;
-  pcre2_code* re = pcre2_compile( cpat, PCRE2_ZERO_TERMINATED, options, &errnum, &errofs, cmp_ctx);
-  //kk_info_message( "create regex: err:%i, at %p\n", (re==NULL ? 0 : errnum), re );
+  kk_regex_entry_t* entry = kk_regex_cache_lookup( cpat, len, options );
+  if (entry == NULL) {
+    PCRE2_SIZE errofs = 0;
+    int        errnum = 0;
+    pcre2_code* re = pcre2_compile( cpat, PCRE2_ZERO_TERMINATED, options, &errnum, &errofs, cmp_ctx);
+    //kk_info_message( "create regex: err:%i, at %p\n", (re==NULL ? 0 : errnum), re );
+  #if defined(PCRE2_JIT_COMPLETE)
+    if (re != NULL) {
+      // jit compile when supported; if it fails, pcre2_match transparently
+      // falls back to the interpreter for this pattern
+      pcre2_jit_compile( re, PCRE2_JIT_COMPLETE );
+    }
+  #endif
+    entry = kk_regex_entry_alloc( re, 1, ctx );
+    if (re != NULL) {  // don't cache failed compiles
+      kk_regex_cache_insert( cpat, len, options, entry, ctx );
+    }
+  }
   kk_string_drop(pat,ctx);
-  return kk_cptr_raw_box( &kk_regex_free, re, ctx );
+  return kk_cptr_raw_box( &kk_regex_free, entry, ctx );
 }
 
 
 /* -----------------------------------------------------------------------
-  Match
+  Match data reuse
+  Cache the most recently used match data per thread so the hot match
+  path allocates nothing. (worker threads that used regexes leak at most
+  one cached match data on exit; the main thread frees it in
+  kk_regex_custom_done)
 ------------------------------------------------------------------------*/
 
-/*
-static void kk_match_data_free( void* pmd, kk_block_t* b ) {
-  kk_info_message( "free match_data\n" );
-  pcre2_match_data* md = (pcre2_match_data*)pmd;
-  if (md != NULL) pcre2_match_data_free(md);
+static kk_decl_thread pcre2_match_data* cached_match_data;        // = NULL
+static kk_decl_thread uint32_t          cached_match_data_count;  // ovector pairs available
+
+static uint32_t kk_regex_ovec_count( pcre2_code* re ) {
+  uint32_t captures = 0;
+  if (pcre2_pattern_info( re, PCRE2_INFO_CAPTURECOUNT, &captures ) != 0) return 0;
+  return (captures + 1);  // plus the whole match
+}
+
+static pcre2_match_data* kk_match_data_acquire( pcre2_code* re ) {
+  const uint32_t count = kk_regex_ovec_count(re);
+  if (count > 0 && cached_match_data != NULL && cached_match_data_count >= count) {
+    pcre2_match_data* md = cached_match_data;
+    cached_match_data = NULL;
+    return md;
+  }
+  return pcre2_match_data_create_from_pattern( re, gen_ctx );
 }
-*/
+
+static void kk_match_data_release( pcre2_match_data* md ) {
+  if (md == NULL) return;
+  const uint32_t count = pcre2_get_ovector_count(md);
+  if (cached_match_data == NULL || count > cached_match_data_count) {
+    if (cached_match_data != NULL) { pcre2_match_data_free(cached_match_data); }
+    cached_match_data = md;
+    cached_match_data_count = count;
+  }
+  else {
+    pcre2_match_data_free(md);
+  }
+}
+
+static void kk_match_data_cache_done(void) {
+  if (cached_match_data != NULL) {
+    pcre2_match_data_free(cached_match_data);
+    cached_match_data = NULL;
+    cached_match_data_count = 0;
+  }
+}
+
+
+/* -----------------------------------------------------------------------
+  Match
+------------------------------------------------------------------------*/
 
 static kk_std_core__list kk_regex_exec_ex( pcre2_code* re, pcre2_match_data* match_data, 
                                            kk_string_t str_borrow, const uint8_t* cstr, kk_ssize_t len, bool allow_empty, 
@@ -111,7 +259,7 @@ static kk_std_core__list kk_regex_exec_ex( pcre2_code* re, pcre2_match_data* mat
   if (res != NULL) *res = rc;    
   if (rc > 0) {    
     // extract captures
-    uint32_t    gcount = pcre2_get_ovector_count(match_data);
+    uint32_t    gcount = kk_regex_ovec_count(re);   // not the ovector count: a reused match data may be larger than needed
     PCRE2_SIZE* groups = pcre2_get_ovector_pointer(match_data);
     for( uint32_t i = gcount; i > 0; ) {
       i--;
@@ -135,20 +283,21 @@ static kk_std_core__list kk_regex_exec( kk_box_t bre, kk_string_t str, kk_ssize_
   // unpack
   pcre2_match_data* match_data = NULL;
   kk_std_core__list res = kk_std_core__new_Nil(ctx);
-  pcre2_code* re = (pcre2_code*)kk_cptr_raw_unbox(bre);
-  if (re == NULL) goto done;    
-  match_data = pcre2_match_data_create_from_pattern(re, gen_ctx);
-  if (match_data==NULL) goto done;  
+  kk_regex_entry_t* entry = (kk_regex_entry_t*)kk_cptr_raw_unbox(bre);
+  pcre2_code* re = (entry != NULL ? entry->re : NULL);
+  if (re == NULL) goto done;
+  match_data = kk_match_data_acquire(re);
+  if (match_data==NULL) goto done;
   kk_ssize_t len;
-  const uint8_t* cstr = kk_string_buf_borrow(str, &len );  
+  const uint8_t* cstr = kk_string_buf_borrow(str, &len );
 
   // and match
   res = kk_regex_exec_ex( re, match_data, str, cstr, len, true, start, NULL, NULL, NULL, ctx );
 
 done:  
   if (match_data != NULL) {
-    //kk_info_message( "free match data: %p\n", match_data );
-    pcre2_match_data_free(match_data);
+    //kk_info_message( "release match data: %p\n", match_data );
+    kk_match_data_release(match_data);
   }
   kk_string_drop(str,ctx);
   kk_box_drop(bre,ctx);
@@ -160,12 +309,13 @@ static kk_std_core__list kk_regex_exec_all( kk_box_t bre, kk_string_t str, kk_ss
   if (atmost < 0) atmost = KK_SSIZE_MAX;
   pcre2_match_data* match_data = NULL;
   kk_std_core__list res = kk_std_core__new_Nil(ctx);
-  pcre2_code* re = (pcre2_code*)kk_cptr_raw_unbox(bre);
-  if (re == NULL) goto done;    
-  match_data = pcre2_match_data_create_from_pattern(re, gen_ctx);
-  if (match_data==NULL) goto done;  
+  kk_regex_entry_t* entry = (kk_regex_entry_t*)kk_cptr_raw_unbox(bre);
+  pcre2_code* re = (entry != NULL ? entry->re : NULL);
+  if (re == NULL) goto done;
+  match_data = kk_match_data_acquire(re);
+  if (match_data==NULL) goto done;
   kk_ssize_t len;
-  const uint8_t* cstr = kk_string_buf_borrow(str, &len );  
+  const uint8_t* cstr = kk_string_buf_borrow(str, &len );
 
   // and match
   kk_std_core__list* tail = NULL;
@@ -209,8 +359,8 @@ static kk_std_core__list kk_regex_exec_all( kk_box_t bre, kk_string_t str, kk_ss
 
 done:  
   if (match_data != NULL) {
-    //kk_info_message( "free match data: %p\n", match_data );
-    pcre2_match_data_free(match_data);
+    //kk_info_message( "release match data: %p\n", match_data );
+    kk_match_data_release(match_data);
   }
   kk_string_drop(str,ctx);
   kk_box_drop(bre,ctx);
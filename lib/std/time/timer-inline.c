@@ -14,6 +14,22 @@ static kk_std_core_types__tuple2_ kk_timer_ticks_tuple(kk_context_t* ctx) {
   return kk_std_core_types__new_dash__lp__comma__rp_( kk_double_box(secs,ctx), kk_double_box(frac,ctx), ctx );
 }
 
+static kk_std_core_types__tuple2_ kk_timer_ticks_coarse_tuple(kk_context_t* ctx) {
+  int64_t asecs;
+  int64_t isecs = kk_timer_ticks_coarse(&asecs,ctx);
+  double frac = (double)asecs * 1e-18;
+  double secs = (double)isecs;
+  return kk_std_core_types__new_dash__lp__comma__rp_( kk_double_box(secs,ctx), kk_double_box(frac,ctx), ctx );
+}
+
+static kk_std_core_types__tuple2_ kk_timer_ticks_fast_tuple(kk_context_t* ctx) {
+  int64_t asecs;
+  int64_t isecs = kk_timer_ticks_fast(&asecs,ctx);
+  double frac = (double)asecs * 1e-18;
+  double secs = (double)isecs;
+  return kk_std_core_types__new_dash__lp__comma__rp_( kk_double_box(secs,ctx), kk_double_box(frac,ctx), ctx );
+}
+
 static double kk_timer_dresolution(kk_context_t* ctx) {
   int64_t asecs = kk_timer_resolution(ctx);
   return (double)asecs * 1e-18;
@@ -367,18 +367,29 @@ genTopDefDecl genSig inlineC def@(Def name tp defBody vis sort inl rng comm)
                         Lit lit@(LitFloat f)
                           -> do let flt  = ppLit lit
                                 emitToH (text "#define" <+> ppName name <+> parens (text "(double)" <.> parens flt))
-                        _ -> do doc <- genStat (ResultAssign (TName name tp) Nothing) (defBody)
-                                emitToInit (block doc)  -- must be scoped to avoid name clashes
-                                case genDupDropCall False {-drop-} tp (ppName name) of
-                                  []   -> return ()
-                                  docs -> emitToDone (hcat docs <.> semi)
-                                let hdecl = ppType tp <+> ppName name <.> semi
-                                    cdecl = ppType tp <+> ppName name <.> unitSemi tp
-                                -- if (isPublic vis) -- then do
-                                -- always public since inlined definitions can refer to it (sin16 in std/num/ddouble)
-                                emitToH (linebreak <.> text "extern" <+> hdecl)
-                                emitToC (linebreak <.> cdecl)
-                                -- else do emitToC (linebreak <.> text "static" <+> decl)
+                        -- special case constant constructors: emit static blocks in the data
+                        -- segment instead of allocating at module init (see `kk_static_con_base`
+                        -- in kklib.h); fall back to regular initialization when the constructor
+                        -- (or one of its arguments) has no static representation
+                        con@(Con _ _)
+                          -> do emitted <- genTopLevelStaticCon name tp con
+                                when (not emitted) genInitDef
+                        app@(App _ _) | isConApp app
+                          -> do emitted <- genTopLevelStaticCon name tp app
+                                when (not emitted) genInitDef
+                        _ -> genInitDef
+        genInitDef = do doc <- genStat (ResultAssign (TName name tp) Nothing) (defBody)
+                        emitToInit (block doc)  -- must be scoped to avoid name clashes
+                        case genDupDropCall False {-drop-} tp (ppName name) of
+                          []   -> return ()
+                          docs -> emitToDone (hcat docs <.> semi)
+                        let hdecl = ppType tp <+> ppName name <.> semi
+                            cdecl = ppType tp <+> ppName name <.> unitSemi tp
+                        -- if (isPublic vis) -- then do
+                        -- always public since inlined definitions can refer to it (sin16 in std/num/ddouble)
+                        emitToH (linebreak <.> text "extern" <+> hdecl)
+                        emitToC (linebreak <.> cdecl)
+                        -- else do emitToC (linebreak <.> text "static" <+> decl)
     in withDef name inlineC (tryFun defBody)
   where
     emit = if inlineC then emitToH else emitToC
@@ -411,6 +422,128 @@ unitSemi :: Type -> Doc
 unitSemi tp
   = if (isTypeUnit tp) then text " = kk_Unit;" else semi
 
+---------------------------------------------------------------------------------
+-- Static constant constructors
+---------------------------------------------------------------------------------
+
+-- Is the expression a (possibly type applied) constructor application?
+isConApp :: Expr -> Bool
+isConApp expr
+  = case expr of
+      App f _     -> isConApp f
+      TypeApp e _ -> isConApp e
+      Con _ _     -> True
+      _           -> False
+
+-- Emit a top level constant constructor as static blocks in the data segment
+-- instead of allocating (and refcounting) it at module init: the blocks start
+-- with a stuck refcount so dup and drop never write to them and they are never
+-- freed (see `kk_static_con_base` in kklib.h). Returns `False` when the
+-- constructor (or one of its arguments) has no static representation and the
+-- definition must be initialized at module init after all.
+genTopLevelStaticCon :: Name -> Type -> Expr -> Asm Bool
+genTopLevelStaticCon name tp expr
+  = do mbStatic <- genStaticValue (text "_static_" <.> ppName name) 0 tp expr
+       case mbStatic of
+         Nothing -> return False
+         Just (defs,initDoc,_)
+           -> do emitToC (linebreak <.> vcat (defs ++ [ppType tp <+> ppName name <+> text "=" <+> initDoc <.> semi]))
+                 -- always public since inlined definitions can refer to it
+                 emitToH (linebreak <.> text "extern" <+> ppType tp <+> ppName name <.> semi)
+                 return True
+
+-- Generate a static initializer for a constant expression at field type `ftp`,
+-- together with the static block definitions it depends on (emitted in order
+-- before the definition that references them). Nested blocks are named after
+-- the top level definition with an increasing suffix. Conservative by design:
+-- anything without an obviously constant representation (boxed fields, value
+-- types, open datatypes, big integers, strings) gives `Nothing`.
+genStaticValue :: Doc -> Int -> Type -> Expr -> Asm (Maybe ([Doc],Doc,Int))
+genStaticValue base idx ftp expr
+  = case expr of
+      TypeApp e _ -> genStaticValue base idx ftp e
+      TypeLam _ e -> genStaticValue base idx ftp e
+      Lit (LitInt i) | isSmallInt i && isTypeInt ftp
+        -> done (text "kk_integer_static" <.> parens (pretty i))
+      Lit lit@(LitChar _) | isTypeChar ftp
+        -> done (ppLit lit)
+      Lit lit@(LitFloat _) | cType ftp == CPrim "double"
+        -> done (ppLit lit)
+      Con cname _ | getName cname == nameTrue
+        -> done (text "true")
+      Con cname _ | getName cname == nameFalse
+        -> done (text "false")
+      Con cname crepr
+        -> case crepr of
+             ConEnum{}
+               -> done (ppName (getName cname))
+             ConSingleton{} | not (conReprIsValue crepr) && conDataRepr crepr /= DataOpen
+               -> done (text "kk_datatype_static_singleton" <.> parens (conTagDoc crepr))
+             _ -> return Nothing
+      App con args | Just (cname,crepr) <- staticConOf con
+        -> do newtypes <- getNewtypes
+              platform <- getPlatform
+              case newtypesLookupAny (conTypeName crepr) newtypes of
+                Just dataInfo
+                  -> case filter (\ci -> conInfoName ci == getName cname) (dataInfoConstrs dataInfo) of
+                       [conInfo] | length args == length (conInfoParams conInfo)
+                         -> do let (fields,_,scanCount) = orderConFieldsEx platform newtypes False (conInfoParams conInfo)
+                                   argOf fld = lookup fld (zip (map fst (conInfoParams conInfo)) args)
+                               case mapM argOf (map fst fields) of
+                                 Just fargs | scanCount < 255  -- a large scan count needs a large block
+                                   -> do let self = if (idx == 0) then base else base <.> text "_" <.> pretty idx
+                                         mbFields <- genStaticFields base (idx+1) (zip (map snd fields) fargs)
+                                         case mbFields of
+                                           Nothing -> return Nothing
+                                           Just (defs,inits,idx')
+                                             -> do let selfDef = text "static struct" <+> ppName (conInfoName conInfo) <+> self <+> text "= {"
+                                                                 <+> hcat (punctuate (text ", ")
+                                                                       ((text "kk_static_con_base" <.> tupled [pretty scanCount, conTagDoc crepr]) : inits))
+                                                                 <+> text "};"
+                                                       initDoc = if (dataReprMayHaveSingletons (conDataRepr crepr))
+                                                                   then text "kk_datatype_static" <.> parens self
+                                                                   else text "&" <.> self <.> text "._base"
+                                                   return (Just (defs ++ [selfDef], initDoc, idx'))
+                                 _ -> return Nothing
+                       _ -> return Nothing
+                _ -> return Nothing
+      _ -> return Nothing
+  where
+    done doc = return (Just ([],doc,idx))
+
+    staticConOf e
+      = case e of
+          TypeApp e' _ -> staticConOf e'
+          Con cname crepr | isStaticConRepr crepr -> Just (cname,crepr)
+          _ -> Nothing
+
+    isStaticConRepr crepr
+      = case crepr of
+          ConNormal{} -> heapCon crepr
+          ConAsCons{} -> heapCon crepr
+          ConSingle{} -> heapCon crepr
+          _           -> False
+    heapCon crepr
+      = not (conReprIsValue crepr) && conDataRepr crepr /= DataOpen
+
+    conTagDoc crepr
+      = case crepr of
+          ConSingleton{} | conDataRepr crepr == DataAsMaybe -> text "KK_TAG_NOTHING"
+          _ -> text "(kk_tag_t)" <.> parens (pretty (conTag crepr))
+
+genStaticFields :: Doc -> Int -> [(Type,Expr)] -> Asm (Maybe ([Doc],[Doc],Int))
+genStaticFields base idx [] = return (Just ([],[],idx))
+genStaticFields base idx ((ftp,arg):rest)
+  = do mb <- genStaticValue base idx ftp arg
+       case mb of
+         Nothing -> return Nothing
+         Just (defs,doc,idx')
+           -> do mbRest <- genStaticFields base idx' rest
+                 case mbRest of
+                   Nothing -> return Nothing
+                   Just (defsRest,docs,idx'')
+                     -> return (Just (defs ++ defsRest, doc:docs, idx''))
+
 ---------------------------------------------------------------------------------
 -- Generate value constructors for each defined type
 ---------------------------------------------------------------------------------
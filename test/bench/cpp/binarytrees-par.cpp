@@ -0,0 +1,92 @@
+// The Computer Language Benchmarks Game
+// https://salsa.debian.org/benchmarksgame-team/benchmarksgame/
+//
+// Parallel variant using std::async: the first argument is the number
+// of workers so the benchmark driver can report per-core scaling.
+#include <iostream>
+#include <future>
+#include <vector>
+#include <algorithm>
+
+struct node {
+  node* left;
+  node* right;
+  node(node* l = nullptr, node* r = nullptr) : left(l), right(r) {}
+  ~node() {
+    delete left;
+    delete right;
+  }
+};
+
+static node* make(int depth) {
+  if (depth > 0) {
+    return new node(make(depth - 1), make(depth - 1));
+  }
+  else {
+    return new node();
+  }
+}
+
+static int check(const node* t) {
+  if (t == nullptr) return 0;
+  return check(t->left) + check(t->right) + 1;
+}
+
+// generate `count` trees of `depth` and return the total checksum
+static long sum_count(int count, int depth) {
+  long csum = 0;
+  for (int i = 0; i <= count; i++) {
+    node* t = make(depth);
+    csum += check(t);
+    delete t;
+  }
+  return csum;
+}
+
+// split `count` trees over `workers` asynchronous tasks
+static long psum_count(int count, int depth, int workers) {
+  const int partc = count / workers;
+  const int rest = count % workers;
+  std::vector<std::future<long>> parts;
+  for (int i = 0; i < workers; i++) {
+    parts.push_back(std::async(std::launch::async, sum_count, partc, depth));
+  }
+  long csum = sum_count(rest, depth);
+  for (auto& part : parts) {
+    csum += part.get();
+  }
+  return csum;
+}
+
+static void show(const char* msg, int depth, long check) {
+  std::cout << msg << " of depth " << depth << "\t check: " << check << "\n";
+}
+
+// main: <workers> [<depth>]
+int main(int argc, char** argv) {
+  int workers = (argc > 1 ? std::max(1, atoi(argv[1])) : 1);
+  int n = (argc > 2 ? atoi(argv[2]) : 21);
+  const int min_depth = 4;
+  const int max_depth = std::max(min_depth + 2, n);
+
+  // allocate and free the stretch tree
+  const int stretch_depth = max_depth + 1;
+  node* stretch = make(stretch_depth);
+  show("stretch tree", stretch_depth, check(stretch));
+  delete stretch;
+
+  // allocate long lived tree
+  node* long_lived = make(max_depth);
+
+  // allocate and free many trees in parallel
+  for (int d = min_depth; d <= max_depth; d += 2) {
+    const int count = 1 << (max_depth + min_depth - d);
+    long csum = psum_count(count, d, workers);
+    std::cout << count << "\t trees of depth " << d << "\t check: " << csum << "\n";
+  }
+
+  // and check if the long lived tree is still good
+  show("long lived tree", max_depth, check(long_lived));
+  delete long_lived;
+  return 0;
+}
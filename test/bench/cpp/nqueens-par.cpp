@@ -0,0 +1,109 @@
+// Parallel NQueens solution in C++ using std::async: one task per
+// placement of the first queen. The first argument is the number of
+// workers so the benchmark driver can report per-core scaling.
+// Note: does not free memory as that is difficult to do
+// since many subsolutions are shared
+#include <iostream>
+#include <future>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+template <typename T>
+class list {
+public:
+  T head;
+  list<T>* tail;
+  list(T hd, list<T>* tl) {
+    head = hd;
+    tail = tl;
+  }
+};
+
+template <typename T>
+list<T>* Cons( T hd, list<T>* tl ) {
+  return new list<T>(hd,tl);
+}
+
+template <typename T>
+int len(list<T>* xs) {
+  int n = 0;
+  while(xs != NULL) {
+    n++;
+    xs = xs->tail;
+  }
+  return n;
+}
+
+bool safe( int queen, list<int>* xs ) {
+  list<int>* cur = xs;
+  int diag = 1;
+  while(cur != NULL) {
+    int q = cur->head;
+    if (queen == q || queen == (q+diag) || queen == (q-diag)) {
+      return false;
+    }
+    diag++;
+    cur = cur->tail;
+  }
+  return true;
+}
+
+list<list<int>*>* append_safe( int k, list<int>* soln, list<list<int>*>* solns ) {
+  list<list<int>*>* acc = solns;
+  int n = k;
+  while(n > 0) {
+    if (safe(n,soln)) {
+      acc = Cons(Cons(n,soln),acc);
+    }
+    n--;
+  }
+  return acc;
+}
+
+list<list<int>*>* extend( int n, list<list<int>*>* solns ) {
+  list<list<int>*>* acc = NULL;
+  list<list<int>*>* cur = solns;
+  while(cur != NULL) {
+    list<int>* soln = cur->head;
+    acc = append_safe(n,soln,acc);
+    cur = cur->tail;
+  }
+  return acc;
+}
+
+// extend a single first-queen placement with the remaining n-1 rows
+int count_from( int n, list<int>* seed ) {
+  list<list<int>*>* acc = Cons(seed,(list<list<int>*>*)NULL);
+  for (int k = 1; k < n; k++) {
+    acc = extend(n,acc);
+  }
+  return len(acc);
+}
+
+// `workers` tasks pull first-queen placements from a shared counter
+int pqueens( int n, int workers ) {
+  std::atomic<int> next(1);
+  std::atomic<int> total(0);
+  auto worker = [&]() {
+    for (int q = next++; q <= n; q = next++) {
+      total += count_from(n, Cons(q,(list<int>*)NULL));
+    }
+  };
+  std::vector<std::future<void>> parts;
+  for (int i = 0; i < std::min(workers,n); i++) {
+    parts.push_back(std::async(std::launch::async, worker));
+  }
+  for (auto& part : parts) {
+    part.get();
+  }
+  return total;
+}
+
+// main: <workers> [<n>]
+int main(int argc, char ** argv) {
+    int workers = (argc > 1 ? std::max(1, atoi(argv[1])) : 1);
+    int n = (argc > 2 ? atoi(argv[2]) : 13);
+    std::cout << pqueens(n,workers) << "\n";
+    return 0;
+}